@@ -0,0 +1,505 @@
+/**
+ * @file app_bench.c
+ * @brief On-device benchmark commands ("bench ..." on the console)
+ *
+ * Output is one "bench name=... key=value ..." line per measurement,
+ * preceded by the build profile line, so logs from several boards can be
+ * collected and compared with a script.
+ */
+
+#include "app_bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_check.h"
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+#include "app_console.h"
+#include "app_lvgl.h"
+#include "app_touch_read.h"
+
+#if CONFIG_APP_HID_MODE_TRACKPAD
+    #include "trackpad_gesture.h"
+    #include "app_trackpad.h"
+#endif
+#if CONFIG_APP_LVGL_LGFX_DRAW_UNIT
+    #include "app_lvgl_lgfx_draw.h"
+#endif
+#include "app_display_bench.h"
+
+static const char *TAG = "app_bench";
+
+#define BENCH_CPU_MHZ        CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+#define BENCH_STROKE_SAMPLES 200
+
+static app_bench_cfg_t s_cfg;
+
+// ========================== Helpers ==========================
+
+typedef struct {
+    uint32_t n;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+} bench_stat_t;
+
+static inline uint32_t cyc_now(void)
+{
+    return esp_cpu_get_cycle_count();
+}
+
+static void stat_reset(bench_stat_t *s)
+{
+    *s = (bench_stat_t){ .min = UINT32_MAX };
+}
+
+static void stat_add(bench_stat_t *s, uint32_t cycles)
+{
+    s->n++;
+    s->sum += cycles;
+    if (cycles < s->min) s->min = cycles;
+    if (cycles > s->max) s->max = cycles;
+}
+
+static uint32_t stat_avg(const bench_stat_t *s)
+{
+    return s->n ? (uint32_t)(s->sum / s->n) : 0;
+}
+
+// Common line for cycle-count based measurements; extra is appended as-is
+static void stat_print(const char *name, const bench_stat_t *s, const char *extra)
+{
+    if (s->n == 0) {
+        app_console_printf("bench name=%s n=0\r\n", name);
+        return;
+    }
+    app_console_printf("bench name=%s n=%u cyc_avg=%u cyc_min=%u cyc_max=%u us_avg=%.2f us_max=%.2f%s\r\n",
+                       name, (unsigned)s->n, (unsigned)stat_avg(s), (unsigned)s->min, (unsigned)s->max,
+                       (double)stat_avg(s) / BENCH_CPU_MHZ, (double)s->max / BENCH_CPU_MHZ,
+                       extra ? extra : "");
+}
+
+static void skip(const char *name, const char *why)
+{
+    app_console_printf("bench name=%s skipped=%s\r\n", name, why);
+}
+
+// ========================== Gesture engine ==========================
+
+#if CONFIG_APP_HID_MODE_TRACKPAD
+static trackpad_input_t s_stroke[BENCH_STROKE_SAMPLES];
+
+// Synthetic 100 Hz stroke: press, Lissajous sweep with varying speed, release
+static void build_stroke(void)
+{
+    const float cx = CONFIG_APP_LCD_HRES / 2.0f;
+    const float cy = CONFIG_APP_LCD_VRES / 2.0f;
+    const float rx = CONFIG_APP_LCD_HRES / 3.0f;
+    const float ry = CONFIG_APP_LCD_VRES / 3.0f;
+
+    for (int i = 0; i < BENCH_STROKE_SAMPLES; i++) {
+        float t = (float)i / BENCH_STROKE_SAMPLES;
+        s_stroke[i] = (trackpad_input_t){
+            .type = (i == 0) ? TRACKPAD_EVENT_PRESSED
+                  : (i == BENCH_STROKE_SAMPLES - 1) ? TRACKPAD_EVENT_RELEASED
+                  : TRACKPAD_EVENT_PRESSING,
+            .x = (int32_t)(cx + rx * sinf(2.0f * (float)M_PI * t * t * 3.0f)),
+            .y = (int32_t)(cy + ry * sinf(2.0f * (float)M_PI * t * 2.0f)),
+            .timestamp_ms = 1000 + (uint32_t)i * 10,
+        };
+    }
+}
+
+static void bench_gesture(int iters)
+{
+    build_stroke();
+
+    bench_stat_t st;
+    stat_reset(&st);
+    uint32_t actions = 0;
+    for (int i = 0; i < iters; i++) {
+        uint32_t t0 = cyc_now();
+        actions = trackpad_replay(CONFIG_APP_LCD_HRES, CONFIG_APP_LCD_VRES, s_stroke, BENCH_STROKE_SAMPLES);
+        stat_add(&st, (cyc_now() - t0) / BENCH_STROKE_SAMPLES);
+    }
+
+    char extra[48];
+    snprintf(extra, sizeof(extra), " per=sample actions=%u", (unsigned)actions);
+    stat_print("gesture", &st, extra);
+}
+#else
+static void bench_gesture(int iters)
+{
+    (void)iters;
+    skip("gesture", "no_trackpad");
+}
+#endif
+
+// ========================== Trackpad poll loop ==========================
+
+#if CONFIG_APP_HID_MODE_TRACKPAD
+// Observes the live poll task; use the trackpad while it runs
+static void bench_loop(int seconds)
+{
+    app_trackpad_reset_loop_stats();
+    vTaskDelay(pdMS_TO_TICKS(seconds * 1000));
+
+    app_trackpad_loop_stats_t st;
+    app_trackpad_get_loop_stats(&st);
+    app_console_printf("bench name=poll_loop n=%u work_us_avg=%u work_us_max=%u period_us_max=%u "
+                       "overruns=%u missed=%u shed=%u coalesced=%u\r\n",
+                       (unsigned)st.iterations, (unsigned)st.work_avg_us,
+                       (unsigned)st.work_max_us, (unsigned)st.period_max_us,
+                       (unsigned)st.overruns, (unsigned)st.missed, (unsigned)st.shed, (unsigned)st.coalesced);
+}
+#else
+static void bench_loop(int seconds)
+{
+    (void)seconds;
+    skip("poll_loop", "no_trackpad");
+}
+#endif
+
+// ========================== Touch / HID ==========================
+
+static void bench_touch(int iters)
+{
+    if (!s_cfg.touch) {
+        skip("touch", "no_touch");
+        return;
+    }
+
+    bench_stat_t st;
+    stat_reset(&st);
+    int errors = 0;
+    for (int i = 0; i < iters; i++) {
+        uint32_t t0 = cyc_now();
+        esp_err_t err = app_touch_read(s_cfg.touch);
+        stat_add(&st, cyc_now() - t0);
+        if (err != ESP_OK) errors++;
+        vTaskDelay(pdMS_TO_TICKS(2));
+    }
+
+    char extra[24];
+    snprintf(extra, sizeof(extra), " errors=%d", errors);
+    stat_print("touch_read", &st, extra);
+}
+
+static esp_err_t hid_send_idle_report(void)
+{
+#if CONFIG_APP_HID_MODE_TRACKPAD
+    return app_hid_trackpad_send_move(s_cfg.hid, 0, 0);
+#elif CONFIG_APP_HID_MODE_MACROPAD
+    return app_hid_macropad_release_all(s_cfg.hid);
+#elif CONFIG_APP_HID_MODE_GAMEPAD
+    const gamepad_state_t neutral = {0};
+    return app_hid_gamepad_send_state(s_cfg.hid, &neutral);
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+static void bench_hid(int iters)
+{
+    if (!s_cfg.hid) {
+        skip("hid", "no_hid");
+        return;
+    }
+
+    // Idle reports (no motion, no buttons) so the host sees nothing.
+    // Includes any wait for the endpoint, i.e. what the poll task pays.
+    bench_stat_t st;
+    stat_reset(&st);
+    int busy = 0;
+    for (int i = 0; i < iters; i++) {
+        uint32_t t0 = cyc_now();
+        esp_err_t err = hid_send_idle_report();
+        stat_add(&st, cyc_now() - t0);
+        if (err != ESP_OK) busy++;
+    }
+
+    char extra[24];
+    snprintf(extra, sizeof(extra), " busy=%d", busy);
+    stat_print("hid_send", &st, extra);
+}
+
+// ========================== LVGL render / flush ==========================
+
+static void bench_render(int iters, bool show_render, bool show_flush)
+{
+    if (!s_cfg.disp) {
+        skip("render", "no_lvgl");
+        return;
+    }
+
+    bench_stat_t frame;
+    stat_reset(&frame);
+    app_lvgl_stats_t lv;
+
+    // Force full-screen redraws of whatever UI is active. Runs in this
+    // task (lock held) so cycle counts stay on one core.
+    app_lvgl_lock(0);
+    app_lvgl_reset_stats();
+    for (int i = 0; i < iters; i++) {
+        lv_obj_invalidate(lv_display_get_screen_active(s_cfg.disp));
+        uint32_t t0 = cyc_now();
+        lv_refr_now(s_cfg.disp);
+        stat_add(&frame, cyc_now() - t0);
+    }
+    app_lvgl_get_stats(&lv);
+    app_lvgl_unlock();
+
+    if (show_render) {
+        stat_print("refresh", &frame, NULL);
+        double frame_us = (double)frame.sum / BENCH_CPU_MHZ;
+        double render_us = frame_us > lv.flush_us ? frame_us - (double)lv.flush_us : 0.0;
+        app_console_printf("bench name=render n=%u us_avg=%.1f fps_max=%.1f\r\n",
+                           (unsigned)frame.n, render_us / frame.n,
+                           frame_us > 0 ? 1e6 * frame.n / frame_us : 0.0);
+    }
+    if (show_flush) {
+        double mbps = lv.flush_us ? (double)lv.flush_px * 2 / (double)lv.flush_us : 0.0;
+        app_console_printf("bench name=flush n=%u areas=%u us_avg=%.1f area_us_max=%u px=%llu MBps=%.2f\r\n",
+                           (unsigned)lv.frame_count, (unsigned)lv.flush_count,
+                           lv.frame_count ? (double)lv.flush_us / lv.frame_count : 0.0,
+                           (unsigned)lv.flush_max_us, (unsigned long long)lv.flush_px, mbps);
+    }
+}
+
+// ========================== LGFX draw unit vs software ==========================
+
+#if CONFIG_APP_LVGL_LGFX_DRAW_UNIT
+
+#define DRAW_IMG_W  96
+#define DRAW_IMG_H  64
+
+// Screen of what the unit handles (square opaque boxes with borders, an
+// RGB565 image) plus a label, which stays with the software renderer
+static lv_obj_t *draw_scene_create(lv_image_dsc_t *img)
+{
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x202020), 0);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+
+    int32_t w = CONFIG_APP_LCD_HRES / 4;
+    int32_t h = CONFIG_APP_LCD_VRES / 4;
+    for (int i = 0; i < 6; i++) {
+        lv_obj_t *box = lv_obj_create(scr);
+        lv_obj_remove_style_all(box);
+        lv_obj_set_size(box, w, h);
+        lv_obj_set_pos(box, (i % 3) * (w + w / 4) + 8, (i / 3) * (h + h / 4) + 8);
+        lv_obj_set_style_bg_color(box, lv_palette_main((lv_palette_t)(LV_PALETTE_RED + i * 2)), 0);
+        lv_obj_set_style_bg_opa(box, LV_OPA_COVER, 0);
+        lv_obj_set_style_border_color(box, lv_color_white(), 0);
+        lv_obj_set_style_border_width(box, 2, 0);
+    }
+
+    lv_obj_t *image = lv_image_create(scr);
+    lv_image_set_src(image, img);
+    lv_obj_align(image, LV_ALIGN_BOTTOM_RIGHT, -8, -8);
+
+    lv_obj_t *label = lv_label_create(scr);
+    lv_label_set_text(label, "bench draw");
+    lv_obj_set_style_text_color(label, lv_color_white(), 0);
+    lv_obj_align(label, LV_ALIGN_BOTTOM_LEFT, 8, -8);
+    return scr;
+}
+
+static void draw_run(const char *name, lv_obj_t *scr, int iters, bool lgfx, bench_stat_t *frame)
+{
+    app_lvgl_stats_t lv;
+    app_lvgl_lgfx_draw_stats_t ds;
+
+    app_lvgl_lgfx_draw_set_enabled(lgfx);
+    app_lvgl_lgfx_draw_reset_stats();
+    app_lvgl_reset_stats();
+    stat_reset(frame);
+    for (int i = 0; i < iters; i++) {
+        lv_obj_invalidate(scr);
+        uint32_t t0 = cyc_now();
+        lv_refr_now(s_cfg.disp);
+        stat_add(frame, cyc_now() - t0);
+    }
+    app_lvgl_get_stats(&lv);
+    app_lvgl_lgfx_draw_get_stats(&ds);
+
+    char extra[128];
+    snprintf(extra, sizeof(extra), " flush_us=%.1f fills=%u borders=%u images=%u solid=%u solid_px=%llu",
+             frame->n ? (double)lv.flush_us / frame->n : 0.0,
+             (unsigned)ds.fills, (unsigned)ds.borders, (unsigned)ds.images,
+             (unsigned)ds.solid_flushes, (unsigned long long)ds.solid_px);
+    stat_print(name, frame, extra);
+}
+
+static void bench_draw(int iters)
+{
+    if (!s_cfg.disp) {
+        skip("draw", "no_lvgl");
+        return;
+    }
+
+    size_t img_size = DRAW_IMG_W * DRAW_IMG_H * 2;
+    uint16_t *px = heap_caps_malloc(img_size, MALLOC_CAP_8BIT);
+    if (!px) {
+        skip("draw", "no_mem");
+        return;
+    }
+    for (int y = 0; y < DRAW_IMG_H; y++) {
+        for (int x = 0; x < DRAW_IMG_W; x++) {
+            px[y * DRAW_IMG_W + x] = (uint16_t)(((x >> 2) << 11) | ((y >> 1) << 5) | ((x ^ y) & 0x1F));
+        }
+    }
+    lv_image_dsc_t img = {
+        .header = {
+            .magic = LV_IMAGE_HEADER_MAGIC,
+            .cf = LV_COLOR_FORMAT_RGB565,
+            .w = DRAW_IMG_W,
+            .h = DRAW_IMG_H,
+            .stride = DRAW_IMG_W * 2,
+        },
+        .data_size = img_size,
+        .data = (const uint8_t *)px,
+    };
+
+    // Same scene, same number of full redraws, software first
+    app_lvgl_lock(0);
+    bool was_enabled = app_lvgl_lgfx_draw_get_enabled();
+    lv_obj_t *prev = lv_screen_active();
+    lv_obj_t *scr = draw_scene_create(&img);
+    lv_screen_load(scr);
+
+    bench_stat_t sw, lgfx;
+    draw_run("draw_sw", scr, iters, false, &sw);
+    draw_run("draw_lgfx", scr, iters, true, &lgfx);
+
+    app_lvgl_lgfx_draw_set_enabled(was_enabled);
+    lv_screen_load(prev);
+    lv_obj_delete(scr);
+    lv_obj_invalidate(prev);
+    lv_image_cache_drop(&img);
+    app_lvgl_unlock();
+    heap_caps_free(px);
+
+    app_console_printf("bench name=draw speedup=%.2f\r\n",
+                       lgfx.sum ? (double)sw.sum / (double)lgfx.sum : 0.0);
+}
+
+#else
+
+static void bench_draw(int iters)
+{
+    (void)iters;
+    skip("draw", "no_lgfx_draw_unit");
+}
+
+#endif // CONFIG_APP_LVGL_LGFX_DRAW_UNIT
+
+// ========================== Memory: swap / fill ==========================
+
+static void fill_rgb565(uint16_t *buf, size_t px, uint16_t color)
+{
+    uint32_t pattern = ((uint32_t)color << 16) | color;
+    uint32_t *w = (uint32_t *)buf;
+    for (size_t i = 0; i < px / 2; i++) {
+        w[i] = pattern;
+    }
+}
+
+// One line-buffer worth of pixels, in each memory type the flush paths use
+static void bench_mem(const char *name, int iters, bool swap)
+{
+    static const struct {
+        const char *tag;
+        uint32_t caps;
+    } mems[] = {
+        {"int", MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL},
+        {"psram", MALLOC_CAP_SPIRAM},
+    };
+    const size_t px = CONFIG_APP_LCD_HRES * CONFIG_APP_LVGL_BUF_LINES;
+
+    for (size_t m = 0; m < sizeof(mems) / sizeof(mems[0]); m++) {
+        uint16_t *buf = heap_caps_aligned_alloc(16, px * 2, mems[m].caps);
+        char full[24];
+        snprintf(full, sizeof(full), "%s_%s", name, mems[m].tag);
+        if (!buf) {
+            skip(full, "no_mem");
+            continue;
+        }
+        fill_rgb565(buf, px, 0xF800);
+
+        bench_stat_t st;
+        stat_reset(&st);
+        for (int i = 0; i < iters; i++) {
+            uint32_t t0 = cyc_now();
+            if (swap) {
+                lv_draw_sw_rgb565_swap(buf, px);
+            } else {
+                fill_rgb565(buf, px, (uint16_t)i);
+            }
+            stat_add(&st, cyc_now() - t0);
+        }
+        heap_caps_free(buf);
+
+        char extra[48];
+        double us = (double)stat_avg(&st) / BENCH_CPU_MHZ;
+        snprintf(extra, sizeof(extra), " bytes=%u MBps=%.1f", (unsigned)(px * 2), us > 0 ? px * 2 / us : 0.0);
+        stat_print(full, &st, extra);
+    }
+}
+
+// ========================== Command ==========================
+
+static int cmd_bench(int argc, char **argv)
+{
+    if (argc < 2) {
+        app_console_printf("usage: bench gesture|loop|touch|hid|render|flush|draw|backend|swap|fill|all [iters]\r\n");
+        return 1;
+    }
+    static const char *const names[] = {"gesture", "loop", "touch", "hid", "render", "flush", "draw", "backend", "swap", "fill", "all"};
+    const char *what = argv[1];
+    bool known = false;
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        known |= strcmp(what, names[i]) == 0;
+    }
+    if (!known) {
+        app_console_printf("err unknown benchmark '%s'\r\n", what);
+        return 1;
+    }
+    int iters = (argc > 2) ? atoi(argv[2]) : 0;
+    bool all = strcmp(what, "all") == 0;
+
+    app_console_printf("bench profile %s\r\n", app_console_profile());
+
+    if (all || strcmp(what, "gesture") == 0) bench_gesture(iters > 0 ? iters : 50);
+    if (all || strcmp(what, "loop") == 0)    bench_loop(iters > 0 ? iters : 5);
+    if (all || strcmp(what, "touch") == 0)   bench_touch(iters > 0 ? iters : 100);
+    if (all || strcmp(what, "hid") == 0)     bench_hid(iters > 0 ? iters : 200);
+    if (all || strcmp(what, "render") == 0)  bench_render(iters > 0 ? iters : 10, true, all);
+    if (!all && strcmp(what, "flush") == 0)  bench_render(iters > 0 ? iters : 10, false, true);
+    if (all || strcmp(what, "draw") == 0)    bench_draw(iters > 0 ? iters : 10);
+    if (!all && strcmp(what, "backend") == 0) app_display_bench_run(s_cfg.disp, iters > 0 ? iters : 20);
+    if (all || strcmp(what, "swap") == 0)    bench_mem("swap", iters > 0 ? iters : 50, true);
+    if (all || strcmp(what, "fill") == 0)    bench_mem("fill", iters > 0 ? iters : 50, false);
+
+    app_console_printf("bench done\r\n");
+    return 0;
+}
+
+static const app_console_cmd_t s_cmd_bench = {
+    "bench", "bench gesture|loop|touch|hid|render|flush|draw|backend|swap|fill|all [iters]", cmd_bench,
+};
+
+esp_err_t app_bench_init(const app_bench_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(cfg, ESP_ERR_INVALID_ARG, TAG, "bad args");
+    s_cfg = *cfg;
+    return app_console_register(&s_cmd_bench);
+}
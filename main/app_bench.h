@@ -0,0 +1,43 @@
+/**
+ * @file app_bench.h
+ * @brief On-device benchmark commands ("bench ..." on the console)
+ *
+ * Measures the hot paths of the firmware in isolation so board profiles
+ * and code changes can be compared with numbers instead of feel:
+ * gesture engine, touch read, HID report submit, LVGL render/flush,
+ * RGB565 byte swap and memory fill throughput.
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "esp_lcd_panel_ops.h"
+#include "esp_lcd_touch.h"
+#include "lvgl.h"
+#include "app_hid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Handles the benchmarks operate on (NULL = benchmark unavailable)
+ */
+typedef struct {
+    esp_lcd_panel_handle_t panel;
+    esp_lcd_touch_handle_t touch;
+    app_hid_t *hid;
+    lv_display_t *disp;
+} app_bench_cfg_t;
+
+/**
+ * @brief Register the "bench" console command
+ *
+ * @param cfg Handles (copied)
+ * @return ESP_OK on success
+ */
+esp_err_t app_bench_init(const app_bench_cfg_t *cfg);
+
+#ifdef __cplusplus
+}
+#endif
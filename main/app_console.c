@@ -0,0 +1,361 @@
+/**
+ * @file app_console.c
+ * @brief Line-based command console (USB CDC or UART)
+ */
+
+#include "app_console.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_idf_version.h"
+#include "sdkconfig.h"
+
+#if CONFIG_APP_CONSOLE_TRANSPORT_CDC
+    #include "tinyusb.h"
+    #include "device/usbd.h"
+    #include "class/cdc/cdc_device.h"
+#else
+    #include "driver/uart.h"
+#endif
+
+static const char *TAG = "app_console";
+
+#define CONSOLE_MAX_CMDS     24
+#define CONSOLE_MAX_ARGS     8
+#define CONSOLE_LINE_LEN     128
+#define CONSOLE_TX_TIMEOUT_MS 100
+
+#ifdef CONFIG_ESP_CONSOLE_UART_NUM
+    #define CONSOLE_UART_NUM CONFIG_ESP_CONSOLE_UART_NUM
+#else
+    #define CONSOLE_UART_NUM UART_NUM_0
+#endif
+
+static const app_console_cmd_t *s_cmds[CONSOLE_MAX_CMDS];
+static size_t s_cmd_count = 0;
+static SemaphoreHandle_t s_tx_lock = NULL;
+static char s_profile[224];
+
+// ========================== Transport ==========================
+
+#if CONFIG_APP_CONSOLE_TRANSPORT_CDC
+
+static esp_err_t transport_init(void)
+{
+    // TinyUSB (CDC + HID composite) is installed by app_hid_init()
+    return ESP_OK;
+}
+
+// timeout_ms 0: all or nothing, never waits (log lines)
+static size_t transport_write(const uint8_t *p, size_t len, uint32_t timeout_ms)
+{
+    if (!tud_mounted()) {
+        return 0;  // Nobody listening; drop rather than block
+    }
+    if (timeout_ms == 0) {
+        if (tud_cdc_write_available() < len) {
+            return 0;
+        }
+        size_t n = tud_cdc_write(p, len);
+        tud_cdc_write_flush();
+        return n;
+    }
+
+    size_t done = 0;
+    int64_t deadline = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+    while (done < len) {
+        uint32_t n = tud_cdc_write(p + done, len - done);
+        done += n;
+        if (n == 0) {
+            tud_cdc_write_flush();
+            if (esp_timer_get_time() > deadline) {
+                break;  // Host stopped reading
+            }
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+    }
+    tud_cdc_write_flush();
+    return done;
+}
+
+static size_t transport_read(uint8_t *p, size_t len, uint32_t timeout_ms)
+{
+    size_t done = 0;
+    int64_t deadline = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+    while (done < len) {
+        if (tud_cdc_available()) {
+            done += tud_cdc_read(p + done, len - done);
+            continue;
+        }
+        if (esp_timer_get_time() >= deadline) {
+            break;
+        }
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    return done;
+}
+
+#else // UART
+
+static esp_err_t transport_init(void)
+{
+    if (uart_is_driver_installed(CONSOLE_UART_NUM)) {
+        return ESP_OK;
+    }
+    return uart_driver_install(CONSOLE_UART_NUM, 1024, 0, 0, NULL, 0);
+}
+
+static size_t transport_write(const uint8_t *p, size_t len, uint32_t timeout_ms)
+{
+    (void)timeout_ms;   // Without a TX buffer the UART drains at line rate anyway
+    int n = uart_write_bytes(CONSOLE_UART_NUM, p, len);
+    return n > 0 ? (size_t)n : 0;
+}
+
+static size_t transport_read(uint8_t *p, size_t len, uint32_t timeout_ms)
+{
+    int n = uart_read_bytes(CONSOLE_UART_NUM, p, len, pdMS_TO_TICKS(timeout_ms));
+    return n > 0 ? (size_t)n : 0;
+}
+
+#endif
+
+// ========================== Output ==========================
+
+size_t app_console_write(const void *data, size_t len)
+{
+    if (!data || len == 0) {
+        return 0;
+    }
+    if (!s_tx_lock) {
+#if CONFIG_APP_CONSOLE_TRANSPORT_CDC
+        // Early boot log lines, before the console task exists
+        return transport_write((const uint8_t *)data, len, 0);
+#else
+        return 0;
+#endif
+    }
+    xSemaphoreTakeRecursive(s_tx_lock, portMAX_DELAY);
+    size_t n = transport_write((const uint8_t *)data, len, CONSOLE_TX_TIMEOUT_MS);
+    xSemaphoreGiveRecursive(s_tx_lock);
+    return n;
+}
+
+int app_console_log_vprintf(const char *fmt, va_list args)
+{
+    char buf[256];
+    int len = vsnprintf(buf, sizeof(buf), fmt, args);
+    if (len <= 0) {
+        return len;
+    }
+    if (len >= (int)sizeof(buf)) {
+        len = sizeof(buf) - 1;
+    }
+    // Any task may log: never wait for the lock or for the host. A line
+    // that does not fit right now is dropped.
+    if (!s_tx_lock) {
+#if CONFIG_APP_CONSOLE_TRANSPORT_CDC
+        transport_write((const uint8_t *)buf, len, 0);
+#endif
+        return len;
+    }
+    if (xSemaphoreTakeRecursive(s_tx_lock, 0) == pdTRUE) {
+        transport_write((const uint8_t *)buf, len, 0);
+        xSemaphoreGiveRecursive(s_tx_lock);
+    }
+    return len;
+}
+
+int app_console_vprintf(const char *fmt, va_list args)
+{
+    char buf[256];
+    int len = vsnprintf(buf, sizeof(buf), fmt, args);
+    if (len <= 0) {
+        return len;
+    }
+    if (len >= (int)sizeof(buf)) {
+        len = sizeof(buf) - 1;
+    }
+    app_console_write(buf, len);
+    return len;
+}
+
+int app_console_printf(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    int len = app_console_vprintf(fmt, args);
+    va_end(args);
+    return len;
+}
+
+size_t app_console_read(void *buf, size_t len, uint32_t timeout_ms)
+{
+    if (!buf || len == 0) {
+        return 0;
+    }
+    return transport_read((uint8_t *)buf, len, timeout_ms);
+}
+
+// ========================== Commands ==========================
+
+esp_err_t app_console_register(const app_console_cmd_t *cmd)
+{
+    ESP_RETURN_ON_FALSE(cmd && cmd->name && cmd->fn, ESP_ERR_INVALID_ARG, TAG, "bad command");
+    ESP_RETURN_ON_FALSE(s_cmd_count < CONSOLE_MAX_CMDS, ESP_ERR_NO_MEM, TAG, "command table full");
+    s_cmds[s_cmd_count++] = cmd;
+    return ESP_OK;
+}
+
+const char *app_console_profile(void)
+{
+    if (s_profile[0]) {
+        return s_profile;
+    }
+
+#if CONFIG_APP_DISPLAY_ILI9341_SPI
+    const char *backend = "ili9341_spi";
+#elif CONFIG_APP_DISPLAY_RGB_PARALLEL
+    const char *backend = "rgb";
+#elif CONFIG_APP_DISPLAY_LGFX && CONFIG_APP_LGFX_PANEL_RGB
+    const char *backend = "lgfx_rgb";
+#elif CONFIG_APP_DISPLAY_LGFX
+    const char *backend = "lgfx_spi";
+#elif CONFIG_APP_DISPLAY_VIRTUAL
+    const char *backend = "virtual";
+#else
+    const char *backend = "none";
+#endif
+
+#if CONFIG_APP_HID_MODE_TRACKPAD && CONFIG_APP_HID_VIRTUAL_SINK
+    const char *hid = "trackpad_sink";
+#elif CONFIG_APP_HID_MODE_TRACKPAD
+    const char *hid = "trackpad";
+#elif CONFIG_APP_HID_MODE_MACROPAD
+    const char *hid = "macropad";
+#elif CONFIG_APP_HID_MODE_GAMEPAD
+    const char *hid = "gamepad";
+#else
+    const char *hid = "none";
+#endif
+
+#ifdef CONFIG_APP_LVGL_DOUBLE_BUFFER
+    int dbuf = 1;
+#else
+    int dbuf = 0;
+#endif
+#ifdef CONFIG_APP_IRAM_HOT_PATHS
+    int iram = 1;
+#else
+    int iram = 0;
+#endif
+
+    snprintf(s_profile, sizeof(s_profile),
+             "profile=%s ver=%s target=%s cpu=%dMHz display=%s %dx%d buf_lines=%d dbuf=%d iram=%d hid=%s idf=%s",
+             CONFIG_APP_BOARD_PROFILE, CONFIG_APP_VERSION, CONFIG_IDF_TARGET,
+             CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ, backend,
+             CONFIG_APP_LCD_HRES, CONFIG_APP_LCD_VRES, CONFIG_APP_LVGL_BUF_LINES, dbuf, iram,
+             hid, esp_get_idf_version());
+    return s_profile;
+}
+
+static int cmd_help(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    for (size_t i = 0; i < s_cmd_count; i++) {
+        app_console_printf("  %-10s %s\r\n", s_cmds[i]->name, s_cmds[i]->help ? s_cmds[i]->help : "");
+    }
+    return 0;
+}
+
+static int cmd_info(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    app_console_printf("info %s\r\n", app_console_profile());
+    return 0;
+}
+
+static const app_console_cmd_t s_cmd_help = {"help", "List commands", cmd_help};
+static const app_console_cmd_t s_cmd_info = {"info", "Print board/build profile", cmd_info};
+
+static void dispatch(char *line)
+{
+    char *argv[CONSOLE_MAX_ARGS];
+    int argc = 0;
+    char *save = NULL;
+    for (char *tok = strtok_r(line, " \t", &save); tok && argc < CONSOLE_MAX_ARGS;
+         tok = strtok_r(NULL, " \t", &save)) {
+        argv[argc++] = tok;
+    }
+    if (argc == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < s_cmd_count; i++) {
+        if (strcmp(s_cmds[i]->name, argv[0]) == 0) {
+            int rc = s_cmds[i]->fn(argc, argv);
+            if (rc != 0) {
+                app_console_printf("err %s rc=%d\r\n", argv[0], rc);
+            }
+            return;
+        }
+    }
+    app_console_printf("err unknown command '%s' (try 'help')\r\n", argv[0]);
+}
+
+static void console_task(void *arg)
+{
+    (void)arg;
+    char line[CONSOLE_LINE_LEN];
+    size_t pos = 0;
+
+    while (true) {
+        uint8_t c;
+        if (transport_read(&c, 1, 50) == 0) {
+            continue;
+        }
+        if (c == '\r' || c == '\n') {
+            if (pos > 0) {
+                line[pos] = '\0';
+                dispatch(line);
+                pos = 0;
+            }
+        } else if (c == 0x08 || c == 0x7F) {
+            if (pos > 0) {
+                pos--;
+            }
+        } else if (pos < sizeof(line) - 1) {
+            line[pos++] = (char)c;
+        }
+    }
+}
+
+esp_err_t app_console_init(void)
+{
+    ESP_RETURN_ON_FALSE(s_tx_lock == NULL, ESP_ERR_INVALID_STATE, TAG, "already initialized");
+
+    s_tx_lock = xSemaphoreCreateRecursiveMutex();
+    ESP_RETURN_ON_FALSE(s_tx_lock, ESP_ERR_NO_MEM, TAG, "tx lock");
+    ESP_RETURN_ON_ERROR(transport_init(), TAG, "transport init");
+
+    app_console_register(&s_cmd_help);
+    app_console_register(&s_cmd_info);
+
+    // Pinned so cycle-counter based measurements taken in command
+    // handlers never straddle the two cores' independent counters
+    BaseType_t ok = xTaskCreatePinnedToCore(console_task, "console", 6144, NULL, 3, NULL,
+                                            portNUM_PROCESSORS - 1);
+    ESP_RETURN_ON_FALSE(ok == pdPASS, ESP_ERR_NO_MEM, TAG, "console task");
+
+    ESP_LOGI(TAG, "Console ready (%s)", app_console_profile());
+    return ESP_OK;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file app_console.h
+ * @brief Line-based command console (USB CDC or UART)
+ *
+ * Small command shell used for diagnostics (benchmarks, tracing, ...).
+ * Modules register commands at init; the console task reads lines from
+ * the selected transport and dispatches them. Command handlers run in the
+ * console task and may read raw payload bytes with app_console_read().
+ */
+
+#pragma once
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Command handler
+ *
+ * @param argc Number of arguments (argv[0] is the command name)
+ * @param argv Argument strings
+ * @return 0 on success, non-zero on error
+ */
+typedef int (*app_console_cmd_fn_t)(int argc, char **argv);
+
+/**
+ * @brief Command descriptor (must stay valid after registration)
+ */
+typedef struct {
+    const char *name;
+    const char *help;
+    app_console_cmd_fn_t fn;
+} app_console_cmd_t;
+
+/**
+ * @brief Start the console task on the configured transport
+ *
+ * For the CDC transport, TinyUSB must already be installed (app_hid_init()).
+ *
+ * @return ESP_OK on success
+ */
+esp_err_t app_console_init(void);
+
+/**
+ * @brief Register a command
+ *
+ * @param cmd Command descriptor (static storage)
+ * @return ESP_OK, or ESP_ERR_NO_MEM if the command table is full
+ */
+esp_err_t app_console_register(const app_console_cmd_t *cmd);
+
+/**
+ * @brief Formatted output to the console transport
+ */
+int app_console_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+int app_console_vprintf(const char *fmt, va_list args);
+
+/**
+ * @brief esp_log_set_vprintf() hook: log output that never blocks
+ *
+ * Unlike app_console_printf(), which waits up to 100 ms for the host to
+ * read, the line is dropped if the TX lock is held or the transport has
+ * no room for it, so logging cannot stall the calling task.
+ */
+int app_console_log_vprintf(const char *fmt, va_list args);
+
+/**
+ * @brief Raw output to the console transport
+ *
+ * @return Number of bytes written (may be short if the host stops reading)
+ */
+size_t app_console_write(const void *data, size_t len);
+
+/**
+ * @brief Raw input from the console transport
+ *
+ * Blocks until len bytes arrived or timeout_ms elapsed. Commands that take
+ * a binary payload after their command line expect the host to end that
+ * line with a single '\n' (a CR+LF pair would leave the LF in the stream).
+ *
+ * @return Number of bytes read
+ */
+size_t app_console_read(void *buf, size_t len, uint32_t timeout_ms);
+
+/**
+ * @brief Build/board identification string
+ *
+ * Contains the board profile tag, display backend, resolution and buffer
+ * settings, so results from different sdkconfig profiles can be compared.
+ */
+const char *app_console_profile(void);
+
+#ifdef __cplusplus
+}
+#endif
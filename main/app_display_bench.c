@@ -0,0 +1,268 @@
+/**
+ * @file app_display_bench.c
+ * @brief Display backend benchmark ("bench backend")
+ */
+
+#include "app_display_bench.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_lvgl_port.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+#if CONFIG_APP_DISPLAY_ILI9341_SPI
+    #include "app_display_ili9341.h"
+#elif CONFIG_APP_DISPLAY_RGB_PARALLEL
+    #include "app_display_rgb.h"
+#elif CONFIG_APP_DISPLAY_LGFX
+    #include "app_display_lgfx.h"
+#elif CONFIG_APP_DISPLAY_VIRTUAL
+    #include "app_display_virtual.h"
+#endif
+
+#include "app_console.h"
+#include "app_lvgl.h"
+
+static const char *TAG = "app_display_bench";
+
+#define HRES            CONFIG_APP_LCD_HRES
+#define VRES            CONFIG_APP_LCD_VRES
+#define STRIP_LINES     16      // Same strip height on every backend
+#define STRIP_PX        (HRES * STRIP_LINES)
+#define RECT_SIZE       64
+#define RECTS_PER_ITER  32
+#define SCROLL_STEP     4
+#define IMG_SIZE        128
+#define IMG_PER_FRAME   8
+
+static const uint16_t s_colors[] = {0xF800, 0x07E0, 0x001F, 0xFFFF};
+
+typedef struct {
+    uint32_t n;         // Frames or rectangles
+    uint64_t px;
+    int64_t us;
+    uint32_t max_us;
+} bench_result_t;
+
+// ========================== Helpers ==========================
+
+static void fill565(uint16_t *buf, size_t px, uint16_t color)
+{
+    uint32_t pattern = ((uint32_t)color << 16) | color;
+    uint32_t *w = (uint32_t *)buf;
+    for (size_t i = 0; i < px / 2; i++) {
+        w[i] = pattern;
+    }
+    if (px & 1) buf[px - 1] = color;
+}
+
+static void result_add(bench_result_t *r, int64_t t0, uint64_t px)
+{
+    uint32_t dt = (uint32_t)(esp_timer_get_time() - t0);
+    r->n++;
+    r->px += px;
+    r->us += dt;
+    if (dt > r->max_us) r->max_us = dt;
+}
+
+static void result_print(const char *workload, const bench_result_t *r)
+{
+    app_console_printf("bench name=backend_%s backend=%s n=%u us_avg=%.1f us_max=%u rate=%.1f MBps=%.2f\r\n",
+                       workload, app_display_backend_name(), (unsigned)r->n,
+                       r->n ? (double)r->us / r->n : 0.0, (unsigned)r->max_us,
+                       r->us ? 1e6 * r->n / (double)r->us : 0.0,
+                       r->us ? (double)r->px * 2 / (double)r->us : 0.0);
+}
+
+// ========================== Workloads ==========================
+
+// Solid frames: each strip is filled while the other is on the bus
+static void run_fill(uint16_t *strip[2], int iters)
+{
+    bench_result_t r = {0};
+    int cur = 0;
+    for (int f = 0; f < iters; f++) {
+        uint16_t color = s_colors[f % 4];
+        int64_t t0 = esp_timer_get_time();
+        for (int y = 0; y < VRES; y += STRIP_LINES) {
+            int rows = VRES - y < STRIP_LINES ? VRES - y : STRIP_LINES;
+            fill565(strip[cur], (size_t)HRES * rows, color);
+            app_display_blit(0, y, HRES, rows, strip[cur]);
+            cur ^= 1;
+        }
+        app_display_sync();
+        result_add(&r, t0, (uint64_t)HRES * VRES);
+    }
+    result_print("fill", &r);
+}
+
+// Small updates, where per-transfer setup dominates
+static void run_partial(uint16_t *strip[2], int iters)
+{
+    const int size = RECT_SIZE < VRES ? RECT_SIZE : VRES;
+    bench_result_t r = {0};
+    uint32_t seed = 12345;     // Fixed, so every backend gets the same positions
+    int cur = 0;
+    for (int i = 0; i < iters * RECTS_PER_ITER; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int x = (int)((seed >> 8) % (uint32_t)(HRES - size + 1));
+        int y = (int)((seed >> 20) % (uint32_t)(VRES - size + 1));
+        // Each blit returns once the previous rectangle is done, so the
+        // per-rectangle time is the steady-state cost of one update
+        int64_t t0 = esp_timer_get_time();
+        fill565(strip[cur], (size_t)size * size, s_colors[i % 4]);
+        app_display_blit(x, y, size, size, strip[cur]);
+        result_add(&r, t0, (uint64_t)size * size);
+        cur ^= 1;
+    }
+    int64_t t0 = esp_timer_get_time();
+    app_display_sync();
+    r.us += esp_timer_get_time() - t0;
+    result_print("partial", &r);
+}
+
+// Full-width band with vertical stripes moving sideways, regenerated per strip
+static void run_scroll(uint16_t *strip[2], int iters)
+{
+    const int band_h = VRES / 4;
+    const int band_y = (VRES - band_h) / 2;
+    bench_result_t r = {0};
+    int cur = 0;
+    for (int f = 0; f < iters; f++) {
+        int off = f * SCROLL_STEP;
+        int64_t t0 = esp_timer_get_time();
+        for (int y = 0; y < band_h; y += STRIP_LINES) {
+            int rows = band_h - y < STRIP_LINES ? band_h - y : STRIP_LINES;
+            uint16_t *row = strip[cur];
+            for (int x = 0; x < HRES; x++) {
+                row[x] = ((x + off) / 16) & 1 ? 0xFFE0 : 0x0010;
+            }
+            for (int k = 1; k < rows; k++) {
+                memcpy(row + k * HRES, row, HRES * sizeof(uint16_t));
+            }
+            app_display_blit(0, band_y + y, HRES, rows, strip[cur]);
+            cur ^= 1;
+        }
+        app_display_sync();
+        result_add(&r, t0, (uint64_t)HRES * band_h);
+    }
+    result_print("scroll", &r);
+}
+
+// Image blits: copy from the source image into the transfer buffer, as LVGL
+// does when it draws an image into its draw buffer
+static void run_image(uint16_t *strip[2], int iters)
+{
+    const int size = IMG_SIZE < VRES ? IMG_SIZE : VRES;
+    const int lines = STRIP_PX / size;
+    const size_t img_px = (size_t)size * size;
+
+    uint16_t *img = heap_caps_malloc(img_px * sizeof(uint16_t), MALLOC_CAP_SPIRAM);
+    if (!img) img = heap_caps_malloc(img_px * sizeof(uint16_t), MALLOC_CAP_8BIT);
+    if (!img) {
+        app_console_printf("bench name=backend_image skipped=no_mem\r\n");
+        return;
+    }
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            img[y * size + x] = (uint16_t)(((x >> 2) << 11) | ((y >> 1) << 5) | ((x ^ y) & 0x1F));
+        }
+    }
+
+    bench_result_t r = {0};
+    int cur = 0;
+    for (int f = 0; f < iters; f++) {
+        int64_t t0 = esp_timer_get_time();
+        for (int i = 0; i < IMG_PER_FRAME; i++) {
+            int x = (i * (HRES - size)) / (IMG_PER_FRAME - 1);
+            int y = (i & 1) ? VRES - size : 0;
+            for (int row = 0; row < size; row += lines) {
+                int rows = size - row < lines ? size - row : lines;
+                memcpy(strip[cur], img + (size_t)row * size, (size_t)rows * size * sizeof(uint16_t));
+                app_display_blit(x, y + row, size, rows, strip[cur]);
+                cur ^= 1;
+            }
+        }
+        app_display_sync();
+        result_add(&r, t0, (uint64_t)IMG_PER_FRAME * img_px);
+    }
+    heap_caps_free(img);
+    result_print("image", &r);
+}
+
+// The backend's real LVGL path: render plus flush of the active screen
+static void run_lvgl(lv_display_t *disp, int iters)
+{
+    bench_result_t r = {0};
+    app_lvgl_stats_t lv;
+
+    app_lvgl_lock(0);
+    app_lvgl_reset_stats();
+    for (int f = 0; f < iters; f++) {
+        lv_obj_invalidate(lv_display_get_screen_active(disp));
+        int64_t t0 = esp_timer_get_time();
+        lv_refr_now(disp);
+        result_add(&r, t0, (uint64_t)HRES * VRES);
+    }
+    app_lvgl_get_stats(&lv);
+    app_lvgl_unlock();
+
+    result_print("lvgl", &r);
+    app_console_printf("bench name=backend_lvgl_flush backend=%s flush_us_avg=%.1f render_us_avg=%.1f\r\n",
+                       app_display_backend_name(),
+                       r.n ? (double)lv.flush_us / r.n : 0.0,
+                       r.n && r.us > (int64_t)lv.flush_us ? (double)(r.us - (int64_t)lv.flush_us) / r.n : 0.0);
+}
+
+// ========================== Entry ==========================
+
+void app_display_bench_run(lv_display_t *disp, int iters)
+{
+    uint16_t *strip[2] = {
+        heap_caps_malloc(STRIP_PX * sizeof(uint16_t), MALLOC_CAP_DMA),
+        heap_caps_malloc(STRIP_PX * sizeof(uint16_t), MALLOC_CAP_DMA),
+    };
+    if (!strip[0] || !strip[1]) {
+        heap_caps_free(strip[0]);
+        heap_caps_free(strip[1]);
+        app_console_printf("bench name=backend skipped=no_mem\r\n");
+        return;
+    }
+
+    app_console_printf("bench backend %s %dx%d strip_lines=%d\r\n",
+                       app_display_backend_name(), HRES, VRES, STRIP_LINES);
+    ESP_LOGI(TAG, "Backend benchmark: %d iterations per workload", iters);
+
+    // Take the panel from LVGL the way "display host" does: stop the task,
+    // then take and drop the lock so a refresh in progress has finished
+    lvgl_port_stop();
+    if (app_lvgl_lock(0)) {
+        app_lvgl_unlock();
+    }
+
+    run_fill(strip, iters);
+    run_partial(strip, iters);
+    run_scroll(strip, iters);
+    run_image(strip, iters);
+
+    // Raw blits are done; the strips must not be freed while still on the bus
+    app_display_sync();
+    heap_caps_free(strip[0]);
+    heap_caps_free(strip[1]);
+
+    if (disp) {
+        run_lvgl(disp, iters);
+    } else {
+        app_console_printf("bench name=backend_lvgl skipped=no_lvgl\r\n");
+    }
+
+    if (disp && app_lvgl_lock(0)) {
+        lv_obj_invalidate(lv_display_get_screen_active(disp));
+        app_lvgl_unlock();
+    }
+    lvgl_port_resume();
+}
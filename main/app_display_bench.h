@@ -0,0 +1,41 @@
+/**
+ * @file app_display_bench.h
+ * @brief Display backend benchmark ("bench backend")
+ *
+ * Runs the same workloads through whichever display backend the build
+ * selected (esp_lcd ILI9341, esp_lcd RGB or LovyanGFX) via
+ * app_display_blit()/app_display_sync(), so reports from builds of the same
+ * board with different backends line up workload by workload:
+ *
+ *   fill     full-screen solid frames, sent in 16-row strips
+ *   partial  64x64 rectangles at pseudo-random positions
+ *   scroll   a full-width band whose content moves 4 px per frame
+ *   image    a 128x128 RGB565 image copied to 8 positions per frame
+ *   lvgl     full redraws of the active LVGL screen (UI or demo)
+ *
+ * Feed the console logs of several builds to tools/bench_report.py for a
+ * side-by-side table.
+ */
+
+#pragma once
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Run all backend workloads and print one "bench name=backend_..." line each
+ *
+ * Pauses the LVGL task for the duration and repaints afterwards. Call
+ * without the LVGL lock held.
+ *
+ * @param disp LVGL display (for the lvgl workload; NULL skips it)
+ * @param iters Frames per workload (partial: 32 rectangles per iteration)
+ */
+void app_display_bench_run(lv_display_t *disp, int iters);
+
+#ifdef __cplusplus
+}
+#endif
@@ -10,9 +10,13 @@
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lcd_ili9341.h"
+#include "lvgl.h"
 
 static const char *TAG = "app_display";
 
+static esp_lcd_panel_handle_t s_panel = NULL;
+static esp_lcd_panel_io_handle_t s_io = NULL;
+
 #ifdef CONFIG_APP_LCD_BL_PWM_ENABLE
 static ledc_channel_t s_bl_ledc_channel = LEDC_CHANNEL_0;
 static uint32_t s_bl_max_duty = 0;
@@ -150,6 +154,8 @@ esp_err_t app_display_init(app_display_t *out)
 #endif
     }
 
+    s_panel = panel;
+    s_io = io;
     out->panel = panel;
     out->io = io;
     ESP_LOGI(TAG, "Display init OK (%dx%d, SPI=%d Hz)", CONFIG_APP_LCD_HRES, CONFIG_APP_LCD_VRES, CONFIG_APP_LCD_SPI_CLOCK_HZ);
@@ -198,3 +204,28 @@ uint32_t app_display_get_backlight_duty(void)
     return 0;
 }
 #endif
+
+// ========================== Raw pixel path ==========================
+
+esp_err_t app_display_blit(int x, int y, int w, int h, uint16_t *px)
+{
+    ESP_RETURN_ON_FALSE(s_panel, ESP_ERR_INVALID_STATE, TAG, "not initialized");
+#ifdef CONFIG_APP_LCD_SWAP_BYTES
+    lv_draw_sw_rgb565_swap(px, (uint32_t)w * h);
+#endif
+    // Queued on the SPI bus. The window commands of the next draw_bitmap wait
+    // for this transfer, so the previous buffer is free when this returns.
+    return esp_lcd_panel_draw_bitmap(s_panel, x, y, x + w, y + h, px);
+}
+
+esp_err_t app_display_sync(void)
+{
+    ESP_RETURN_ON_FALSE(s_io, ESP_ERR_INVALID_STATE, TAG, "not initialized");
+    // A parameter write waits for all queued color transfers first; 0x00 is NOP
+    return esp_lcd_panel_io_tx_param(s_io, 0x00, NULL, 0);
+}
+
+const char *app_display_backend_name(void)
+{
+    return "ili9341";
+}
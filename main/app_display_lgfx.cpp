@@ -2,6 +2,8 @@
 
 #include "sdkconfig.h"
 
+#include <string.h>
+
 #include "esp_check.h"
 #include "esp_log.h"
 #include "driver/gpio.h"
@@ -19,6 +21,9 @@ static const char *TAG = "app_display_lgfx";
 // Global LGFX instance
 static LGFX *s_lgfx = nullptr;
 
+// Set once LVGL renders straight into the panel framebuffer (rotation pinned)
+static bool s_fb_direct = false;
+
 #ifdef CONFIG_APP_LCD_BL_PWM_ENABLE
 static ledc_channel_t s_bl_ledc_channel = LEDC_CHANNEL_0;
 static uint32_t s_bl_max_duty = 0;
@@ -48,6 +53,12 @@ bool app_display_cycle_orientation(void *ctx)
         return false;
     }
 
+    if (s_fb_direct) {
+        // LVGL writes framebuffer memory directly, so LGFX rotation would not apply
+        ESP_LOGW(TAG, "Rotation is fixed while LVGL renders into the framebuffer");
+        return false;
+    }
+
     // Cycle through rotations: 0 -> 1 -> 2 -> 3 -> 0
     uint8_t current_rotation = s_lgfx->getRotation();
     uint8_t next_rotation = (current_rotation + 1) % 4;
@@ -201,6 +212,53 @@ extern "C" LGFX* app_display_get_lgfx(void)
     return s_lgfx;
 }
 
+// Framebuffer LVGL can render into directly, or NULL if that's not safe:
+// only RGB panels at rotation 0 and 16 bpp, with rows contiguous in memory
+// and pixels stored in LVGL's native (little-endian) RGB565 order
+extern "C" void *lgfx_get_framebuffer(void *lgfx)
+{
+#if CONFIG_APP_LGFX_PANEL_RGB
+    if (!lgfx) return nullptr;
+
+    LGFX *gfx = static_cast<LGFX*>(lgfx);
+    uint8_t **lines = gfx->frameLines();
+    if (!lines || !lines[0]) return nullptr;
+
+    if (gfx->getRotation() != 0 || gfx->getColorDepth() != 16) {
+        ESP_LOGI(TAG, "Framebuffer not usable: rotation %d, %d bpp",
+                 gfx->getRotation(), gfx->getColorDepth());
+        return nullptr;
+    }
+
+    const size_t stride = CONFIG_APP_LCD_HRES * 2;
+    for (int y = 1; y < CONFIG_APP_LCD_VRES; y++) {
+        if (lines[y] != lines[0] + y * stride) {
+            ESP_LOGI(TAG, "Framebuffer not usable: rows are not contiguous");
+            return nullptr;
+        }
+    }
+
+    // Probe the stored byte order with a known color. LGFX keeps pixels in
+    // its own format; LVGL can only share the memory if that is plain RGB565.
+    uint16_t saved;
+    memcpy(&saved, lines[0], sizeof(saved));
+    gfx->drawPixel(0, 0, (uint16_t)0xF800);
+    uint16_t probe;
+    memcpy(&probe, lines[0], sizeof(probe));
+    memcpy(lines[0], &saved, sizeof(saved));
+    if (probe != 0xF800) {
+        ESP_LOGI(TAG, "Framebuffer not usable: stored RGB565 is 0x%04x for 0xF800", probe);
+        return nullptr;
+    }
+
+    s_fb_direct = true;
+    return lines[0];
+#else
+    (void)lgfx;
+    return nullptr;
+#endif
+}
+
 // Push pixels from LVGL to LovyanGFX
 // This is called from the LVGL flush callback in app_lvgl.c
 extern "C" void lgfx_push_pixels(void *lgfx, int x1, int y1, int x2, int y2, const uint8_t *data)
@@ -219,3 +277,42 @@ extern "C" void lgfx_push_pixels(void *lgfx, int x1, int y1, int x2, int y2, con
     gfx->pushPixelsDMA((uint16_t*)data, w * h);
     gfx->endWrite();
 }
+
+// Fill a panel rectangle with one RGB565 color (address window + repeated
+// color on SPI). Called from the LVGL flush callback for solid areas.
+extern "C" void lgfx_fill_rect(void *lgfx, int x, int y, int w, int h, uint16_t color)
+{
+    if (!lgfx) return;
+
+    LGFX *gfx = static_cast<LGFX*>(lgfx);
+    gfx->startWrite();
+    gfx->fillRect(x, y, w, h, color);
+    gfx->endWrite();
+}
+
+// ========================== Raw pixel path ==========================
+
+extern "C" esp_err_t app_display_blit(int x, int y, int w, int h, uint16_t *px)
+{
+    ESP_RETURN_ON_FALSE(s_lgfx, ESP_ERR_INVALID_STATE, TAG, "not initialized");
+    // Same path as the LVGL flush. LGFX waits for the previous DMA before
+    // setting the next window, so the previous buffer is free on return.
+    lgfx_push_pixels(s_lgfx, x, y, x + w, y + h, (const uint8_t *)px);
+    return ESP_OK;
+}
+
+extern "C" esp_err_t app_display_sync(void)
+{
+    ESP_RETURN_ON_FALSE(s_lgfx, ESP_ERR_INVALID_STATE, TAG, "not initialized");
+    s_lgfx->waitDMA();
+    return ESP_OK;
+}
+
+extern "C" const char *app_display_backend_name(void)
+{
+#if CONFIG_APP_LGFX_PANEL_RGB
+    return "lgfx_rgb";
+#else
+    return "lgfx_spi";
+#endif
+}
@@ -229,3 +229,23 @@ uint32_t app_display_get_backlight_duty(void)
     return 0;
 }
 #endif
+
+// ========================== Raw pixel path ==========================
+
+esp_err_t app_display_blit(int x, int y, int w, int h, uint16_t *px)
+{
+    ESP_RETURN_ON_FALSE(s_panel, ESP_ERR_INVALID_STATE, TAG, "not initialized");
+    // Same path as the LVGL flush: copy into the framebuffer, cache write-back
+    return esp_lcd_panel_draw_bitmap(s_panel, x, y, x + w, y + h, px);
+}
+
+esp_err_t app_display_sync(void)
+{
+    // draw_bitmap has already copied into the framebuffer when it returns
+    return ESP_OK;
+}
+
+const char *app_display_backend_name(void)
+{
+    return "rgb";
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <stdint.h>
 #include "esp_err.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
@@ -23,6 +24,15 @@ bool app_display_set_backlight_percent(uint8_t percent);
 esp_err_t app_display_set_backlight_duty(uint32_t duty);
 uint32_t app_display_get_backlight_duty(void);
 
+/* Raw pixel path (backend benchmark): RGB565 as LVGL stores it. Returns once
+ * the rectangle is queued; the buffer passed to the previous call is free
+ * again by then. px must be DMA-capable and may be byte-swapped in place. */
+esp_err_t app_display_blit(int x, int y, int w, int h, uint16_t *px);
+/* Wait until every queued blit has reached the panel */
+esp_err_t app_display_sync(void);
+/* Short backend name for reports ("ili9341", "rgb", "lgfx_spi", "lgfx_rgb") */
+const char *app_display_backend_name(void);
+
 #ifdef __cplusplus
 }
 #endif
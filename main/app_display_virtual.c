@@ -0,0 +1,228 @@
+/**
+ * @file app_display_virtual.c
+ * @brief Virtual panel for QEMU runs (esp_lcd panel backed by a RAM framebuffer)
+ */
+
+#include "app_display_virtual.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdkconfig.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_lcd_panel_interface.h"
+#include "esp_memory_utils.h"
+#include "esp_rom_crc.h"
+
+#if CONFIG_APP_CONSOLE_ENABLE
+    #include "app_console.h"
+    #include "app_lvgl.h"
+#endif
+
+static const char *TAG = "app_display";
+
+typedef struct {
+    esp_lcd_panel_t base;
+    uint16_t *fb;               // HRES x VRES, RGB565 as LVGL stores it
+    bool invert;
+    bool on;
+    uint32_t flushes;
+    uint64_t px;
+} vpanel_t;
+
+static esp_lcd_panel_handle_t s_panel = NULL;
+static uint32_t s_bl_percent = 100;
+
+// ========================== Panel ops ==========================
+
+static esp_err_t vpanel_reset(esp_lcd_panel_t *panel)
+{
+    vpanel_t *vp = __containerof(panel, vpanel_t, base);
+    memset(vp->fb, 0, (size_t)CONFIG_APP_LCD_HRES * CONFIG_APP_LCD_VRES * sizeof(uint16_t));
+    return ESP_OK;
+}
+
+static esp_err_t vpanel_init(esp_lcd_panel_t *panel)
+{
+    return ESP_OK;
+}
+
+static esp_err_t vpanel_del(esp_lcd_panel_t *panel)
+{
+    vpanel_t *vp = __containerof(panel, vpanel_t, base);
+    heap_caps_free(vp->fb);
+    free(vp);
+    s_panel = NULL;
+    return ESP_OK;
+}
+
+// Same contract as the bus backends: end coordinates are exclusive and
+// the caller's buffer is free again once this returns
+static esp_err_t vpanel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, int y_start,
+                                    int x_end, int y_end, const void *color_data)
+{
+    vpanel_t *vp = __containerof(panel, vpanel_t, base);
+    ESP_RETURN_ON_FALSE(x_start >= 0 && y_start >= 0 && x_start < x_end && y_start < y_end &&
+                        x_end <= CONFIG_APP_LCD_HRES && y_end <= CONFIG_APP_LCD_VRES,
+                        ESP_ERR_INVALID_ARG, TAG, "bad area");
+
+    const uint16_t *src = (const uint16_t *)color_data;
+    size_t w = (size_t)(x_end - x_start);
+    for (int y = y_start; y < y_end; y++) {
+        memcpy(vp->fb + (size_t)y * CONFIG_APP_LCD_HRES + x_start, src, w * sizeof(uint16_t));
+        src += w;
+    }
+    vp->flushes++;
+    vp->px += w * (size_t)(y_end - y_start);
+    return ESP_OK;
+}
+
+static esp_err_t vpanel_invert_color(esp_lcd_panel_t *panel, bool invert_color_data)
+{
+    __containerof(panel, vpanel_t, base)->invert = invert_color_data;
+    return ESP_OK;
+}
+
+static esp_err_t vpanel_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
+{
+    __containerof(panel, vpanel_t, base)->on = on_off;
+    return ESP_OK;
+}
+
+// ========================== Console ==========================
+
+#if CONFIG_APP_CONSOLE_ENABLE
+static int cmd_vpanel(int argc, char **argv)
+{
+    vpanel_t *vp = s_panel ? __containerof(s_panel, vpanel_t, base) : NULL;
+    if (!vp) {
+        app_console_printf("vpanel: not initialized\r\n");
+        return 1;
+    }
+    if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+        vp->flushes = 0;
+        vp->px = 0;
+        app_console_printf("vpanel counters reset\r\n");
+        return 0;
+    }
+
+    // Hold LVGL off the framebuffer so the CRC is of a complete frame
+    if (!app_lvgl_lock(1000)) {
+        app_console_printf("vpanel: LVGL busy\r\n");
+        return 1;
+    }
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)vp->fb,
+                                    (uint32_t)CONFIG_APP_LCD_HRES * CONFIG_APP_LCD_VRES * sizeof(uint16_t));
+    uint32_t flushes = vp->flushes;
+    uint64_t px = vp->px;
+    app_lvgl_unlock();
+
+    app_console_printf("vpanel %dx%d flushes=%u px=%llu crc=0x%08x invert=%d on=%d bl=%u\r\n",
+                       CONFIG_APP_LCD_HRES, CONFIG_APP_LCD_VRES, (unsigned)flushes,
+                       (unsigned long long)px, (unsigned)crc, vp->invert, vp->on, (unsigned)s_bl_percent);
+    return 0;
+}
+
+static const app_console_cmd_t s_cmd_vpanel = {
+    "vpanel", "vpanel [reset] - virtual panel counters and framebuffer CRC", cmd_vpanel,
+};
+#endif
+
+// ========================== Public API ==========================
+
+bool app_display_set_invert(void *ctx, bool on)
+{
+    return s_panel && esp_lcd_panel_invert_color(s_panel, on) == ESP_OK;
+}
+
+bool app_display_cycle_orientation(void *ctx)
+{
+    // The framebuffer has one fixed layout; rotation belongs to LVGL
+    ESP_LOGW(TAG, "Orientation cycling not supported on the virtual panel");
+    return false;
+}
+
+esp_err_t app_display_init(app_display_t *out)
+{
+    ESP_RETURN_ON_FALSE(out, ESP_ERR_INVALID_ARG, TAG, "null out");
+
+    vpanel_t *vp = calloc(1, sizeof(vpanel_t));
+    ESP_RETURN_ON_FALSE(vp, ESP_ERR_NO_MEM, TAG, "no mem for panel");
+
+    // PSRAM when the build has it, internal RAM otherwise (150 KB at 240x320)
+    size_t fb_size = (size_t)CONFIG_APP_LCD_HRES * CONFIG_APP_LCD_VRES * sizeof(uint16_t);
+    vp->fb = heap_caps_malloc(fb_size, MALLOC_CAP_SPIRAM);
+    if (!vp->fb) {
+        vp->fb = heap_caps_malloc(fb_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+    if (!vp->fb) {
+        free(vp);
+        ESP_RETURN_ON_ERROR(ESP_ERR_NO_MEM, TAG, "framebuffer alloc failed (%u bytes)", (unsigned)fb_size);
+    }
+
+    vp->base.reset = vpanel_reset;
+    vp->base.init = vpanel_init;
+    vp->base.del = vpanel_del;
+    vp->base.draw_bitmap = vpanel_draw_bitmap;
+    vp->base.invert_color = vpanel_invert_color;
+    vp->base.disp_on_off = vpanel_disp_on_off;
+    esp_lcd_panel_handle_t panel = &vp->base;
+
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_reset(panel), TAG, "panel_reset");
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_init(panel), TAG, "panel_init");
+#ifdef CONFIG_APP_LCD_INVERT_DEFAULT
+    esp_lcd_panel_invert_color(panel, true);
+#endif
+    esp_lcd_panel_disp_on_off(panel, true);
+    s_panel = panel;
+
+#if CONFIG_APP_CONSOLE_ENABLE
+    app_console_register(&s_cmd_vpanel);
+#endif
+
+    out->panel = panel;
+    out->io = NULL;  // Same LVGL path as the RGB backend
+    ESP_LOGI(TAG, "Virtual display init OK (%dx%d, framebuffer in %s)",
+             CONFIG_APP_LCD_HRES, CONFIG_APP_LCD_VRES,
+             esp_ptr_external_ram(vp->fb) ? "PSRAM" : "internal RAM");
+    return ESP_OK;
+}
+
+bool app_display_set_backlight_percent(uint8_t percent)
+{
+    s_bl_percent = percent > 100 ? 100 : percent;
+    return true;
+}
+
+esp_err_t app_display_set_backlight_duty(uint32_t duty)
+{
+    s_bl_percent = duty > 100 ? 100 : duty;
+    return ESP_OK;
+}
+
+uint32_t app_display_get_backlight_duty(void)
+{
+    // No PWM behind it: duty is in percent
+    return s_bl_percent;
+}
+
+// ========================== Raw pixel path ==========================
+
+esp_err_t app_display_blit(int x, int y, int w, int h, uint16_t *px)
+{
+    ESP_RETURN_ON_FALSE(s_panel, ESP_ERR_INVALID_STATE, TAG, "not initialized");
+    // Same path as the LVGL flush: copied into the framebuffer on return
+    return esp_lcd_panel_draw_bitmap(s_panel, x, y, x + w, y + h, px);
+}
+
+esp_err_t app_display_sync(void)
+{
+    return ESP_OK;
+}
+
+const char *app_display_backend_name(void)
+{
+    return "virtual";
+}
@@ -0,0 +1,53 @@
+/**
+ * @file app_display_virtual.h
+ * @brief Virtual panel for QEMU runs (esp_lcd panel backed by a RAM framebuffer)
+ *
+ * An esp_lcd panel with no bus behind it: draw_bitmap copies the pixels
+ * into a framebuffer and returns, so LVGL, the benchmarks and the host
+ * display stream run their full code path on Espressif's QEMU without any
+ * LCD peripheral. Registers the "vpanel" console command, which prints
+ * flush counters and a CRC of the framebuffer so a run can also check
+ * that the rendered image did not change.
+ *
+ * Uses the same API as the other display backends; io is NULL, like the
+ * RGB backend.
+ */
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_lcd_panel_io.h"
+#include "esp_lcd_panel_ops.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    esp_lcd_panel_handle_t panel;
+    esp_lcd_panel_io_handle_t io;  // Always NULL (no IO layer)
+} app_display_t;
+
+esp_err_t app_display_init(app_display_t *out);
+
+/* Generic hooks for UI/tools */
+bool app_display_set_invert(void *ctx, bool on);
+bool app_display_cycle_orientation(void *ctx);
+
+/* Backlight control (only remembered) */
+bool app_display_set_backlight_percent(uint8_t percent);
+esp_err_t app_display_set_backlight_duty(uint32_t duty);
+uint32_t app_display_get_backlight_duty(void);
+
+/* Raw pixel path (backend benchmark): RGB565 as LVGL stores it, copied
+ * into the framebuffer before returning. */
+esp_err_t app_display_blit(int x, int y, int w, int h, uint16_t *px);
+/* Nothing is ever queued; returns at once */
+esp_err_t app_display_sync(void);
+/* Short backend name for reports ("virtual") */
+const char *app_display_backend_name(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include "esp_err.h"
 #include "sdkconfig.h"
 
@@ -76,6 +77,29 @@ esp_err_t app_hid_trackpad_send_scroll(app_hid_t *hid, int8_t vertical, int8_t h
 esp_err_t app_hid_trackpad_send_report(app_hid_t *hid, uint8_t buttons,
                                         int16_t dx, int16_t dy,
                                         int8_t scroll_v, int8_t scroll_h);
+
+/**
+ * @brief Check whether a report can be queued without waiting
+ *
+ * The send functions retry for up to 5 ms while the IN endpoint is busy;
+ * callers on a deadline check this first and hold the data back instead.
+ *
+ * @param hid HID handle
+ * @return true if the endpoint is free
+ */
+bool app_hid_trackpad_ready(app_hid_t *hid);
+
+/**
+ * @brief Count the send functions' "HID busy" warnings instead of logging them
+ *
+ * For a caller that is already overloaded, so the console output does not
+ * add to it.
+ *
+ * @param hid HID handle
+ * @param quiet true to count, false to log again
+ * @return Warnings held back since quiet was set (0 when setting it)
+ */
+uint32_t app_hid_trackpad_set_quiet(app_hid_t *hid, bool quiet);
 #endif // CONFIG_APP_HID_MODE_TRACKPAD
 
 #if CONFIG_APP_HID_MODE_MACROPAD
@@ -97,6 +121,32 @@ esp_err_t app_hid_macropad_send_key(app_hid_t *hid, uint8_t modifier, uint8_t ke
  */
 esp_err_t app_hid_macropad_release_all(app_hid_t *hid);
 
+/**
+ * @brief Queue a key-down edge (keyboard hold semantics)
+ *
+ * Non-blocking; safe from LVGL callbacks. A HID task keeps the set of held
+ * keys (6-key rollover, modifiers reference-counted across keys) and sends
+ * a report on every change, so a key stays down on the host until the
+ * matching app_hid_macropad_key_up() and host auto-repeat works as with a
+ * real keyboard. Keys beyond six are ignored until a slot frees up.
+ *
+ * @param hid HID handle
+ * @param modifier Modifier bits held together with the key
+ * @param keycode HID keycode (0 for a modifier-only key)
+ * @return ESP_OK if queued, ESP_ERR_NO_MEM if the event queue is full
+ */
+esp_err_t app_hid_macropad_key_down(app_hid_t *hid, uint8_t modifier, uint8_t keycode);
+
+/**
+ * @brief Queue the key-up edge matching an earlier app_hid_macropad_key_down()
+ *
+ * @param hid HID handle
+ * @param modifier Same modifier bits as the key-down
+ * @param keycode Same keycode as the key-down
+ * @return ESP_OK if queued, ESP_ERR_NO_MEM if the event queue is full
+ */
+esp_err_t app_hid_macropad_key_up(app_hid_t *hid, uint8_t modifier, uint8_t keycode);
+
 /**
  * @brief Load key mapping from NVS for button index
  *
@@ -5,6 +5,9 @@
 
 #include "app_hid_macropad.h"
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
 #include "nvs_flash.h"
 #include "nvs.h"
 #include "tinyusb.h"
@@ -17,6 +20,27 @@ static const char *NVS_NAMESPACE = "macropad";
 
 static nvs_handle_t s_nvs_handle = 0;
 
+// ========================== Key state (HID task) ==========================
+
+#define KBD_QUEUE_LEN      32
+#define KBD_READY_WAIT_MS  20     // How long one report waits for the endpoint
+#define KBD_RESEND_MS      1      // Retry period while the current state is unsent
+
+typedef struct {
+    uint8_t modifier;
+    uint8_t keycode;
+    bool down;
+} kbd_event_t;
+
+static QueueHandle_t s_kbd_queue = NULL;
+
+// Held keys (6KRO). Counts let two buttons share a keycode or modifier.
+static struct {
+    uint8_t code[6];
+    uint8_t code_count[6];
+    uint8_t mod_count[8];
+} s_kbd;
+
 // TinyUSB HID report descriptor for keyboard
 static const uint8_t s_hid_report_descriptor[] = {
     TUD_HID_REPORT_DESC_KEYBOARD()
@@ -57,6 +81,98 @@ void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_
     (void)bufsize;
 }
 
+static void kbd_apply(const kbd_event_t *ev)
+{
+    for (int b = 0; b < 8; b++) {
+        if (!(ev->modifier & (1u << b))) continue;
+        if (ev->down) {
+            s_kbd.mod_count[b]++;
+        } else if (s_kbd.mod_count[b]) {
+            s_kbd.mod_count[b]--;
+        }
+    }
+    if (!ev->keycode) return;
+
+    int slot = -1, free_slot = -1;
+    for (int i = 0; i < 6; i++) {
+        if (s_kbd.code_count[i] && s_kbd.code[i] == ev->keycode) slot = i;
+        if (!s_kbd.code_count[i] && free_slot < 0) free_slot = i;
+    }
+    if (ev->down) {
+        if (slot < 0) slot = free_slot;
+        if (slot < 0) {
+            ESP_LOGW(TAG, "Rollover: 6 keys held, key 0x%02X ignored", ev->keycode);
+            return;
+        }
+        s_kbd.code[slot] = ev->keycode;
+        s_kbd.code_count[slot]++;
+    } else if (slot >= 0) {
+        s_kbd.code_count[slot]--;   // unmatched key-ups (ignored downs) fall through
+    }
+}
+
+// Returns false if the endpoint stayed busy (or USB is not mounted); the
+// caller keeps the state dirty and sends it again
+static bool kbd_send_state(void)
+{
+    uint8_t modifier = 0;
+    uint8_t keycodes[6] = {0};
+    for (int b = 0; b < 8; b++) {
+        if (s_kbd.mod_count[b]) modifier |= (uint8_t)(1u << b);
+    }
+    for (int i = 0, n = 0; i < 6; i++) {
+        if (s_kbd.code_count[i]) keycodes[n++] = s_kbd.code[i];
+    }
+
+    for (int waited = 0; !tud_hid_ready(); waited++) {
+        if (!tud_mounted() || waited >= KBD_READY_WAIT_MS) return false;
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    return tud_hid_keyboard_report(0, modifier, keycodes);
+}
+
+static void kbd_task(void *arg)
+{
+    (void)arg;
+    kbd_event_t ev;
+    bool dirty = false;     // s_kbd differs from what the host last got
+    while (1) {
+        // Idle until the next edge; with an unsent state, keep retrying it
+        // so a lost key-up cannot leave the key down (and repeating) on the host
+        TickType_t wait = dirty ? pdMS_TO_TICKS(KBD_RESEND_MS) : portMAX_DELAY;
+        if (xQueueReceive(s_kbd_queue, &ev, wait) == pdTRUE) {
+            kbd_apply(&ev);
+            dirty = true;
+        }
+        // One report per edge, so a quick tap still reaches the host as a
+        // down report followed by an up report
+        if (dirty) {
+            dirty = !kbd_send_state();
+        }
+    }
+}
+
+static esp_err_t kbd_post(app_hid_t *hid, uint8_t modifier, uint8_t keycode, bool down)
+{
+    if (!hid || !s_kbd_queue) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    kbd_event_t ev = { .modifier = modifier, .keycode = keycode, .down = down };
+    return xQueueSend(s_kbd_queue, &ev, 0) == pdTRUE ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+esp_err_t app_hid_macropad_key_down(app_hid_t *hid, uint8_t modifier, uint8_t keycode)
+{
+    return kbd_post(hid, modifier, keycode, true);
+}
+
+esp_err_t app_hid_macropad_key_up(app_hid_t *hid, uint8_t modifier, uint8_t keycode)
+{
+    return kbd_post(hid, modifier, keycode, false);
+}
+
+// ========================== Init / mapping ==========================
+
 esp_err_t app_hid_init(app_hid_t *hid)
 {
     if (!hid) {
@@ -86,6 +202,13 @@ esp_err_t app_hid_init(app_hid_t *hid)
 
     ESP_ERROR_CHECK(tinyusb_driver_install(&tusb_cfg));
 
+    // Key edges from the UI are turned into reports here, off the LVGL task
+    s_kbd_queue = xQueueCreate(KBD_QUEUE_LEN, sizeof(kbd_event_t));
+    if (!s_kbd_queue || xTaskCreate(kbd_task, "hid_kbd", 3072, NULL, 9, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to start keyboard task");
+        return ESP_ERR_NO_MEM;
+    }
+
     ESP_LOGI(TAG, "USB HID Macropad initialized");
     return ESP_OK;
 }
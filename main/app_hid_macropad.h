@@ -36,6 +36,7 @@ extern "C" {
 
 // Macropad mode uses functions defined in app_hid.h:
 // - app_hid_init()
+// - app_hid_macropad_key_down() / app_hid_macropad_key_up()
 // - app_hid_macropad_send_key()
 // - app_hid_macropad_release_all()
 // - app_hid_macropad_load_mapping()
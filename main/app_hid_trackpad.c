@@ -11,6 +11,10 @@
 #include "device/usbd.h"
 #include "tusb_cdc_acm.h"
 #include <stdarg.h>
+#include "app_tracer.h"
+#if CONFIG_APP_CONSOLE_TRANSPORT_CDC
+    #include "app_console.h"
+#endif
 
 static const char *TAG = "app_hid_trackpad";
 
@@ -75,15 +79,26 @@ void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_
     (void)bufsize;
 }
 
+// Report delivered to the host (TinyUSB task context)
+void tud_hid_report_complete_cb(uint8_t instance, uint8_t const *report, uint16_t len)
+{
+    (void)instance;
+    (void)report;
+    (void)len;
+    APP_TRACE_INSTANT("hid_complete");
+}
+
 // USB event callback for esp_tinyusb
 static void usb_event_cb(tinyusb_event_t *event, void *arg)
 {
     (void)arg;
     switch (event->id) {
         case TINYUSB_EVENT_ATTACHED:
+            APP_TRACE_INSTANT("usb_attached");
             ESP_LOGI(TAG, "USB attached to host");
             break;
         case TINYUSB_EVENT_DETACHED:
+            APP_TRACE_INSTANT("usb_detached");
             ESP_LOGW(TAG, "USB detached from host");
             break;
         default:
@@ -94,6 +109,11 @@ static void usb_event_cb(tinyusb_event_t *event, void *arg)
 // Custom log handler to redirect ESP_LOGx to USB CDC
 static int cdc_log_vprintf(const char *fmt, va_list args)
 {
+#if CONFIG_APP_CONSOLE_TRANSPORT_CDC
+    // Share the console's TX lock so log lines never split command output;
+    // lines are dropped rather than stalling the logging task
+    return app_console_log_vprintf(fmt, args);
+#else
     char buf[256];
     int len = vsnprintf(buf, sizeof(buf), fmt, args);
     if (len > 0) {
@@ -103,6 +123,7 @@ static int cdc_log_vprintf(const char *fmt, va_list args)
         tud_cdc_write_flush();
     }
     return len;
+#endif
 }
 
 esp_err_t app_hid_init(app_hid_t *hid)
@@ -143,12 +164,27 @@ esp_err_t app_hid_init(app_hid_t *hid)
 // Track HID ready state for debug logging
 static bool s_hid_was_ready = false;
 
+// "HID busy" warnings held back while the caller sheds load
+static bool s_quiet = false;
+static uint32_t s_quiet_busy = 0;
+
+static void warn_busy(const char *what)
+{
+    if (s_quiet) {
+        s_quiet_busy++;
+        return;
+    }
+    ESP_LOGW(TAG, "%s ignored - HID busy", what);
+}
+
 esp_err_t app_hid_trackpad_send_move(app_hid_t *hid, int16_t dx, int16_t dy)
 {
     if (!hid) {
         return ESP_ERR_INVALID_ARG;
     }
 
+    APP_TRACE_BEGIN("hid_send");
+
     // Clamp deltas to int8_t range [-127, 127]
     int8_t dx_clamped = (dx > 127) ? 127 : (dx < -127) ? -127 : (int8_t)dx;
     int8_t dy_clamped = (dy > 127) ? 127 : (dy < -127) ? -127 : (int8_t)dy;
@@ -157,6 +193,7 @@ esp_err_t app_hid_trackpad_send_move(app_hid_t *hid, int16_t dx, int16_t dy)
     for (int i = 0; i < 5; i++) {
         if (tud_hid_ready()) {
             tud_hid_mouse_report(0, 0, dx_clamped, dy_clamped, 0, 0);
+            APP_TRACE_END("hid_send");
             return ESP_OK;
         }
         // Wait 1ms before retrying
@@ -164,7 +201,8 @@ esp_err_t app_hid_trackpad_send_move(app_hid_t *hid, int16_t dx, int16_t dy)
     }
 
     // If still not ready after retries, log warning and fail
-    ESP_LOGW(TAG, "Move ignored - HID busy");
+    warn_busy("Move");
+    APP_TRACE_END("hid_send");
     return ESP_ERR_NOT_FINISHED;
 }
 
@@ -174,17 +212,21 @@ esp_err_t app_hid_trackpad_send_click(app_hid_t *hid, uint8_t buttons)
         return ESP_ERR_INVALID_ARG;
     }
 
+    APP_TRACE_BEGIN("hid_send");
+
     // Retry loop
     for (int i = 0; i < 5; i++) {
         if (tud_hid_ready()) {
             tud_hid_mouse_report(0, buttons, 0, 0, 0, 0);
             ESP_LOGD(TAG, "Mouse click (buttons=0x%02X) sent", buttons);
+            APP_TRACE_END("hid_send");
             return ESP_OK;
         }
         vTaskDelay(pdMS_TO_TICKS(1));
     }
 
-    ESP_LOGW(TAG, "Click ignored - HID busy");
+    warn_busy("Click");
+    APP_TRACE_END("hid_send");
     return ESP_ERR_NOT_FINISHED;
 }
 
@@ -194,17 +236,21 @@ esp_err_t app_hid_trackpad_send_scroll(app_hid_t *hid, int8_t vertical, int8_t h
         return ESP_ERR_INVALID_ARG;
     }
 
+    APP_TRACE_BEGIN("hid_send");
+
     // Retry loop
     for (int i = 0; i < 5; i++) {
         if (tud_hid_ready()) {
             tud_hid_mouse_report(0, 0, 0, 0, vertical, horizontal);
             ESP_LOGD(TAG, "Mouse scroll (v=%d, h=%d) sent", vertical, horizontal);
+            APP_TRACE_END("hid_send");
             return ESP_OK;
         }
         vTaskDelay(pdMS_TO_TICKS(1));
     }
 
-    ESP_LOGW(TAG, "Scroll ignored - HID busy");
+    warn_busy("Scroll");
+    APP_TRACE_END("hid_send");
     return ESP_ERR_NOT_FINISHED;
 }
 
@@ -216,6 +262,8 @@ esp_err_t app_hid_trackpad_send_report(app_hid_t *hid, uint8_t buttons,
         return ESP_ERR_INVALID_ARG;
     }
 
+    APP_TRACE_BEGIN("hid_send");
+
     // Clamp deltas to int8_t range [-127, 127]
     int8_t dx_clamped = (dx > 127) ? 127 : (dx < -127) ? -127 : (int8_t)dx;
     int8_t dy_clamped = (dy > 127) ? 127 : (dy < -127) ? -127 : (int8_t)dy;
@@ -225,11 +273,27 @@ esp_err_t app_hid_trackpad_send_report(app_hid_t *hid, uint8_t buttons,
         if (tud_hid_ready()) {
             tud_hid_mouse_report(0, buttons, dx_clamped, dy_clamped, scroll_v, scroll_h);
             ESP_LOGD(TAG, "Mouse report (btn=0x%02X, dx=%d, dy=%d) sent", buttons, dx_clamped, dy_clamped);
+            APP_TRACE_END("hid_send");
             return ESP_OK;
         }
         vTaskDelay(pdMS_TO_TICKS(1));
     }
 
-    ESP_LOGW(TAG, "Report ignored - HID busy");
+    warn_busy("Report");
+    APP_TRACE_END("hid_send");
     return ESP_ERR_NOT_FINISHED;
 }
+
+bool app_hid_trackpad_ready(app_hid_t *hid)
+{
+    return hid && tud_hid_ready();
+}
+
+uint32_t app_hid_trackpad_set_quiet(app_hid_t *hid, bool quiet)
+{
+    (void)hid;
+    uint32_t held = s_quiet ? s_quiet_busy : 0;
+    s_quiet = quiet;
+    s_quiet_busy = 0;
+    return held;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file app_hid_virtual.c
+ * @brief Trackpad mode HID sink for QEMU runs (no USB)
+ *
+ * Stands in for app_hid_trackpad.c when CONFIG_APP_HID_VIRTUAL_SINK is
+ * set: reports are counted instead of going to TinyUSB. The endpoint is
+ * modelled like the real one at bInterval 1: a queued report keeps it busy
+ * until the next 1 ms frame, and the send functions retry for up to 5 ms
+ * the same way, so the trackpad's pacing and load shedding behave as on
+ * hardware. "hidsink" on the console prints the totals.
+ */
+
+#include "app_hid_trackpad.h"
+
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "app_tracer.h"
+#if CONFIG_APP_CONSOLE_ENABLE
+    #include "app_console.h"
+#endif
+
+static const char *TAG = "app_hid_virtual";
+
+#define SINK_FRAME_US   1000    // Full-speed frame, HID bInterval 1
+#define SINK_RETRIES    5       // Same budget as app_hid_trackpad.c
+
+typedef struct {
+    uint32_t reports;
+    uint32_t moves;             // Reports with a non-zero delta
+    uint32_t button_changes;
+    uint32_t scrolls;
+    uint32_t waits;             // 1 ms retries while the endpoint was busy
+    uint32_t dropped;           // Gave up after SINK_RETRIES
+    int64_t sum_dx;
+    int64_t sum_dy;
+    int64_t sum_scroll_v;
+    int64_t sum_scroll_h;
+} sink_stats_t;
+
+static sink_stats_t s_stats;
+static int64_t s_busy_until_us;
+static uint8_t s_buttons;
+
+// "HID busy" warnings held back while the caller sheds load
+static bool s_quiet = false;
+static uint32_t s_quiet_busy = 0;
+
+// ========================== Sink ==========================
+
+static bool sink_ready(void)
+{
+    return esp_timer_get_time() >= s_busy_until_us;
+}
+
+static esp_err_t sink_report(app_hid_t *hid, uint8_t buttons, int16_t dx, int16_t dy,
+                             int8_t scroll_v, int8_t scroll_h)
+{
+    if (!hid) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    APP_TRACE_BEGIN("hid_send");
+
+    // Clamp deltas to int8_t range [-127, 127], as the real report does
+    int8_t dx_clamped = (dx > 127) ? 127 : (dx < -127) ? -127 : (int8_t)dx;
+    int8_t dy_clamped = (dy > 127) ? 127 : (dy < -127) ? -127 : (int8_t)dy;
+
+    for (int i = 0; i < SINK_RETRIES; i++) {
+        if (sink_ready()) {
+            int64_t now = esp_timer_get_time();
+            // Free again at the start of the next frame
+            s_busy_until_us = (now / SINK_FRAME_US + 1) * SINK_FRAME_US;
+
+            s_stats.reports++;
+            if (dx_clamped || dy_clamped) s_stats.moves++;
+            if (buttons != s_buttons) s_stats.button_changes++;
+            if (scroll_v || scroll_h) s_stats.scrolls++;
+            s_stats.sum_dx += dx_clamped;
+            s_stats.sum_dy += dy_clamped;
+            s_stats.sum_scroll_v += scroll_v;
+            s_stats.sum_scroll_h += scroll_h;
+            s_buttons = buttons;
+
+            APP_TRACE_END("hid_send");
+            return ESP_OK;
+        }
+        s_stats.waits++;
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+
+    s_stats.dropped++;
+    if (s_quiet) {
+        s_quiet_busy++;
+    } else {
+        ESP_LOGW(TAG, "Report ignored - HID busy");
+    }
+    APP_TRACE_END("hid_send");
+    return ESP_ERR_NOT_FINISHED;
+}
+
+// ========================== Console ==========================
+
+#if CONFIG_APP_CONSOLE_ENABLE
+static int cmd_hidsink(int argc, char **argv)
+{
+    if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+        memset(&s_stats, 0, sizeof(s_stats));
+        app_console_printf("hidsink counters reset\r\n");
+        return 0;
+    }
+
+    sink_stats_t st = s_stats;
+    app_console_printf("hidsink reports=%u moves=%u buttons=%u scrolls=%u waits=%u dropped=%u "
+                       "dx=%lld dy=%lld scroll_v=%lld scroll_h=%lld\r\n",
+                       (unsigned)st.reports, (unsigned)st.moves, (unsigned)st.button_changes,
+                       (unsigned)st.scrolls, (unsigned)st.waits, (unsigned)st.dropped,
+                       (long long)st.sum_dx, (long long)st.sum_dy,
+                       (long long)st.sum_scroll_v, (long long)st.sum_scroll_h);
+    return 0;
+}
+
+static const app_console_cmd_t s_cmd_hidsink = {
+    "hidsink", "hidsink [reset] - virtual HID sink report counters", cmd_hidsink,
+};
+#endif
+
+// ========================== Public API ==========================
+
+esp_err_t app_hid_init(app_hid_t *hid)
+{
+    if (!hid) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+#if CONFIG_APP_CONSOLE_ENABLE
+    app_console_register(&s_cmd_hidsink);
+#endif
+    ESP_LOGI(TAG, "Virtual HID sink ready (trackpad reports are counted, not sent)");
+    return ESP_OK;
+}
+
+esp_err_t app_hid_trackpad_send_move(app_hid_t *hid, int16_t dx, int16_t dy)
+{
+    return sink_report(hid, 0, dx, dy, 0, 0);
+}
+
+esp_err_t app_hid_trackpad_send_click(app_hid_t *hid, uint8_t buttons)
+{
+    return sink_report(hid, buttons, 0, 0, 0, 0);
+}
+
+esp_err_t app_hid_trackpad_send_scroll(app_hid_t *hid, int8_t vertical, int8_t horizontal)
+{
+    return sink_report(hid, 0, 0, 0, vertical, horizontal);
+}
+
+esp_err_t app_hid_trackpad_send_report(app_hid_t *hid, uint8_t buttons,
+                                        int16_t dx, int16_t dy,
+                                        int8_t scroll_v, int8_t scroll_h)
+{
+    return sink_report(hid, buttons, dx, dy, scroll_v, scroll_h);
+}
+
+bool app_hid_trackpad_ready(app_hid_t *hid)
+{
+    return hid && sink_ready();
+}
+
+uint32_t app_hid_trackpad_set_quiet(app_hid_t *hid, bool quiet)
+{
+    (void)hid;
+    uint32_t held = s_quiet ? s_quiet_busy : 0;
+    s_quiet = quiet;
+    s_quiet_busy = 0;
+    return held;
+}
@@ -0,0 +1,300 @@
+/**
+ * @file app_host_display.c
+ * @brief Secondary-display mode ("display host" command)
+ *
+ * Session (host lines are text, rectangles are binary):
+ *
+ *   host:   display host [idle_timeout_s]
+ *   device: display ready <w> <h>
+ *   host:   rectangle                           (repeated, see rect_stream.h)
+ *   device: display ack <frame> <decode_us>     (after each PRESENT rectangle)
+ *   host:   END rectangle
+ *   device: display done frames=.. rects=.. bytes=.. decode_us=..  |  display err <reason>
+ *
+ * RGB panels decode straight into the scanned-out framebuffer (no copy;
+ * updates can tear, which is fine for status screens). SPI and LovyanGFX
+ * panels decode into one of two DMA strip buffers while the other is on the
+ * bus.
+ */
+
+#include "app_host_display.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_lvgl_port.h"
+#include "sdkconfig.h"
+
+#if CONFIG_APP_DISPLAY_RGB_PARALLEL
+    #include "esp_lcd_panel_rgb.h"
+    #include "esp_cache.h"
+#endif
+
+#include "app_console.h"
+#include "app_lvgl.h"
+#include "rect_stream.h"
+
+#if CONFIG_APP_DISPLAY_LGFX
+extern void *app_display_get_lgfx(void);
+extern void lgfx_push_pixels(void *lgfx, int x1, int y1, int x2, int y2, const uint8_t *data);
+#endif
+
+static const char *TAG = "app_host_display";
+
+#define HOST_CHUNK_LEN        4096
+#define HOST_STRIP_PX         (CONFIG_APP_LCD_HRES * 16)
+#define HOST_READ_TIMEOUT_MS  2000
+#define HOST_IDLE_TIMEOUT_S   30
+
+static app_host_display_cfg_t s_cfg;
+static uint8_t *s_chunk = NULL;
+
+// Where decoded rows go for the rectangle being received
+typedef struct {
+    const rect_hdr_t *hdr;
+#if CONFIG_APP_DISPLAY_RGB_PARALLEL
+    uint16_t *fb;
+#else
+    uint16_t *strip[2];
+    uint8_t cur;
+    uint16_t lines;         // Rows per strip for this rectangle's width
+    uint16_t first;         // First rectangle row held in the current strip
+#endif
+} sink_t;
+
+#if !CONFIG_APP_DISPLAY_RGB_PARALLEL
+// Allocated on first use and kept: the last strip may still be on the bus
+// when a session ends
+static uint16_t *s_strip[2];
+#endif
+
+// ========================== Pixel sink ==========================
+
+#if CONFIG_APP_DISPLAY_RGB_PARALLEL
+
+static uint16_t *sink_row(void *ctx, uint16_t row)
+{
+    sink_t *s = (sink_t *)ctx;
+    return s->fb + (size_t)(s->hdr->y + row) * CONFIG_APP_LCD_HRES + s->hdr->x;
+}
+
+static void sink_done(sink_t *s)
+{
+    // The bounce buffers read the framebuffer through the cache, but write
+    // back anyway so direct-DMA (no bounce buffer) configurations see it too
+    const rect_hdr_t *h = s->hdr;
+    uint16_t *start = s->fb + (size_t)h->y * CONFIG_APP_LCD_HRES + h->x;
+    size_t len = ((size_t)(h->h - 1) * CONFIG_APP_LCD_HRES + h->w) * sizeof(uint16_t);
+    esp_cache_msync(start, len, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+}
+
+#else
+
+static void sink_blit(sink_t *s, uint16_t rows)
+{
+    const rect_hdr_t *h = s->hdr;
+    uint16_t *buf = s->strip[s->cur];
+    int x1 = h->x;
+    int y1 = h->y + s->first;
+#if CONFIG_APP_DISPLAY_LGFX
+    lgfx_push_pixels(app_display_get_lgfx(), x1, y1, x1 + h->w, y1 + rows, (const uint8_t *)buf);
+#else
+#ifdef CONFIG_APP_LCD_SWAP_BYTES
+    lv_draw_sw_rgb565_swap(buf, (uint32_t)h->w * rows);
+#endif
+    // Queued on the SPI bus; the next draw_bitmap waits for it before
+    // sending its window, so the other strip is free by the time it is reused
+    esp_lcd_panel_draw_bitmap(s_cfg.panel, x1, y1, x1 + h->w, y1 + rows, buf);
+#endif
+}
+
+static uint16_t *sink_row(void *ctx, uint16_t row)
+{
+    sink_t *s = (sink_t *)ctx;
+    if (row - s->first == s->lines) {
+        sink_blit(s, s->lines);
+        s->cur ^= 1;
+        s->first = row;
+    }
+    return s->strip[s->cur] + (size_t)(row - s->first) * s->hdr->w;
+}
+
+static void sink_done(sink_t *s)
+{
+    sink_blit(s, s->hdr->h - s->first);
+    s->cur ^= 1;
+}
+
+#endif
+
+static void sink_init(sink_t *s, const rect_hdr_t *hdr)
+{
+    s->hdr = hdr;
+#if !CONFIG_APP_DISPLAY_RGB_PARALLEL
+    s->lines = HOST_STRIP_PX / hdr->w;
+    s->first = 0;
+#endif
+}
+
+// ========================== Session ==========================
+
+typedef struct {
+    uint32_t frames;
+    uint32_t rects;
+    uint64_t bytes;
+    uint64_t decode_us;
+    uint32_t frame_decode_us;
+} session_stats_t;
+
+// Receive and decode one rectangle's payload
+static const char *receive_rect(const rect_hdr_t *hdr, sink_t *sink, session_stats_t *st)
+{
+    rect_decoder_t dec;
+    sink_init(sink, hdr);
+    rect_decoder_init(&dec, hdr, sink_row, sink);
+
+    uint32_t remaining = hdr->payload_len;
+    while (remaining) {
+        size_t want = remaining < HOST_CHUNK_LEN ? remaining : HOST_CHUNK_LEN;
+        if (app_console_read(s_chunk, want, HOST_READ_TIMEOUT_MS) != want) {
+            return "timeout";
+        }
+        int64_t t0 = esp_timer_get_time();
+        rect_stream_err_t err = rect_decoder_feed(&dec, s_chunk, want);
+        st->frame_decode_us += (uint32_t)(esp_timer_get_time() - t0);
+        if (err != RECT_STREAM_OK) {
+            return rect_stream_err_str(err);
+        }
+        remaining -= want;
+    }
+
+    rect_stream_err_t err = rect_decoder_finish(&dec);
+    if (err != RECT_STREAM_OK) {
+        return rect_stream_err_str(err);
+    }
+    int64_t t0 = esp_timer_get_time();
+    sink_done(sink);
+    st->frame_decode_us += (uint32_t)(esp_timer_get_time() - t0);
+    st->bytes += hdr->payload_len;
+    return NULL;
+}
+
+// Receive rectangles until END; returns NULL on success or an error reason
+static const char *run_session(uint32_t idle_timeout_s, session_stats_t *st)
+{
+    sink_t sink = {0};
+#if CONFIG_APP_DISPLAY_RGB_PARALLEL
+    void *fb = NULL;
+    if (esp_lcd_rgb_panel_get_frame_buffer(s_cfg.panel, 1, &fb) != ESP_OK || !fb) {
+        return "no_framebuffer";
+    }
+    sink.fb = (uint16_t *)fb;
+#else
+    for (int i = 0; i < 2; i++) {
+        if (!s_strip[i]) {
+            s_strip[i] = heap_caps_malloc(HOST_STRIP_PX * sizeof(uint16_t), MALLOC_CAP_DMA);
+        }
+        if (!s_strip[i]) {
+            return "no_mem";
+        }
+        sink.strip[i] = s_strip[i];
+    }
+#endif
+
+    while (true) {
+        uint8_t buf[RECT_HDR_LEN];
+        if (app_console_read(buf, sizeof(buf), idle_timeout_s * 1000) != sizeof(buf)) {
+            return "idle_timeout";
+        }
+
+        rect_hdr_t hdr;
+        rect_stream_err_t err = rect_parse_hdr(buf, &hdr);
+        if (err != RECT_STREAM_OK) {
+            return rect_stream_err_str(err);
+        }
+        if (hdr.flags & RECT_FLAG_END) {
+            return NULL;
+        }
+
+        if (hdr.w && hdr.h) {
+            if ((uint32_t)hdr.x + hdr.w > CONFIG_APP_LCD_HRES || (uint32_t)hdr.y + hdr.h > CONFIG_APP_LCD_VRES) {
+                return "out_of_bounds";
+            }
+            const char *fail = receive_rect(&hdr, &sink, st);
+            if (fail) {
+                return fail;
+            }
+            st->rects++;
+        }
+
+        if (hdr.flags & RECT_FLAG_PRESENT) {
+            st->frames++;
+            st->decode_us += st->frame_decode_us;
+            app_console_printf("display ack %u %u\r\n", (unsigned)st->frames, (unsigned)st->frame_decode_us);
+            st->frame_decode_us = 0;
+        }
+    }
+}
+
+static int cmd_display(int argc, char **argv)
+{
+    if (argc < 2 || strcmp(argv[1], "host") != 0) {
+        app_console_printf("usage: display host [idle_timeout_s]  (use tools/display_push.py)\r\n");
+        return 1;
+    }
+    uint32_t idle_timeout_s = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : HOST_IDLE_TIMEOUT_S;
+    if (idle_timeout_s == 0) {
+        idle_timeout_s = HOST_IDLE_TIMEOUT_S;
+    }
+
+    // Stop the LVGL task from refreshing, then take and drop the lock so a
+    // refresh that was already running has finished with the panel
+    lvgl_port_stop();
+    if (app_lvgl_lock(0)) {
+        app_lvgl_unlock();
+    }
+
+    ESP_LOGI(TAG, "Host display session (idle timeout %us)", (unsigned)idle_timeout_s);
+    app_console_printf("display ready %d %d\r\n", CONFIG_APP_LCD_HRES, CONFIG_APP_LCD_VRES);
+
+    session_stats_t st = {0};
+    const char *fail = run_session(idle_timeout_s, &st);
+
+    // Hand the panel back: LVGL repaints everything it owns
+    if (app_lvgl_lock(0)) {
+        lv_obj_invalidate(lv_display_get_screen_active(s_cfg.disp));
+        app_lvgl_unlock();
+    }
+    lvgl_port_resume();
+
+    if (fail) {
+        app_console_printf("display err %s\r\n", fail);
+        return 1;
+    }
+    app_console_printf("display done frames=%u rects=%u bytes=%llu decode_us=%llu\r\n",
+                       (unsigned)st.frames, (unsigned)st.rects,
+                       (unsigned long long)st.bytes, (unsigned long long)st.decode_us);
+    return 0;
+}
+
+static const app_console_cmd_t s_cmd_display = {
+    "display", "display host (stream images from the PC)", cmd_display,
+};
+
+esp_err_t app_host_display_init(const app_host_display_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(cfg && cfg->panel && cfg->disp, ESP_ERR_INVALID_ARG, TAG, "bad args");
+    ESP_RETURN_ON_FALSE(s_chunk == NULL, ESP_ERR_INVALID_STATE, TAG, "already initialized");
+    s_cfg = *cfg;
+
+    s_chunk = heap_caps_malloc(HOST_CHUNK_LEN, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(s_chunk, ESP_ERR_NO_MEM, TAG, "chunk buffer");
+
+    return app_console_register(&s_cmd_display);
+}
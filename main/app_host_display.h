@@ -0,0 +1,38 @@
+/**
+ * @file app_host_display.h
+ * @brief Secondary-display mode: the host streams rectangles to the panel
+ *
+ * "display host" on the console pauses LVGL and hands the panel to the host,
+ * which sends RLE565/raw rectangles (rect_stream.h) until it ends the
+ * session; LVGL then resumes and repaints. Use tools/display_push.py.
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "esp_lcd_panel_ops.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Display handles
+ */
+typedef struct {
+    esp_lcd_panel_handle_t panel;
+    lv_display_t *disp;             // Repainted when the session ends
+} app_host_display_cfg_t;
+
+/**
+ * @brief Register the "display" console command
+ *
+ * @param cfg Handles (copied)
+ * @return ESP_OK on success
+ */
+esp_err_t app_host_display_init(const app_host_display_cfg_t *cfg);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,165 @@
+/**
+ * @file app_lvbench.c
+ * @brief Structured capture of lv_demo_benchmark() results
+ */
+
+#include "app_lvbench.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+#include "app_console.h"
+#include "app_lvgl.h"
+#if CONFIG_APP_SYSMON_ENABLE
+    #include "app_sysmon.h"
+#endif
+
+static const char *TAG = "app_lvbench";
+
+#define WINDOW_MS       1000
+#define DONE_QUIET_US   (500 * 1000)    // No new row for this long = table complete
+#define ROW_FIELDS      6               // name, cpu %, fps, time, render, flush
+
+static TaskHandle_t s_task;
+static volatile uint32_t s_rows;
+static volatile int64_t s_last_row_us;
+
+// ========================== LVGL log capture ==========================
+
+// "Multiple rectangles, 41%, 30, 12, 9, 3" -> one "lvbench scene" line.
+// Returns false for anything else (header, other log messages).
+static bool parse_row(const char *msg)
+{
+    char buf[128];
+    strlcpy(buf, msg, sizeof(buf));
+
+    char *field[ROW_FIELDS];
+    char *save = NULL;
+    int n = 0;
+    for (char *tok = strtok_r(buf, ",", &save); tok && n < ROW_FIELDS + 1; tok = strtok_r(NULL, ",", &save)) {
+        while (isspace((unsigned char)*tok)) tok++;
+        char *end = tok + strlen(tok);
+        while (end > tok && isspace((unsigned char)end[-1])) *--end = '\0';
+        if (n < ROW_FIELDS) field[n] = tok;
+        n++;
+    }
+    if (n != ROW_FIELDS || field[0][0] == '\0') return false;
+
+    long v[ROW_FIELDS - 1];
+    for (int i = 1; i < ROW_FIELDS; i++) {
+        char *end;
+        v[i - 1] = strtol(field[i], &end, 10);
+        if (end == field[i] || (*end != '\0' && strcmp(end, "%") != 0)) return false;
+    }
+
+    // Keep the line key=value parseable
+    for (char *c = field[0]; *c; c++) {
+        if (isspace((unsigned char)*c) || *c == '=') *c = '_';
+    }
+    app_console_printf("lvbench scene name=%s cpu=%ld fps=%ld time_ms=%ld render_ms=%ld flush_ms=%ld\r\n",
+                       field[0], v[0], v[1], v[2], v[3], v[4]);
+    return true;
+}
+
+// Replaces LVGL's print callback; runs wherever LV_LOG was called
+static void log_cb(lv_log_level_t level, const char *buf)
+{
+    if (parse_row(buf)) {
+        s_rows++;
+        s_last_row_us = esp_timer_get_time();
+        return;
+    }
+
+    char msg[160];
+    strlcpy(msg, buf, sizeof(msg));
+    size_t len = strlen(msg);
+    while (len && (msg[len - 1] == '\n' || msg[len - 1] == '\r')) msg[--len] = '\0';
+    if (len == 0) return;
+
+    switch (level) {
+    case LV_LOG_LEVEL_ERROR: ESP_LOGE("lvgl", "%s", msg); break;
+    case LV_LOG_LEVEL_WARN:  ESP_LOGW("lvgl", "%s", msg); break;
+    default:                 ESP_LOGI("lvgl", "%s", msg); break;
+    }
+}
+
+// ========================== 1 s windows ==========================
+
+static void window_task(void *arg)
+{
+    app_lvgl_stats_t prev = {0}, cur;
+    if (app_lvgl_lock(0)) {
+        app_lvgl_get_stats(&prev);
+        app_lvgl_unlock();
+    }
+
+    TickType_t last_wake = xTaskGetTickCount();
+    int64_t t0 = esp_timer_get_time();
+    int64_t prev_us = t0;
+    while (true) {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(WINDOW_MS));
+
+        // The LVGL task is only held for the copy; printing happens outside the lock
+        if (!app_lvgl_lock(WINDOW_MS)) continue;
+        app_lvgl_get_stats(&cur);
+        app_lvgl_unlock();
+        int64_t now_us = esp_timer_get_time();
+        double window_s = (now_us - prev_us) / 1e6;
+        prev_us = now_us;
+
+        uint32_t frames = cur.frame_count - prev.frame_count;
+        uint32_t refr = cur.refr_count - prev.refr_count;
+        uint64_t refr_us = cur.refr_us - prev.refr_us;
+        uint64_t flush_us = cur.flush_us - prev.flush_us;
+        prev = cur;
+
+        char cpu[64] = "";
+#if CONFIG_APP_SYSMON_ENABLE
+        app_sysmon_load_t l;
+        app_sysmon_get(&l);
+        size_t len = 0;
+        for (int c = 0; c < l.cores && len < sizeof(cpu); c++) {
+            len += snprintf(cpu + len, sizeof(cpu) - len, " cpu%d=%.1f", c, l.core[c]);
+        }
+#endif
+        app_console_printf("lvbench window t_ms=%lld frames=%u fps=%.1f refr_us_avg=%.0f render_us_avg=%.0f flush_us_avg=%.0f%s\r\n",
+                           (long long)((now_us - t0) / 1000), (unsigned)frames,
+                           window_s > 0 ? frames / window_s : 0.0,
+                           refr ? (double)refr_us / refr : 0.0,
+                           refr && refr_us > flush_us ? (double)(refr_us - flush_us) / refr : 0.0,
+                           refr ? (double)flush_us / refr : 0.0, cpu);
+
+        if (s_rows && esp_timer_get_time() - s_last_row_us > DONE_QUIET_US) {
+            app_console_printf("lvbench done scenes=%u\r\n", (unsigned)s_rows);
+            ESP_LOGI(TAG, "Benchmark capture complete (%u scenes)", (unsigned)s_rows);
+            // Its lock waits stay in the trace ring; "trace dump" then lists
+            // this task as "(exited)"
+            s_task = NULL;
+            vTaskDelete(NULL);
+        }
+    }
+}
+
+esp_err_t app_lvbench_start(lv_display_t *disp)
+{
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "bad args");
+    ESP_RETURN_ON_FALSE(s_task == NULL, ESP_ERR_INVALID_STATE, TAG, "already running");
+
+    s_rows = 0;
+    lv_log_register_print_cb(log_cb);
+    app_console_printf("lvbench profile %s\r\n", app_console_profile());
+
+    // Below the LVGL task, so sampling never delays a frame
+    BaseType_t ok = xTaskCreate(window_task, "lvbench", 3072, NULL, 1, &s_task);
+    ESP_RETURN_ON_FALSE(ok == pdPASS, ESP_ERR_NO_MEM, TAG, "lvbench task");
+    return ESP_OK;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file app_lvbench.h
+ * @brief Structured capture of lv_demo_benchmark() results
+ *
+ * lv_demo_benchmark() shows its results on screen and logs the per-scene
+ * table (CSV) through LV_LOG. This module takes over LVGL's log output,
+ * turns those rows into console lines and adds one line per second of
+ * refresh timing from app_lvgl and CPU load from app_sysmon:
+ *
+ *   lvbench profile profile=... (app_console_profile())
+ *   lvbench window t_ms=.. frames=.. fps=.. refr_us_avg=.. render_us_avg=.. flush_us_avg=.. [cpu0=.. cpu1=..]
+ *   lvbench scene name=<Scene_name> cpu=.. fps=.. time_ms=.. render_ms=.. flush_ms=..
+ *   lvbench done scenes=..
+ *
+ * Other LVGL log messages go to ESP_LOG with tag "lvgl". Compare runs with
+ * tools/bench_report.py --lvbench.
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Start capturing (call right before lv_demo_benchmark())
+ *
+ * @param disp Display the benchmark runs on
+ * @return ESP_OK on success
+ */
+esp_err_t app_lvbench_start(lv_display_t *disp);
+
+#ifdef __cplusplus
+}
+#endif
@@ -5,10 +5,27 @@
 #include "esp_log.h"
 #include "esp_lvgl_port.h"
 #include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "app_tracer.h"
+#if CONFIG_APP_MIRROR_ENABLE
+    #include "app_mirror.h"
+#endif
+#if CONFIG_APP_LVGL_TOUCH_EVENT
+    #include "app_lvgl_touch.h"
+#endif
+#if CONFIG_APP_LVGL_LGFX_DRAW_UNIT
+    #include "app_lvgl_lgfx_draw.h"
+#endif
 
 #if CONFIG_APP_DISPLAY_LGFX
     // Forward declare LGFX accessor from app_display_lgfx.cpp
     extern void* app_display_get_lgfx(void);
+    #if CONFIG_APP_LGFX_RGB_DIRECT
+        #include "esp_cache.h"
+        extern void *lgfx_get_framebuffer(void *lgfx);
+    #endif
 
     #ifdef __cplusplus
     extern "C" {
@@ -22,6 +39,141 @@
 
 static const char *TAG = "app_lvgl";
 
+#if CONFIG_APP_LGFX_RGB_DIRECT
+// LVGL renders into the scanned-out framebuffer itself (LV_DISPLAY_RENDER_MODE_DIRECT)
+static bool s_direct_fb;
+#endif
+
+// ========================== Refresh statistics ==========================
+
+static app_lvgl_stats_t s_stats;
+static int64_t s_refr_t0;
+static int64_t s_flush_t0;
+static int64_t s_wait_t0;
+
+static void stats_event_cb(lv_event_t *e)
+{
+    int64_t now = esp_timer_get_time();
+
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_REFR_START:
+            APP_TRACE_BEGIN("lv_refr");
+            s_refr_t0 = now;
+            break;
+        case LV_EVENT_REFR_READY: {
+            APP_TRACE_END("lv_refr");
+            uint32_t dt = (uint32_t)(now - s_refr_t0);
+            s_stats.refr_count++;
+            s_stats.refr_us += dt;
+            if (dt > s_stats.refr_max_us) s_stats.refr_max_us = dt;
+            break;
+        }
+        case LV_EVENT_FLUSH_START: {
+            const lv_area_t *area = (const lv_area_t *)lv_event_get_param(e);
+            if (area) {
+                s_stats.flush_px += lv_area_get_size(area);
+#if CONFIG_APP_MIRROR_ENABLE
+                // Sent before the flush callback runs, so the pixels are still
+                // native RGB565 even on backends that byte-swap in the callback
+                lv_draw_buf_t *buf = lv_display_get_buf_active((lv_display_t *)lv_event_get_current_target(e));
+                if (buf) {
+                    const uint8_t *px = buf->data;
+#if CONFIG_APP_LGFX_RGB_DIRECT
+                    // Direct mode hands over the whole screen, not an area-sized buffer
+                    if (s_direct_fb) px += area->y1 * buf->header.stride + area->x1 * 2;
+#endif
+                    app_mirror_capture(area, px, buf->header.stride);
+                }
+#endif
+            }
+            s_flush_t0 = now;
+            APP_TRACE_BEGIN("lv_flush");
+            break;
+        }
+        case LV_EVENT_FLUSH_FINISH: {
+            APP_TRACE_END("lv_flush");
+            uint32_t dt = (uint32_t)(now - s_flush_t0);
+            s_stats.flush_count++;
+            s_stats.flush_us += dt;
+            if (dt > s_stats.flush_max_us) s_stats.flush_max_us = dt;
+            if (lv_display_flush_is_last((lv_display_t *)lv_event_get_current_target(e))) {
+                s_stats.frame_count++;
+            }
+            break;
+        }
+        case LV_EVENT_RENDER_START:
+            APP_TRACE_BEGIN("lv_render");
+            break;
+        case LV_EVENT_RENDER_READY:
+            APP_TRACE_END("lv_render");
+            break;
+        case LV_EVENT_FLUSH_WAIT_START:
+            APP_TRACE_BEGIN("lv_flush_wait");
+            s_wait_t0 = now;
+            break;
+        case LV_EVENT_FLUSH_WAIT_FINISH:
+            APP_TRACE_END("lv_flush_wait");
+            s_stats.flush_us += (uint32_t)(now - s_wait_t0);
+            break;
+        default:
+            break;
+    }
+}
+
+bool app_lvgl_lock(uint32_t timeout_ms)
+{
+    APP_TRACE_BEGIN("lvgl_lock_wait");
+    bool ok = lvgl_port_lock(timeout_ms);
+    APP_TRACE_END("lvgl_lock_wait");
+    if (ok) {
+        APP_TRACE_BEGIN("lvgl_lock_held");
+    }
+    return ok;
+}
+
+void app_lvgl_unlock(void)
+{
+    APP_TRACE_END("lvgl_lock_held");
+    lvgl_port_unlock();
+}
+
+void app_lvgl_wake(void)
+{
+    lvgl_port_task_wake(LVGL_PORT_EVENT_USER, NULL);
+}
+
+// ========================== Event-driven wakeups ==========================
+
+#if CONFIG_APP_LVGL_EVENT_DRIVEN
+// esp_lvgl_port has no getter for its task; it creates it under this name
+// in lvgl_port_init()
+#define LVGL_PORT_TASK_NAME "taskLVGL"
+
+static TaskHandle_t s_lvgl_task;
+
+// Invalidations from the LVGL task itself are picked up by the refresh timer
+// it is about to run; ones from other tasks (under the lock) must wake it,
+// or they would wait for whatever LVGL timer happens to be due next.
+static void wake_event_cb(lv_event_t *e)
+{
+    if (xTaskGetCurrentTaskHandle() != s_lvgl_task) {
+        lvgl_port_task_wake(LVGL_PORT_EVENT_DISPLAY, NULL);
+    }
+}
+#endif
+
+void app_lvgl_get_stats(app_lvgl_stats_t *out)
+{
+    if (out) *out = s_stats;
+}
+
+void app_lvgl_reset_stats(void)
+{
+    s_stats = (app_lvgl_stats_t){0};
+}
+
+// ========================== Flush callbacks ==========================
+
 // Flush callback for RGB panels
 static void rgb_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
 {
@@ -56,10 +208,81 @@ static void lgfx_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px
     int x2 = area->x2 + 1;
     int y2 = area->y2 + 1;
 
+#if CONFIG_APP_LVGL_LGFX_DRAW_UNIT
+    // Area rendered as one solid fill: send the color, not the pixels
+    extern void lgfx_fill_rect(void *lgfx, int x, int y, int w, int h, uint16_t color);
+    uint16_t color;
+    if (app_lvgl_lgfx_draw_take_solid(area, &color)) {
+        lgfx_fill_rect(lgfx, x1, y1, x2 - x1, y2 - y1, color);
+        lv_display_flush_ready(disp);
+        return;
+    }
+#endif
+
     lgfx_push_pixels(lgfx, x1, y1, x2, y2, px_map);
 
     lv_display_flush_ready(disp);
 }
+
+#if CONFIG_APP_LGFX_RGB_DIRECT
+// Direct-mode flush: LVGL already drew into the framebuffer, so only the
+// dirty rows have to be written back from the cache for the scanout DMA
+static void lgfx_direct_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    const size_t stride = CONFIG_APP_LCD_HRES * 2;
+    uint8_t *start = px_map + area->y1 * stride + area->x1 * 2;
+    size_t len = (size_t)(area->y2 - area->y1) * stride + (size_t)lv_area_get_width(area) * 2;
+
+    esp_cache_msync(start, len, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+    lv_display_flush_ready(disp);
+}
+
+// Render straight into Panel_RGB's framebuffer: no draw buffers and no
+// per-flush copy. Returns false if LGFX can't share its framebuffer
+// (rotation, color depth, byte order); the caller then uses draw buffers.
+static bool lgfx_use_framebuffer(lv_display_t *lv_disp)
+{
+    void *fb = lgfx_get_framebuffer(lv_display_get_user_data(lv_disp));
+    if (!fb) {
+        ESP_LOGW(TAG, "LGFX framebuffer not shareable; using partial draw buffers");
+        return false;
+    }
+
+    size_t fb_size = CONFIG_APP_LCD_HRES * CONFIG_APP_LCD_VRES * 2;
+    lv_display_set_buffers(lv_disp, fb, NULL, fb_size, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(lv_disp, lgfx_direct_flush_cb);
+    s_direct_fb = true;
+
+    ESP_LOGI(TAG, "LVGL ready (LGFX, direct into %d KB framebuffer)", (int)(fb_size / 1024));
+    return true;
+}
+#endif
+
+// Partial-mode draw buffers, pushed to the panel by lgfx_flush_cb
+static esp_err_t lgfx_set_draw_buffers(lv_display_t *lv_disp)
+{
+    // Allocate buffers (use PSRAM for large displays)
+    size_t buf_size = CONFIG_APP_LCD_HRES * CONFIG_APP_LVGL_BUF_LINES * 2;
+    uint32_t caps = (CONFIG_APP_LCD_HRES >= 800) ? MALLOC_CAP_SPIRAM : MALLOC_CAP_DMA;
+
+    void *buf1 = heap_caps_malloc(buf_size, caps);
+    ESP_RETURN_ON_FALSE(buf1, ESP_ERR_NO_MEM, TAG, "Buffer 1 alloc failed");
+
+    void *buf2 = NULL;
+#ifdef CONFIG_APP_LVGL_DOUBLE_BUFFER
+    buf2 = heap_caps_malloc(buf_size, caps);
+    if (!buf2) {
+        free(buf1);
+        ESP_RETURN_ON_ERROR(ESP_ERR_NO_MEM, TAG, "Buffer 2 alloc failed");
+    }
+#endif
+
+    lv_display_set_buffers(lv_disp, buf1, buf2, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(lv_disp, lgfx_flush_cb);
+
+    ESP_LOGI(TAG, "LVGL ready (LGFX, %d KB%s)", (int)(buf_size/1024), buf2 ? " x2" : "");
+    return ESP_OK;
+}
 #endif
 
 esp_err_t app_lvgl_init_and_add(const esp_lcd_panel_handle_t panel,
@@ -70,8 +293,20 @@ esp_err_t app_lvgl_init_and_add(const esp_lcd_panel_handle_t panel,
     ESP_RETURN_ON_FALSE(panel && out, ESP_ERR_INVALID_ARG, TAG, "bad args");
 
     // Initialize LVGL port (task and timer management)
-    const lvgl_port_cfg_t lvgl_cfg = ESP_LVGL_PORT_INIT_CONFIG();
+    lvgl_port_cfg_t lvgl_cfg = ESP_LVGL_PORT_INIT_CONFIG();
+#if CONFIG_APP_LVGL_EVENT_DRIVEN
+    // The port task already sleeps for lv_timer_handler()'s return value;
+    // lifting the cap lets it sleep through idle periods entirely
+    lvgl_cfg.task_max_sleep_ms = CONFIG_APP_LVGL_MAX_SLEEP_MS;
+#endif
     ESP_RETURN_ON_ERROR(lvgl_port_init(&lvgl_cfg), TAG, "lvgl_port_init");
+#if CONFIG_APP_LVGL_EVENT_DRIVEN
+    // Not found: every invalidation wakes the task, including its own
+    s_lvgl_task = xTaskGetHandle(LVGL_PORT_TASK_NAME);
+    if (!s_lvgl_task) {
+        ESP_LOGW(TAG, "LVGL port task '%s' not found", LVGL_PORT_TASK_NAME);
+    }
+#endif
 
     lv_disp_t *disp = NULL;
 
@@ -92,28 +327,17 @@ esp_err_t app_lvgl_init_and_add(const esp_lcd_panel_handle_t panel,
         // Set color format
         lv_display_set_color_format(lv_disp, LV_COLOR_FORMAT_RGB565);
 
-        // Allocate buffers (use PSRAM for large displays)
-        size_t buf_size = CONFIG_APP_LCD_HRES * CONFIG_APP_LVGL_BUF_LINES * 2;
-        uint32_t caps = (CONFIG_APP_LCD_HRES >= 800) ? MALLOC_CAP_SPIRAM : MALLOC_CAP_DMA;
-
-        void *buf1 = heap_caps_malloc(buf_size, caps);
-        if (!buf1) {
-            lvgl_port_unlock();
-            ESP_RETURN_ON_ERROR(ESP_ERR_NO_MEM, TAG, "Buffer 1 alloc failed");
-        }
-
-        void *buf2 = NULL;
-#ifdef CONFIG_APP_LVGL_DOUBLE_BUFFER
-        buf2 = heap_caps_malloc(buf_size, caps);
-        if (!buf2) {
-            free(buf1);
-            lvgl_port_unlock();
-            ESP_RETURN_ON_ERROR(ESP_ERR_NO_MEM, TAG, "Buffer 2 alloc failed");
-        }
+        bool direct = false;
+#if CONFIG_APP_LGFX_RGB_DIRECT
+        direct = lgfx_use_framebuffer(lv_disp);
 #endif
-
-        lv_display_set_buffers(lv_disp, buf1, buf2, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
-        lv_display_set_flush_cb(lv_disp, lgfx_flush_cb);
+        if (!direct) {
+            esp_err_t err = lgfx_set_draw_buffers(lv_disp);
+            if (err != ESP_OK) {
+                lvgl_port_unlock();
+                return err;
+            }
+        }
 
         // Apply rotation settings
         if (CONFIG_APP_ROT_SWAP_XY || CONFIG_APP_ROT_MIRROR_X || CONFIG_APP_ROT_MIRROR_Y) {
@@ -125,10 +349,14 @@ esp_err_t app_lvgl_init_and_add(const esp_lcd_panel_handle_t panel,
         // Make this the default display
         lv_display_set_default(lv_disp);
 
+#if CONFIG_APP_LVGL_LGFX_DRAW_UNIT
+        // Not fatal: LVGL's software renderer draws everything without it
+        app_lvgl_lgfx_draw_init();
+#endif
+
         lvgl_port_unlock();
 
         disp = lv_disp;
-        ESP_LOGI(TAG, "LVGL ready (LGFX, %d KB%s)", (int)(buf_size/1024), buf2 ? " x2" : "");
     }
 #else
     if (io == NULL) {
@@ -147,9 +375,12 @@ esp_err_t app_lvgl_init_and_add(const esp_lcd_panel_handle_t panel,
         // Set color format
         lv_display_set_color_format(lv_disp, LV_COLOR_FORMAT_RGB565);
 
-        // Allocate buffers in PSRAM (RGB565 = 2 bytes/pixel)
+        // Allocate buffers in PSRAM (RGB565 = 2 bytes/pixel); internal RAM
+        // for builds without it (virtual panel under QEMU)
         size_t buf_size = CONFIG_APP_LCD_HRES * CONFIG_APP_LVGL_BUF_LINES * 2;
-        void *buf1 = heap_caps_malloc(buf_size, MALLOC_CAP_SPIRAM);
+        uint32_t caps = heap_caps_get_total_size(MALLOC_CAP_SPIRAM) ? MALLOC_CAP_SPIRAM
+                                                                    : MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+        void *buf1 = heap_caps_malloc(buf_size, caps);
         if (!buf1) {
             lvgl_port_unlock();
             ESP_RETURN_ON_ERROR(ESP_ERR_NO_MEM, TAG, "Buffer 1 alloc failed");
@@ -157,7 +388,7 @@ esp_err_t app_lvgl_init_and_add(const esp_lcd_panel_handle_t panel,
 
         void *buf2 = NULL;
 #ifdef CONFIG_APP_LVGL_DOUBLE_BUFFER
-        buf2 = heap_caps_malloc(buf_size, MALLOC_CAP_SPIRAM);
+        buf2 = heap_caps_malloc(buf_size, caps);
         if (!buf2) {
             free(buf1);
             lvgl_port_unlock();
@@ -221,14 +452,25 @@ esp_err_t app_lvgl_init_and_add(const esp_lcd_panel_handle_t panel,
     }
 #endif  // !CONFIG_APP_DISPLAY_LGFX
 
+    lvgl_port_lock(0);
+    lv_display_add_event_cb(disp, stats_event_cb, LV_EVENT_ALL, NULL);
+#if CONFIG_APP_LVGL_EVENT_DRIVEN
+    lv_display_add_event_cb(disp, wake_event_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+#endif
+    lvgl_port_unlock();
+
     // Add touch (works for all)
     lv_indev_t *indev = NULL;
     if (tp_or_null) {
+#if CONFIG_APP_LVGL_TOUCH_EVENT
+        indev = app_lvgl_touch_add(disp, tp_or_null);
+#else
         const lvgl_port_touch_cfg_t touch_cfg = {
             .disp = disp,
             .handle = tp_or_null,
         };
         indev = lvgl_port_add_touch(&touch_cfg);
+#endif
     }
 
     out->disp = disp;
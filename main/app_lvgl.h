@@ -14,11 +14,62 @@ typedef struct {
     lv_indev_t *indev;  // can be NULL if touch missing
 } app_lvgl_handles_t;
 
+/**
+ * @brief Display refresh timing, accumulated from LVGL display events
+ *
+ * Updated from the LVGL task; read/reset with the LVGL lock held.
+ * flush_us covers time inside the flush callback plus time LVGL spent
+ * blocked waiting for a previous flush, so render time ~= refr_us - flush_us.
+ */
+typedef struct {
+    uint32_t refr_count;    // Refresh cycles (including ones with nothing to draw)
+    uint32_t frame_count;   // Refreshes that flushed at least one area
+    uint32_t flush_count;   // Flushed areas
+    uint64_t refr_us;
+    uint32_t refr_max_us;
+    uint64_t flush_us;
+    uint32_t flush_max_us;
+    uint64_t flush_px;      // Pixels handed to the flush callback
+} app_lvgl_stats_t;
+
 esp_err_t app_lvgl_init_and_add(const esp_lcd_panel_handle_t panel,
                                 const esp_lcd_panel_io_handle_t io,
                                 esp_lcd_touch_handle_t tp_or_null,
                                 app_lvgl_handles_t *out);
 
+/**
+ * @brief lvgl_port_lock()/unlock() for application tasks
+ *
+ * Same semantics as the esp_lvgl_port calls; additionally records lock
+ * wait/hold spans in the event tracer so contention with the LVGL task
+ * shows up on the timeline.
+ *
+ * @param timeout_ms Timeout in ms (0 = wait forever)
+ * @return true if the lock was taken
+ */
+bool app_lvgl_lock(uint32_t timeout_ms);
+void app_lvgl_unlock(void);
+
+/**
+ * @brief Wake the LVGL task now
+ *
+ * For work posted to LVGL from other tasks that does not invalidate the
+ * screen by itself (e.g. lv_async_call()). Invalidations made under
+ * app_lvgl_lock() already wake it when APP_LVGL_EVENT_DRIVEN is set.
+ * Safe to call from any task; not from ISRs.
+ */
+void app_lvgl_wake(void);
+
+/**
+ * @brief Copy the accumulated refresh statistics
+ */
+void app_lvgl_get_stats(app_lvgl_stats_t *out);
+
+/**
+ * @brief Clear the accumulated refresh statistics
+ */
+void app_lvgl_reset_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
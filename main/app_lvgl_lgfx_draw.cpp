@@ -0,0 +1,269 @@
+/**
+ * @file app_lvgl_lgfx_draw.cpp
+ * @brief LVGL draw unit backed by LovyanGFX primitives
+ */
+
+#include "app_lvgl_lgfx_draw.h"
+
+#include "sdkconfig.h"
+#include "esp_log.h"
+
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+
+// Draw unit and draw task internals
+#include "src/draw/lv_draw_private.h"
+
+static const char *TAG = "app_lvgl_lgfx_draw";
+
+#define LGFX_DRAW_UNIT_ID       50
+#define LGFX_DRAW_PREFERENCE    80      // Software renderer scores 100; lower wins
+
+typedef enum {
+    SOLID_EMPTY,        // No task on the area yet
+    SOLID_FILL,         // One opaque fill covers the whole area, nothing else
+    SOLID_MIXED,        // Anything else
+} solid_state_t;
+
+static bool s_enabled;
+static app_lvgl_lgfx_draw_stats_t s_stats;
+
+// Tracked for the display's own layer (the buffer that gets flushed)
+static struct {
+    lv_area_t area;
+    solid_state_t state;
+    uint16_t color;
+} s_solid;
+
+// Bound over the target layer's draw buffer for each task; never owns memory
+static LGFX_Sprite s_sprite;
+
+// ========================== Task filters ==========================
+
+static bool fill_supported(const lv_draw_fill_dsc_t *dsc)
+{
+    return dsc->opa >= LV_OPA_MAX && dsc->radius == 0 && dsc->grad.dir == LV_GRAD_DIR_NONE;
+}
+
+static bool border_supported(const lv_draw_border_dsc_t *dsc)
+{
+    return dsc->opa >= LV_OPA_MAX && dsc->radius == 0 && dsc->width > 0;
+}
+
+static bool image_supported(const lv_draw_task_t *t, const lv_draw_image_dsc_t *dsc)
+{
+    if (dsc->opa < LV_OPA_MAX || dsc->recolor_opa > LV_OPA_MIN) return false;
+    if (dsc->rotation != 0 || dsc->scale_x != LV_SCALE_NONE || dsc->scale_y != LV_SCALE_NONE) return false;
+    if (dsc->skew_x != 0 || dsc->skew_y != 0 || dsc->clip_radius != 0) return false;
+    if (dsc->tile || dsc->bitmap_mask_src || dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+    if (lv_image_src_get_type(dsc->src) != LV_IMAGE_SRC_VARIABLE) return false;
+
+    // Plain RGB565 in RAM with packed rows, drawn at its own size
+    const lv_image_dsc_t *img = (const lv_image_dsc_t *)dsc->src;
+    return img->header.cf == LV_COLOR_FORMAT_RGB565 &&
+           img->header.stride == img->header.w * 2 &&
+           lv_area_get_width(&t->area) == img->header.w &&
+           lv_area_get_height(&t->area) == img->header.h;
+}
+
+static bool task_supported(const lv_draw_task_t *t)
+{
+    if (t->target_layer->color_format != LV_COLOR_FORMAT_RGB565) return false;
+
+    switch (t->type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+            return fill_supported((const lv_draw_fill_dsc_t *)t->draw_dsc);
+        case LV_DRAW_TASK_TYPE_BORDER:
+            return border_supported((const lv_draw_border_dsc_t *)t->draw_dsc);
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            return image_supported(t, (const lv_draw_image_dsc_t *)t->draw_dsc);
+        default:
+            return false;
+    }
+}
+
+// ========================== Solid area tracking ==========================
+
+static bool area_equal(const lv_area_t *a, const lv_area_t *b)
+{
+    return a->x1 == b->x1 && a->y1 == b->y1 && a->x2 == b->x2 && a->y2 == b->y2;
+}
+
+// Start over with the next task queued (the area can't match a layer)
+static void solid_reset(void)
+{
+    s_solid.area = {0, 0, -1, -1};
+    s_solid.state = SOLID_MIXED;
+}
+
+// Every task queued on the display layer passes through here in drawing
+// order, whichever unit ends up drawing it
+static void solid_track(const lv_draw_task_t *t)
+{
+    const lv_layer_t *layer = t->target_layer;
+
+    if (!area_equal(&s_solid.area, &layer->buf_area)) {
+        s_solid.area = layer->buf_area;
+        s_solid.state = SOLID_EMPTY;
+    }
+
+    if (s_solid.state == SOLID_EMPTY && t->type == LV_DRAW_TASK_TYPE_FILL &&
+        fill_supported((const lv_draw_fill_dsc_t *)t->draw_dsc) &&
+        lv_area_is_in(&s_solid.area, &t->area, 0) &&
+        lv_area_is_in(&s_solid.area, &t->clip_area, 0)) {
+        s_solid.state = SOLID_FILL;
+        s_solid.color = lv_color_to_u16(((const lv_draw_fill_dsc_t *)t->draw_dsc)->color);
+    } else {
+        s_solid.state = SOLID_MIXED;
+    }
+}
+
+bool app_lvgl_lgfx_draw_take_solid(const lv_area_t *area, uint16_t *color)
+{
+    bool solid = s_solid.state == SOLID_FILL && area_equal(&s_solid.area, area);
+    solid_reset();
+    if (!solid) return false;
+
+    *color = s_solid.color;
+    s_stats.solid_flushes++;
+    s_stats.solid_px += lv_area_get_size(area);
+    return true;
+}
+
+// ========================== Execution ==========================
+
+// Map the sprite over the layer's buffer and clip it to the task's area
+static void sprite_bind(lv_draw_task_t *t)
+{
+    lv_layer_t *layer = t->target_layer;
+    lv_draw_buf_t *buf = layer->draw_buf;
+
+    s_sprite.setBuffer(buf->data, buf->header.stride / 2, buf->header.h, lgfx::color_depth_t::rgb565_2Byte);
+    s_sprite.setClipRect(t->clip_area.x1 - layer->buf_area.x1, t->clip_area.y1 - layer->buf_area.y1,
+                         lv_area_get_width(&t->clip_area), lv_area_get_height(&t->clip_area));
+}
+
+// LVGL stores RGB565 little-endian; passing it as raw swap565_t makes LGFX
+// copy the bytes as they are instead of converting
+static lgfx::swap565_t raw565(lv_color_t c)
+{
+    lgfx::swap565_t px;
+    px.raw = lv_color_to_u16(c);
+    return px;
+}
+
+static void rect_fill(const lv_layer_t *layer, int32_t x1, int32_t y1, int32_t x2, int32_t y2, lgfx::swap565_t px)
+{
+    s_sprite.fillRect(x1 - layer->buf_area.x1, y1 - layer->buf_area.y1, x2 - x1 + 1, y2 - y1 + 1, px);
+}
+
+static void execute(lv_draw_task_t *t)
+{
+    const lv_layer_t *layer = t->target_layer;
+    const lv_area_t *a = &t->area;
+
+    sprite_bind(t);
+
+    switch (t->type) {
+        case LV_DRAW_TASK_TYPE_FILL: {
+            const lv_draw_fill_dsc_t *dsc = (const lv_draw_fill_dsc_t *)t->draw_dsc;
+            rect_fill(layer, a->x1, a->y1, a->x2, a->y2, raw565(dsc->color));
+            s_stats.fills++;
+            break;
+        }
+        case LV_DRAW_TASK_TYPE_BORDER: {
+            const lv_draw_border_dsc_t *dsc = (const lv_draw_border_dsc_t *)t->draw_dsc;
+            lgfx::swap565_t px = raw565(dsc->color);
+            int32_t w = dsc->width;
+            if (dsc->side & LV_BORDER_SIDE_TOP)    rect_fill(layer, a->x1, a->y1, a->x2, a->y1 + w - 1, px);
+            if (dsc->side & LV_BORDER_SIDE_BOTTOM) rect_fill(layer, a->x1, a->y2 - w + 1, a->x2, a->y2, px);
+            if (dsc->side & LV_BORDER_SIDE_LEFT)   rect_fill(layer, a->x1, a->y1, a->x1 + w - 1, a->y2, px);
+            if (dsc->side & LV_BORDER_SIDE_RIGHT)  rect_fill(layer, a->x2 - w + 1, a->y1, a->x2, a->y2, px);
+            s_stats.borders++;
+            break;
+        }
+        case LV_DRAW_TASK_TYPE_IMAGE: {
+            const lv_draw_image_dsc_t *dsc = (const lv_draw_image_dsc_t *)t->draw_dsc;
+            const lv_image_dsc_t *img = (const lv_image_dsc_t *)dsc->src;
+            // The sprite clips to the task's clip area, so the whole image is pushed
+            s_sprite.pushImage(a->x1 - layer->buf_area.x1, a->y1 - layer->buf_area.y1,
+                               img->header.w, img->header.h, (const lgfx::swap565_t *)img->data);
+            s_stats.images++;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// ========================== Draw unit callbacks ==========================
+
+static int32_t unit_evaluate(lv_draw_unit_t *draw_unit, lv_draw_task_t *t)
+{
+    (void)draw_unit;
+
+    if (s_enabled && t->target_layer->parent == NULL) solid_track(t);
+
+    if (s_enabled && t->preference_score > LGFX_DRAW_PREFERENCE && task_supported(t)) {
+        t->preference_score = LGFX_DRAW_PREFERENCE;
+        t->preferred_draw_unit_id = LGFX_DRAW_UNIT_ID;
+    }
+    return 0;
+}
+
+// Runs in the LVGL task and draws synchronously, one task per call.
+// Tasks assigned before the unit was disabled are still drawn here.
+static int32_t unit_dispatch(lv_draw_unit_t *draw_unit, lv_layer_t *layer)
+{
+    lv_draw_task_t *t = lv_draw_get_available_task(layer, NULL, LGFX_DRAW_UNIT_ID);
+    if (!t || t->preferred_draw_unit_id != LGFX_DRAW_UNIT_ID) return LV_DRAW_UNIT_IDLE;
+    if (!lv_draw_layer_alloc_buf(layer)) return LV_DRAW_UNIT_IDLE;
+
+    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    t->draw_unit = draw_unit;
+    execute(t);
+    t->state = LV_DRAW_TASK_STATE_FINISHED;
+
+    lv_draw_dispatch_request();
+    return 1;
+}
+
+// ========================== API ==========================
+
+esp_err_t app_lvgl_lgfx_draw_init(void)
+{
+    lv_draw_unit_t *unit = (lv_draw_unit_t *)lv_draw_create_unit(sizeof(lv_draw_unit_t));
+    if (!unit) {
+        ESP_LOGE(TAG, "lv_draw_create_unit failed");
+        return ESP_ERR_NO_MEM;
+    }
+    unit->name = "LGFX";
+    unit->evaluate_cb = unit_evaluate;
+    unit->dispatch_cb = unit_dispatch;
+
+    solid_reset();
+    s_enabled = true;
+    ESP_LOGI(TAG, "LGFX draw unit registered (fills, borders, RGB565 images)");
+    return ESP_OK;
+}
+
+void app_lvgl_lgfx_draw_set_enabled(bool enabled)
+{
+    s_enabled = enabled;
+    solid_reset();
+}
+
+bool app_lvgl_lgfx_draw_get_enabled(void)
+{
+    return s_enabled;
+}
+
+void app_lvgl_lgfx_draw_get_stats(app_lvgl_lgfx_draw_stats_t *out)
+{
+    if (out) *out = s_stats;
+}
+
+void app_lvgl_lgfx_draw_reset_stats(void)
+{
+    s_stats = {};
+}
@@ -0,0 +1,83 @@
+/**
+ * @file app_lvgl_lgfx_draw.h
+ * @brief LVGL draw unit backed by LovyanGFX primitives
+ *
+ * Takes the simple, opaque draw tasks off LVGL's software renderer:
+ * square solid fills, square borders and untransformed RGB565 images.
+ * They are executed with LGFX_Sprite fillRect()/pushImage() on the layer's
+ * draw buffer. Everything else (radius, gradients, alpha, text, transforms)
+ * stays with the software renderer.
+ *
+ * The unit also sees every task LVGL queues. When a flushed area was
+ * covered by a single solid fill and nothing else, lgfx_flush_cb() sends
+ * it as fillRect() on the panel. On SPI that is an address window plus a
+ * repeated-color DMA instead of pushing w*h pixels.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t fills;         // Fill tasks executed
+    uint32_t borders;       // Border tasks executed
+    uint32_t images;        // Image tasks executed
+    uint32_t solid_flushes; // Flushed areas sent as a panel fillRect()
+    uint64_t solid_px;      // Pixels in those areas
+} app_lvgl_lgfx_draw_stats_t;
+
+/**
+ * @brief Register the draw unit with LVGL
+ *
+ * Call once after lv_init(), with the LVGL lock held.
+ *
+ * @return ESP_OK, or ESP_ERR_NO_MEM
+ */
+esp_err_t app_lvgl_lgfx_draw_init(void);
+
+/**
+ * @brief Let the unit take new tasks (true) or leave all to software (false)
+ *
+ * Tasks already assigned to the unit are still drawn. Call with the LVGL
+ * lock held.
+ */
+void app_lvgl_lgfx_draw_set_enabled(bool enabled);
+
+/**
+ * @brief Whether the unit takes new tasks
+ */
+bool app_lvgl_lgfx_draw_get_enabled(void);
+
+/**
+ * @brief Check whether @p area was rendered as one solid fill only
+ *
+ * Called from the flush callback. Consumes the state, so each rendered
+ * area is checked once, and counts the area as a solid flush when true.
+ *
+ * @param area Area being flushed
+ * @param[out] color RGB565 fill color if true is returned
+ * @return true if the panel can be filled instead of pushing the pixels
+ */
+bool app_lvgl_lgfx_draw_take_solid(const lv_area_t *area, uint16_t *color);
+
+/**
+ * @brief Copy the task counters
+ */
+void app_lvgl_lgfx_draw_get_stats(app_lvgl_lgfx_draw_stats_t *out);
+
+/**
+ * @brief Zero the task counters
+ */
+void app_lvgl_lgfx_draw_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,166 @@
+/**
+ * @file app_lvgl_touch.c
+ * @brief Event-mode LVGL touch input fed by an acquisition task
+ */
+
+#include "app_lvgl_touch.h"
+
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "app_lvgl.h"
+#include "app_touch_read.h"
+#include "app_tracer.h"
+
+static const char *TAG = "app_lvgl_touch";
+
+#define TOUCH_RING_LEN  16          // Samples buffered while LVGL is busy rendering
+
+typedef struct {
+    int16_t x;
+    int16_t y;
+    bool pressed;
+} touch_sample_t;
+
+static esp_lcd_touch_handle_t s_tp;
+static lv_indev_t *s_indev;
+static TaskHandle_t s_task;
+static bool s_has_int;
+
+// Filled and drained by the acquisition task only (lv_indev_read() runs
+// there), so no locking beyond the LVGL lock around the read
+static touch_sample_t s_ring[TOUCH_RING_LEN];
+static uint32_t s_head;
+static uint32_t s_tail;
+static touch_sample_t s_last;
+
+// ========================== Sample buffer ==========================
+
+// Full ring, state change coming in: make room without losing an edge.
+// Drops the oldest sample that has the same state as the one after it (a
+// plain move); if every sample is an edge, the oldest press/release pair
+// goes, which leaves the state LVGL ends up in unchanged.
+static void ring_make_room(void)
+{
+    for (uint32_t i = s_tail; i + 1 != s_head; i++) {
+        if (s_ring[i % TOUCH_RING_LEN].pressed == s_ring[(i + 1) % TOUCH_RING_LEN].pressed) {
+            for (uint32_t j = i; j != s_tail; j--) {
+                s_ring[j % TOUCH_RING_LEN] = s_ring[(j - 1) % TOUCH_RING_LEN];
+            }
+            s_tail++;
+            return;
+        }
+    }
+    s_tail += 2;
+}
+
+static void ring_push(int16_t x, int16_t y, bool pressed)
+{
+    if (s_head - s_tail == TOUCH_RING_LEN) {
+        // Full: fold into the newest sample if it has the same state
+        touch_sample_t *last = &s_ring[(s_head - 1) % TOUCH_RING_LEN];
+        if (last->pressed == pressed) {
+            last->x = x;
+            last->y = y;
+            return;
+        }
+        ring_make_room();
+    }
+    s_ring[s_head % TOUCH_RING_LEN] = (touch_sample_t){ .x = x, .y = y, .pressed = pressed };
+    s_head++;
+}
+
+static void touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
+{
+    (void)indev;
+    if (s_tail != s_head) {
+        s_last = s_ring[s_tail % TOUCH_RING_LEN];
+        s_tail++;
+    }
+    data->point.x = s_last.x;
+    data->point.y = s_last.y;
+    data->state = s_last.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    data->continue_reading = (s_tail != s_head);
+}
+
+// ========================== Acquisition task ==========================
+
+static void touch_isr_cb(esp_lcd_touch_handle_t tp)
+{
+    (void)tp;
+    BaseType_t hp_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(s_task, &hp_task_woken);
+    portYIELD_FROM_ISR(hp_task_woken);
+}
+
+static void touch_acq_task(void *arg)
+{
+    (void)arg;
+    const TickType_t poll = pdMS_TO_TICKS(CONFIG_APP_LVGL_TOUCH_POLL_MS);
+    bool was_pressed = false;
+
+    while (1) {
+        // While touched, poll so LVGL sees PRESSING/long-press cadence; when
+        // released, sleep until the INT pin fires (or the next poll without
+        // one). Samples LVGL has not taken yet (lock busy) keep it polling,
+        // or a release edge could sit in the ring until the next touch.
+        bool pending = s_head != s_tail;
+        ulTaskNotifyTake(pdTRUE, (was_pressed || pending || !s_has_int) ? poll : portMAX_DELAY);
+
+        APP_TRACE_BEGIN("touch_acq");
+        app_touch_read(s_tp);
+        uint16_t x = 0, y = 0, strength = 0;
+        uint8_t n = 0;
+        bool pressed = esp_lcd_touch_get_coordinates(s_tp, &x, &y, &strength, &n, 1) && n > 0;
+        if (pressed || was_pressed) {
+            ring_push((int16_t)x, (int16_t)y, pressed);
+        }
+        was_pressed = pressed;
+
+        // Deliver now unless LVGL is mid-render; then the samples wait in the
+        // ring for the next acquisition
+        if (s_head != s_tail && app_lvgl_lock(1)) {
+            lv_indev_read(s_indev);
+            app_lvgl_unlock();
+            app_lvgl_wake();
+        }
+        APP_TRACE_END("touch_acq");
+    }
+}
+
+// ========================== Public API ==========================
+
+lv_indev_t *app_lvgl_touch_add(lv_display_t *disp, esp_lcd_touch_handle_t tp)
+{
+    if (!disp || !tp) return NULL;
+    s_tp = tp;
+
+    app_lvgl_lock(0);
+    s_indev = lv_indev_create();
+    lv_indev_set_type(s_indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_mode(s_indev, LV_INDEV_MODE_EVENT);
+    lv_indev_set_read_cb(s_indev, touch_read_cb);
+    lv_indev_set_display(s_indev, disp);
+    app_lvgl_unlock();
+
+    // Events run LVGL callbacks in this task, so give it LVGL-task stack and
+    // a priority just above the LVGL task
+    BaseType_t ok = xTaskCreate(touch_acq_task, "lv_touch", 6144, NULL,
+                                CONFIG_APP_LVGL_TOUCH_TASK_PRIO, &s_task);
+    if (ok != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create acquisition task");
+        app_lvgl_lock(0);
+        lv_indev_delete(s_indev);
+        app_lvgl_unlock();
+        s_indev = NULL;
+        return NULL;
+    }
+
+    s_has_int = (tp->config.int_gpio_num >= 0) &&
+                esp_lcd_touch_register_interrupt_callback(tp, touch_isr_cb) == ESP_OK;
+
+    ESP_LOGI(TAG, "Event-mode touch (%s, %d ms poll while touched)",
+             s_has_int ? "INT pin" : "polled", CONFIG_APP_LVGL_TOUCH_POLL_MS);
+    return s_indev;
+}
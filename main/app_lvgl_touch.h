@@ -0,0 +1,35 @@
+/**
+ * @file app_lvgl_touch.h
+ * @brief Event-mode LVGL touch input fed by an acquisition task
+ *
+ * Replaces lvgl_port_add_touch() for the LVGL UIs. Instead of LVGL polling
+ * the controller from its indev read timer (one LV_DEF_REFR_PERIOD of delay
+ * per press), a dedicated task reads the controller, woken by the INT pin
+ * when wired or on a short poll otherwise. It buffers samples and feeds
+ * them straight into lv_indev_read() under the LVGL lock, so
+ * LV_EVENT_PRESSED fires right after the touch is acquired.
+ */
+
+#pragma once
+
+#include "esp_lcd_touch.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Create the event-mode pointer indev and start its acquisition task
+ *
+ * Call once, without the LVGL lock held.
+ *
+ * @param disp Display the pointer belongs to
+ * @param tp Touch controller
+ * @return The indev, or NULL on failure
+ */
+lv_indev_t *app_lvgl_touch_add(lv_display_t *disp, esp_lcd_touch_handle_t tp);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,409 @@
+/**
+ * @file app_mirror.c
+ * @brief Screen mirroring to the host ("mirror" command)
+ *
+ * Session:
+ *
+ *   host:   mirror start [fps] [kbytes_per_s]
+ *   device: mirror started <w> <h>
+ *   device: rectangles (rect_stream.h, DELTA565) ... an empty PRESENT
+ *           rectangle closes each frame
+ *   host:   mirror stop
+ *   device: mirror stopped frames=.. rects=.. bytes=.. encode_us=.. resyncs=..
+ *
+ * ESP_LOG output is muted while mirroring so log lines do not land in the
+ * middle of the binary stream; the viewer resynchronizes on the header
+ * magic if anything else does.
+ */
+
+#include "app_mirror.h"
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+#include "app_console.h"
+#include "app_lvgl.h"
+#include "rect_stream.h"
+
+static const char *TAG = "app_mirror";
+
+#define MIRROR_MAX_DIRTY   16
+#define MIRROR_BAND_PX     8192     // Pixels per encoded band (bounds the output buffer)
+#define MIRROR_BAND_ROWS   64
+#define MIRROR_CPU_SHARE   4        // Encode for at most 1/N of the time
+#define MIRROR_OUT_LEN     (RECT_HDR_LEN + 2 * MIRROR_BAND_PX + \
+                            MIRROR_BAND_ROWS * ((CONFIG_APP_LCD_HRES + 127) / 128))
+
+#define HRES CONFIG_APP_LCD_HRES
+#define VRES CONFIG_APP_LCD_VRES
+
+static lv_display_t *s_disp = NULL;
+static uint16_t *s_cur = NULL;      // Screen as LVGL last flushed it (PSRAM)
+static uint16_t *s_sent = NULL;     // Screen as the host has it (PSRAM)
+static uint16_t *s_line = NULL;     // Row snapshot being encoded
+static uint8_t *s_out = NULL;       // Header + payload of one band
+static TaskHandle_t s_task = NULL;
+
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static lv_area_t s_dirty[MIRROR_MAX_DIRTY];
+static int s_dirty_n = 0;
+
+static volatile bool s_active = false;
+static volatile bool s_busy = false;
+static volatile bool s_keyframe = false;   // Resend everything, no skips
+static uint32_t s_fps = CONFIG_APP_MIRROR_FPS;
+static uint32_t s_kbps = CONFIG_APP_MIRROR_KBPS;
+static vprintf_like_t s_prev_log = NULL;
+
+static struct {
+    uint32_t frames;
+    uint32_t rects;
+    uint64_t bytes;
+    uint64_t encode_us;
+    uint32_t resyncs;
+} s_stats;
+
+// ========================== Dirty rectangles ==========================
+
+static int32_t area_px(const lv_area_t *a)
+{
+    return (a->x2 - a->x1 + 1) * (a->y2 - a->y1 + 1);
+}
+
+static void area_join(lv_area_t *a, const lv_area_t *b)
+{
+    if (b->x1 < a->x1) a->x1 = b->x1;
+    if (b->y1 < a->y1) a->y1 = b->y1;
+    if (b->x2 > a->x2) a->x2 = b->x2;
+    if (b->y2 > a->y2) a->y2 = b->y2;
+}
+
+static bool area_touch(const lv_area_t *a, const lv_area_t *b)
+{
+    return a->x1 <= b->x2 + 1 && b->x1 <= a->x2 + 1 && a->y1 <= b->y2 + 1 && b->y1 <= a->y2 + 1;
+}
+
+// Caller holds s_lock
+static void dirty_add(const lv_area_t *a)
+{
+    for (int i = 0; i < s_dirty_n; i++) {
+        if (area_touch(&s_dirty[i], a)) {
+            area_join(&s_dirty[i], a);
+            return;
+        }
+    }
+    if (s_dirty_n < MIRROR_MAX_DIRTY) {
+        s_dirty[s_dirty_n++] = *a;
+        return;
+    }
+
+    // Full: grow the rectangle that grows least
+    int best = 0;
+    int32_t best_growth = INT32_MAX;
+    for (int i = 0; i < s_dirty_n; i++) {
+        lv_area_t j = s_dirty[i];
+        area_join(&j, a);
+        int32_t growth = area_px(&j) - area_px(&s_dirty[i]);
+        if (growth < best_growth) {
+            best_growth = growth;
+            best = i;
+        }
+    }
+    area_join(&s_dirty[best], a);
+}
+
+void app_mirror_capture(const lv_area_t *area, const uint8_t *px, uint32_t stride)
+{
+    if (!s_active || !area || !px) {
+        return;
+    }
+    if (area->x1 < 0 || area->y1 < 0 || area->x2 >= HRES || area->y2 >= VRES) {
+        return;
+    }
+
+    size_t row_bytes = (size_t)lv_area_get_width(area) * sizeof(uint16_t);
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(s_cur + (size_t)y * HRES + area->x1, px, row_bytes);
+        px += stride;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    dirty_add(area);
+    portEXIT_CRITICAL(&s_lock);
+}
+
+// ========================== Encoder task ==========================
+
+// Encode rows [y, y + rows) of columns [x, x + w) into s_out; returns the
+// message length, or 0 if none of the rows changed
+static size_t encode_band(uint16_t x, uint16_t y, uint16_t w, uint16_t rows, bool keyframe)
+{
+    uint8_t *o = s_out + RECT_HDR_LEN;
+    bool changed = keyframe;
+
+    for (uint16_t r = 0; r < rows; r++) {
+        uint16_t *sent = s_sent + (size_t)(y + r) * HRES + x;
+        // Snapshot first: LVGL may be flushing into s_cur meanwhile. A row
+        // changed under us is dirty again and goes out next frame.
+        memcpy(s_line, s_cur + (size_t)(y + r) * HRES + x, (size_t)w * sizeof(uint16_t));
+        if (!keyframe && memcmp(s_line, sent, (size_t)w * sizeof(uint16_t)) == 0) {
+            o += rect_encode_delta_row(s_line, sent, w, o);
+            continue;
+        }
+        changed = true;
+        o += rect_encode_delta_row(s_line, keyframe ? NULL : sent, w, o);
+        memcpy(sent, s_line, (size_t)w * sizeof(uint16_t));
+    }
+    if (!changed) {
+        return 0;
+    }
+
+    rect_hdr_t hdr = {
+        .codec = RECT_CODEC_DELTA565,
+        .x = x, .y = y, .w = w, .h = rows,
+        .payload_len = (uint32_t)(o - s_out - RECT_HDR_LEN),
+    };
+    rect_write_hdr(&hdr, s_out);
+    return (size_t)(o - s_out);
+}
+
+static bool send(const uint8_t *data, size_t len)
+{
+    if (app_console_write(data, len) == len) {
+        return true;
+    }
+    // Host stalled mid-message: its copy is unknown now
+    s_keyframe = true;
+    s_stats.resyncs++;
+    return false;
+}
+
+// Send one frame's worth of dirty rectangles; returns encode time in us
+static uint32_t mirror_frame(size_t byte_budget)
+{
+    lv_area_t list[MIRROR_MAX_DIRTY];
+    portENTER_CRITICAL(&s_lock);
+    bool keyframe = s_keyframe;
+    int n = s_dirty_n;
+    memcpy(list, s_dirty, sizeof(lv_area_t) * n);
+    s_dirty_n = 0;
+    s_keyframe = false;
+    portEXIT_CRITICAL(&s_lock);
+
+    if (keyframe) {
+        list[0] = (lv_area_t){0, 0, HRES - 1, VRES - 1};
+        n = 1;
+    }
+
+    uint32_t encode_us = 0;
+    size_t sent = 0;
+    for (int k = 0; k < n; k++) {
+        lv_area_t *a = &list[k];
+        uint16_t w = (uint16_t)lv_area_get_width(a);
+        uint16_t band = MIRROR_BAND_PX / w;
+        if (band > MIRROR_BAND_ROWS) band = MIRROR_BAND_ROWS;
+
+        for (int32_t y = a->y1; y <= a->y2; y += band) {
+            if (!keyframe && sent >= byte_budget) {
+                // Over budget: the rest waits for the next frame
+                lv_area_t rest = {a->x1, y, a->x2, a->y2};
+                portENTER_CRITICAL(&s_lock);
+                dirty_add(&rest);
+                for (int r = k + 1; r < n; r++) dirty_add(&list[r]);
+                portEXIT_CRITICAL(&s_lock);
+                goto present;
+            }
+            uint16_t rows = (uint16_t)((a->y2 - y + 1) < band ? (a->y2 - y + 1) : band);
+
+            int64_t t0 = esp_timer_get_time();
+            size_t len = encode_band((uint16_t)a->x1, (uint16_t)y, w, rows, keyframe);
+            encode_us += (uint32_t)(esp_timer_get_time() - t0);
+            if (len == 0) {
+                continue;
+            }
+            if (!send(s_out, len)) {
+                return encode_us;
+            }
+            sent += len;
+            s_stats.rects++;
+        }
+    }
+
+present:
+    if (sent) {
+        uint8_t hdr[RECT_HDR_LEN];
+        rect_write_hdr(&(rect_hdr_t){.codec = RECT_CODEC_DELTA565, .flags = RECT_FLAG_PRESENT}, hdr);
+        if (send(hdr, sizeof(hdr))) {
+            s_stats.frames++;
+            s_stats.bytes += sent + sizeof(hdr);
+        }
+    }
+    s_stats.encode_us += encode_us;
+    return encode_us;
+}
+
+static void mirror_task(void *arg)
+{
+    (void)arg;
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (true) {
+            // Busy is raised before active is checked, so mirror_stop()
+            // never returns while a frame is still going out
+            s_busy = true;
+            if (!s_active) {
+                s_busy = false;
+                break;
+            }
+            int64_t t0 = esp_timer_get_time();
+            uint32_t encode_us = mirror_frame((size_t)s_kbps * 1024 / s_fps);
+            uint32_t elapsed = (uint32_t)(esp_timer_get_time() - t0);
+            s_busy = false;
+
+            // Frame period, stretched so encoding stays under its CPU share
+            uint32_t period = 1000000 / s_fps;
+            uint32_t wait = period > elapsed ? period - elapsed : 0;
+            if (wait < encode_us * (MIRROR_CPU_SHARE - 1)) {
+                wait = encode_us * (MIRROR_CPU_SHARE - 1);
+            }
+            TickType_t ticks = pdMS_TO_TICKS(wait / 1000);
+            vTaskDelay(ticks ? ticks : 1);
+        }
+    }
+}
+
+// ========================== Console ==========================
+
+static int mirror_log_drop(const char *fmt, va_list args)
+{
+    (void)fmt;
+    (void)args;
+    return 0;
+}
+
+static esp_err_t alloc_buffers(void)
+{
+    if (s_cur) {
+        return ESP_OK;
+    }
+    size_t frame = (size_t)HRES * VRES * sizeof(uint16_t);
+    s_cur = heap_caps_malloc(frame, MALLOC_CAP_SPIRAM);
+    s_sent = heap_caps_malloc(frame, MALLOC_CAP_SPIRAM);
+    s_line = heap_caps_malloc(HRES * sizeof(uint16_t), MALLOC_CAP_INTERNAL);
+    s_out = heap_caps_malloc(MIRROR_OUT_LEN, MALLOC_CAP_INTERNAL);
+    if (!s_cur || !s_sent || !s_line || !s_out) {
+        free(s_cur);
+        free(s_sent);
+        free(s_line);
+        free(s_out);
+        s_cur = s_sent = s_line = NULL;
+        s_out = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+static void print_stats(const char *what)
+{
+    app_console_printf("mirror %s frames=%u rects=%u bytes=%llu encode_us=%llu resyncs=%u\r\n", what,
+                       (unsigned)s_stats.frames, (unsigned)s_stats.rects,
+                       (unsigned long long)s_stats.bytes, (unsigned long long)s_stats.encode_us,
+                       (unsigned)s_stats.resyncs);
+}
+
+static int mirror_start(int argc, char **argv)
+{
+    if (s_active) {
+        app_console_printf("mirror err already_running\r\n");
+        return 1;
+    }
+    uint32_t fps = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : CONFIG_APP_MIRROR_FPS;
+    uint32_t kbps = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 10) : CONFIG_APP_MIRROR_KBPS;
+    if (fps == 0 || fps > 60 || kbps == 0) {
+        app_console_printf("usage: mirror start [fps 1-60] [kbytes_per_s]\r\n");
+        return 1;
+    }
+    if (alloc_buffers() != ESP_OK) {
+        app_console_printf("mirror err no_mem\r\n");
+        return 1;
+    }
+
+    s_fps = fps;
+    s_kbps = kbps;
+    memset(&s_stats, 0, sizeof(s_stats));
+    // The viewer starts from a black frame
+    memset(s_sent, 0, (size_t)HRES * VRES * sizeof(uint16_t));
+    s_dirty_n = 0;
+    s_keyframe = false;
+
+    app_console_printf("mirror started %d %d\r\n", HRES, VRES);
+    s_prev_log = esp_log_set_vprintf(mirror_log_drop);
+    s_active = true;
+
+    // Full redraw fills s_cur and marks everything dirty
+    if (app_lvgl_lock(0)) {
+        lv_obj_invalidate(lv_display_get_screen_active(s_disp));
+        app_lvgl_unlock();
+    }
+    xTaskNotifyGive(s_task);
+    return 0;
+}
+
+static int mirror_stop(void)
+{
+    if (!s_active) {
+        print_stats("idle");
+        return 0;
+    }
+    s_active = false;
+    while (s_busy) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    esp_log_set_vprintf(s_prev_log);
+    print_stats("stopped");
+    return 0;
+}
+
+static int cmd_mirror(int argc, char **argv)
+{
+    const char *sub = argc > 1 ? argv[1] : "status";
+
+    if (strcmp(sub, "start") == 0) {
+        return mirror_start(argc, argv);
+    }
+    if (strcmp(sub, "stop") == 0) {
+        return mirror_stop();
+    }
+    if (strcmp(sub, "status") == 0) {
+        print_stats(s_active ? "running" : "idle");
+        return 0;
+    }
+    app_console_printf("usage: mirror start [fps] [kbytes_per_s] | stop | status\r\n");
+    return 1;
+}
+
+static const app_console_cmd_t s_cmd_mirror = {
+    "mirror", "mirror start|stop|status (stream the screen to the PC)", cmd_mirror,
+};
+
+esp_err_t app_mirror_init(lv_display_t *disp)
+{
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "bad args");
+    ESP_RETURN_ON_FALSE(s_task == NULL, ESP_ERR_INVALID_STATE, TAG, "already initialized");
+    s_disp = disp;
+
+    BaseType_t ok = xTaskCreate(mirror_task, "mirror", 3072, NULL, 2, &s_task);
+    ESP_RETURN_ON_FALSE(ok == pdPASS, ESP_ERR_NO_MEM, TAG, "mirror task");
+
+    return app_console_register(&s_cmd_mirror);
+}
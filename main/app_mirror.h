@@ -0,0 +1,42 @@
+/**
+ * @file app_mirror.h
+ * @brief Screen mirroring to the host ("mirror" command)
+ *
+ * While mirroring, every area LVGL flushes is copied into a PSRAM frame
+ * and marked dirty. A low-priority task DELTA565-encodes the dirty
+ * rectangles against the host's copy of the screen (rect_stream.h) and
+ * streams them over the console port within a frame-rate, byte-rate and
+ * CPU budget. Use tools/mirror_view.py on the host.
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Register the "mirror" console command
+ *
+ * @param disp Display to mirror (invalidated on start for a full first frame)
+ * @return ESP_OK on success
+ */
+esp_err_t app_mirror_init(lv_display_t *disp);
+
+/**
+ * @brief Copy a flushed area into the mirror frame (LVGL task, flush start)
+ *
+ * No-op unless a mirror session is running.
+ *
+ * @param area Flushed area (display coordinates)
+ * @param px RGB565 pixels of the area
+ * @param stride Bytes per row of @p px
+ */
+void app_mirror_capture(const lv_area_t *area, const uint8_t *px, uint32_t stride);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,189 @@
+/**
+ * @file app_ota.c
+ * @brief Firmware update over the console ("ota" command)
+ *
+ * Session (host lines are text, frames are binary):
+ *
+ *   host:   ota <image_size> <sha256_hex>
+ *   device: ota ready <block_max>             (after the slot is prepared)
+ *   host:   frame                             (repeated, see ota_stream.h)
+ *   device: ota ack <bytes_written>           (one per frame)
+ *   host:   END frame
+ *   device: ota done <slot> rebooting  |  ota err <reason>
+ */
+
+#include "app_ota.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_ota_ops.h"
+#include "esp_system.h"
+#include "mbedtls/sha256.h"
+
+#include "app_console.h"
+#include "lz4_block.h"
+#include "ota_stream.h"
+
+static const char *TAG = "app_ota";
+
+#define OTA_FRAME_TIMEOUT_MS 5000
+
+static int parse_sha256(const char *hex, uint8_t out[32])
+{
+    if (strlen(hex) != 64) return -1;
+    for (int i = 0; i < 32; i++) {
+        char byte[3] = {hex[2 * i], hex[2 * i + 1], 0};
+        char *end = NULL;
+        out[i] = (uint8_t)strtoul(byte, &end, 16);
+        if (*end) return -1;
+    }
+    return 0;
+}
+
+// Receive frames until END; returns NULL on success or an error reason
+static const char *receive_image(esp_ota_handle_t handle, uint32_t image_size,
+                                 mbedtls_sha256_context *sha, uint8_t *payload, uint8_t *raw)
+{
+    uint32_t written = 0;
+
+    while (true) {
+        uint8_t hdr_buf[OTA_FRAME_HDR_LEN];
+        if (app_console_read(hdr_buf, sizeof(hdr_buf), OTA_FRAME_TIMEOUT_MS) != sizeof(hdr_buf)) {
+            return "timeout";
+        }
+
+        ota_frame_hdr_t hdr;
+        ota_stream_err_t err = ota_frame_parse_hdr(hdr_buf, &hdr);
+        if (err != OTA_STREAM_OK) {
+            return ota_stream_err_str(err);
+        }
+        if (hdr.flags & OTA_FLAG_END) {
+            return (written == image_size) ? NULL : "short_image";
+        }
+
+        if (app_console_read(payload, hdr.payload_len, OTA_FRAME_TIMEOUT_MS) != hdr.payload_len) {
+            return "timeout";
+        }
+        err = ota_frame_decode(&hdr, payload, raw);
+        if (err != OTA_STREAM_OK) {
+            return ota_stream_err_str(err);
+        }
+        if (written + hdr.raw_len > image_size) {
+            return "image_too_long";
+        }
+
+        if (esp_ota_write(handle, raw, hdr.raw_len) != ESP_OK) {
+            return "flash_write";
+        }
+        mbedtls_sha256_update(sha, raw, hdr.raw_len);
+        written += hdr.raw_len;
+        app_console_printf("ota ack %u\r\n", (unsigned)written);
+    }
+}
+
+static int cmd_ota(int argc, char **argv)
+{
+    uint8_t expected_sha[32];
+    if (argc != 3 || parse_sha256(argv[2], expected_sha) != 0) {
+        app_console_printf("usage: ota <image_size> <sha256_hex>  (use tools/ota_push.py)\r\n");
+        return 1;
+    }
+    uint32_t image_size = (uint32_t)strtoul(argv[1], NULL, 10);
+
+    const esp_partition_t *part = esp_ota_get_next_update_partition(NULL);
+    if (!part) {
+        app_console_printf("ota err no_ota_slot\r\n");
+        return 1;
+    }
+    if (image_size == 0 || image_size > part->size) {
+        app_console_printf("ota err image_size %u (slot %u)\r\n", (unsigned)image_size, (unsigned)part->size);
+        return 1;
+    }
+
+    uint8_t *payload = heap_caps_malloc(LZ4_BLOCK_BOUND(OTA_BLOCK_MAX), MALLOC_CAP_INTERNAL);
+    uint8_t *raw = heap_caps_malloc(OTA_BLOCK_MAX, MALLOC_CAP_INTERNAL);
+    if (!payload || !raw) {
+        free(payload);
+        free(raw);
+        app_console_printf("ota err no_mem\r\n");
+        return 1;
+    }
+
+    ESP_LOGI(TAG, "Update to %s (0x%08x), %u bytes", part->label, (unsigned)part->address, (unsigned)image_size);
+
+    // Sequential-write mode erases sector by sector as data arrives
+    esp_ota_handle_t handle = 0;
+    const char *fail = NULL;
+    if (esp_ota_begin(part, OTA_WITH_SEQUENTIAL_WRITES, &handle) != ESP_OK) {
+        fail = "ota_begin";
+    }
+
+    mbedtls_sha256_context sha;
+    mbedtls_sha256_init(&sha);
+    mbedtls_sha256_starts(&sha, 0);
+
+    if (!fail) {
+        app_console_printf("ota ready %u\r\n", (unsigned)OTA_BLOCK_MAX);
+        fail = receive_image(handle, image_size, &sha, payload, raw);
+    }
+
+    if (!fail) {
+        uint8_t digest[32];
+        mbedtls_sha256_finish(&sha, digest);
+        if (memcmp(digest, expected_sha, sizeof(digest)) != 0) {
+            fail = "sha256";
+        }
+    }
+    mbedtls_sha256_free(&sha);
+    free(payload);
+    free(raw);
+
+    if (!fail) {
+        // esp_ota_end() also validates the app image header/segments
+        esp_err_t err = esp_ota_end(handle);
+        handle = 0;
+        if (err != ESP_OK) {
+            fail = (err == ESP_ERR_OTA_VALIDATE_FAILED) ? "image_invalid" : "ota_end";
+        } else if (esp_ota_set_boot_partition(part) != ESP_OK) {
+            fail = "set_boot";
+        }
+    }
+
+    if (fail) {
+        if (handle) {
+            esp_ota_abort(handle);
+        }
+        ESP_LOGE(TAG, "Update failed: %s", fail);
+        app_console_printf("ota err %s\r\n", fail);
+        return 1;
+    }
+
+    app_console_printf("ota done %s rebooting\r\n", part->label);
+    ESP_LOGI(TAG, "Update complete, restarting into %s", part->label);
+    vTaskDelay(pdMS_TO_TICKS(500));  // Let the reply reach the host
+    esp_restart();
+    return 0;
+}
+
+static const app_console_cmd_t s_cmd_ota = {
+    "ota", "ota <size> <sha256> (firmware update, see tools/ota_push.py)", cmd_ota,
+};
+
+esp_err_t app_ota_init(void)
+{
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    esp_ota_img_states_t state;
+    if (running && esp_ota_get_state_partition(running, &state) == ESP_OK &&
+        state == ESP_OTA_IMG_PENDING_VERIFY) {
+        ESP_LOGI(TAG, "New image in %s came up, marking valid", running->label);
+        esp_ota_mark_app_valid_cancel_rollback();
+    }
+
+    return app_console_register(&s_cmd_ota);
+}
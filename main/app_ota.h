@@ -0,0 +1,30 @@
+/**
+ * @file app_ota.h
+ * @brief Firmware update over the console ("ota" command)
+ *
+ * Receives an LZ4-compressed image stream (ota_stream.h) and writes it to
+ * the inactive OTA slot; use tools/ota_push.py on the host.
+ */
+
+#pragma once
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Register the "ota" console command and confirm the running image
+ *
+ * If the running image was just installed by an update and is pending
+ * verification (rollback enabled), it is marked valid here: reaching this
+ * point means display, USB and console came up.
+ *
+ * @return ESP_OK on success
+ */
+esp_err_t app_ota_init(void);
+
+#ifdef __cplusplus
+}
+#endif
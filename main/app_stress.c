@@ -0,0 +1,492 @@
+/**
+ * @file app_stress.c
+ * @brief Concurrent DMA / bus contention stress test ("stress" command)
+ *
+ * Each path runs in its own task doing one unit of work per step (a frame,
+ * a report, a read, a copy) and records the step time in a log2 histogram.
+ * Phase "solo" runs each selected path alone, phase "all" runs them
+ * together. Output, one line per path and phase plus a comparison line:
+ *
+ *   stress name=display phase=solo n=.. us_avg=.. us_p99=.. us_max=.. rate=.. MBps=.. errors=..
+ *   stress name=display phase=all  ...
+ *   stress name=display lat_avg=+..% lat_p99=+..% rate=-..%
+ *
+ * rate and MBps are per second of wall-clock phase time, so a paced path
+ * (hid=<hz>) reports the rate it achieved, not one step over its busy time.
+ */
+
+#include "app_stress.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_lvgl_port.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+#if CONFIG_APP_DISPLAY_ILI9341_SPI
+    #include "app_display_ili9341.h"
+#elif CONFIG_APP_DISPLAY_RGB_PARALLEL
+    #include "app_display_rgb.h"
+#elif CONFIG_APP_DISPLAY_LGFX
+    #include "app_display_lgfx.h"
+#elif CONFIG_APP_DISPLAY_VIRTUAL
+    #include "app_display_virtual.h"
+#endif
+
+#include "app_console.h"
+#include "app_lvgl.h"
+#include "app_touch_read.h"
+
+static const char *TAG = "app_stress";
+
+#define STRESS_DEFAULT_S    5
+#define STRESS_MAX_S        120
+#define STRESS_TASK_PRIO    3
+#define STRESS_TASK_STACK   3072
+#define STRESS_STRIP_LINES  16
+#define STRESS_PSRAM_LEN    (64 * 1024)
+#define STRESS_CDC_LINE     256
+#define STRESS_BUCKETS      24          // log2(us): up to ~8 s
+
+typedef struct {
+    uint32_t n;
+    uint32_t errors;
+    uint64_t sum_us;
+    uint64_t wall_us;               // Phase time of the worker, steps plus waits
+    uint32_t max_us;
+    uint64_t bytes;
+    uint32_t hist[STRESS_BUCKETS];
+} stress_stat_t;
+
+typedef struct stress_path {
+    const char *name;
+    bool (*setup)(void);            // NULL or false = path unavailable
+    esp_err_t (*step)(uint32_t *bytes);
+    void (*teardown)(void);
+    bool opt_in;                    // Only runs when named on the command line
+    bool selected;
+    stress_stat_t solo;
+    stress_stat_t all;
+} stress_path_t;
+
+static app_stress_cfg_t s_cfg;
+static EventGroupHandle_t s_done;
+static volatile int64_t s_deadline;
+static uint32_t s_hid_period_us;
+
+// ========================== Statistics ==========================
+
+static void stat_add(stress_stat_t *s, uint32_t us, uint32_t bytes, bool ok)
+{
+    s->n++;
+    s->sum_us += us;
+    s->bytes += bytes;
+    if (us > s->max_us) s->max_us = us;
+    if (!ok) s->errors++;
+    int b = 0;
+    while (b < STRESS_BUCKETS - 1 && (1u << (b + 1)) <= us) b++;
+    s->hist[b]++;
+}
+
+// 99th percentile, interpolated linearly inside its log2 bucket and never
+// above the observed maximum
+static uint32_t stat_p99(const stress_stat_t *s)
+{
+    if (!s->n) return 0;
+    uint32_t want = s->n - s->n / 100;
+    uint32_t acc = 0;
+    for (int b = 0; b < STRESS_BUCKETS; b++) {
+        if (acc + s->hist[b] >= want) {
+            uint32_t lo = b ? (1u << b) : 0;
+            uint32_t width = b ? (1u << b) : 2;
+            uint32_t p = lo + (uint32_t)((uint64_t)width * (want - acc) / s->hist[b]);
+            return p < s->max_us ? p : s->max_us;
+        }
+        acc += s->hist[b];
+    }
+    return s->max_us;
+}
+
+static double stat_avg(const stress_stat_t *s)
+{
+    return s->n ? (double)s->sum_us / s->n : 0.0;
+}
+
+static double stat_rate(const stress_stat_t *s)
+{
+    return s->wall_us ? 1e6 * s->n / (double)s->wall_us : 0.0;
+}
+
+static void stat_print(const char *name, const char *phase, const stress_stat_t *s)
+{
+    app_console_printf("stress name=%s phase=%s n=%u us_avg=%.1f us_p99=%u us_max=%u rate=%.1f MBps=%.2f errors=%u\r\n",
+                       name, phase, (unsigned)s->n, stat_avg(s), (unsigned)stat_p99(s), (unsigned)s->max_us,
+                       stat_rate(s), s->wall_us ? (double)s->bytes / (double)s->wall_us : 0.0,
+                       (unsigned)s->errors);
+}
+
+static double pct(double from, double to)
+{
+    return from > 0 ? 100.0 * (to - from) / from : 0.0;
+}
+
+// ========================== Display ==========================
+
+static uint16_t *s_strip[2];
+
+static bool display_setup(void)
+{
+    if (!s_cfg.disp) return false;
+    for (int i = 0; i < 2; i++) {
+        s_strip[i] = heap_caps_malloc(CONFIG_APP_LCD_HRES * STRESS_STRIP_LINES * sizeof(uint16_t), MALLOC_CAP_DMA);
+        if (!s_strip[i]) return false;
+        memset(s_strip[i], i ? 0x00 : 0xFF, CONFIG_APP_LCD_HRES * STRESS_STRIP_LINES * sizeof(uint16_t));
+    }
+    return true;
+}
+
+// One full-screen frame in 16-row strips, alternating buffers
+static esp_err_t display_step(uint32_t *bytes)
+{
+    esp_err_t err = ESP_OK;
+    int cur = 0;
+    for (int y = 0; y < CONFIG_APP_LCD_VRES && err == ESP_OK; y += STRESS_STRIP_LINES) {
+        int rows = CONFIG_APP_LCD_VRES - y < STRESS_STRIP_LINES ? CONFIG_APP_LCD_VRES - y : STRESS_STRIP_LINES;
+        err = app_display_blit(0, y, CONFIG_APP_LCD_HRES, rows, s_strip[cur]);
+        cur ^= 1;
+    }
+    if (err == ESP_OK) err = app_display_sync();
+    *bytes = CONFIG_APP_LCD_HRES * CONFIG_APP_LCD_VRES * sizeof(uint16_t);
+    return err;
+}
+
+static void display_teardown(void)
+{
+    app_display_sync();     // The strips must not be freed while on the bus
+    for (int i = 0; i < 2; i++) {
+        heap_caps_free(s_strip[i]);
+        s_strip[i] = NULL;
+    }
+}
+
+// ========================== USB HID / CDC ==========================
+
+static bool hid_setup(void)
+{
+    return s_cfg.hid != NULL;
+}
+
+// Idle report (no motion, no buttons), so the host sees nothing
+static esp_err_t hid_step(uint32_t *bytes)
+{
+    esp_err_t err;
+#if CONFIG_APP_HID_MODE_TRACKPAD
+    err = app_hid_trackpad_send_move(s_cfg.hid, 0, 0);
+#elif CONFIG_APP_HID_MODE_MACROPAD
+    err = app_hid_macropad_release_all(s_cfg.hid);
+#elif CONFIG_APP_HID_MODE_GAMEPAD
+    const gamepad_state_t neutral = {0};
+    err = app_hid_gamepad_send_state(s_cfg.hid, &neutral);
+#else
+    err = ESP_ERR_NOT_SUPPORTED;
+#endif
+    *bytes = 8;
+    return err;
+}
+
+static bool cdc_setup(void)
+{
+#if CONFIG_APP_CONSOLE_TRANSPORT_CDC
+    return true;
+#else
+    return false;
+#endif
+}
+
+// A console line the host tools skip; fails if the host stops reading
+static esp_err_t cdc_step(uint32_t *bytes)
+{
+    static uint32_t seq;
+    char line[STRESS_CDC_LINE];
+    int n = snprintf(line, sizeof(line), "stress pad %08u ", (unsigned)seq++);
+    memset(line + n, '.', sizeof(line) - n - 2);
+    line[sizeof(line) - 2] = '\r';
+    line[sizeof(line) - 1] = '\n';
+    size_t done = app_console_write(line, sizeof(line));
+    *bytes = done;
+    return done == sizeof(line) ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+// ========================== Touch / PSRAM ==========================
+
+static bool touch_setup(void)
+{
+    return s_cfg.touch != NULL;
+}
+
+static esp_err_t touch_step(uint32_t *bytes)
+{
+    *bytes = 0;
+    return app_touch_read(s_cfg.touch);
+}
+
+static uint8_t *s_psram[2];
+
+static bool psram_setup(void)
+{
+    for (int i = 0; i < 2; i++) {
+        s_psram[i] = heap_caps_malloc(STRESS_PSRAM_LEN, MALLOC_CAP_SPIRAM);
+        if (!s_psram[i]) return false;
+        memset(s_psram[i], i, STRESS_PSRAM_LEN);
+    }
+    return true;
+}
+
+static esp_err_t psram_step(uint32_t *bytes)
+{
+    memcpy(s_psram[1], s_psram[0], STRESS_PSRAM_LEN);
+    *bytes = 2 * STRESS_PSRAM_LEN;      // Read plus write on the same bus
+    return ESP_OK;
+}
+
+static void psram_teardown(void)
+{
+    for (int i = 0; i < 2; i++) {
+        heap_caps_free(s_psram[i]);
+        s_psram[i] = NULL;
+    }
+}
+
+enum {
+    STRESS_DISPLAY,
+    STRESS_HID,
+    STRESS_CDC,
+    STRESS_TOUCH,
+    STRESS_PSRAM,
+    STRESS_PATHS
+};
+
+static stress_path_t s_paths[STRESS_PATHS] = {
+    [STRESS_DISPLAY] = {.name = "display", .setup = display_setup, .step = display_step, .teardown = display_teardown},
+    [STRESS_HID]     = {.name = "hid",     .setup = hid_setup,     .step = hid_step},
+    [STRESS_CDC]     = {.name = "cdc",     .setup = cdc_setup,     .step = cdc_step,     .opt_in = true},
+    [STRESS_TOUCH]   = {.name = "touch",   .setup = touch_setup,   .step = touch_step},
+    [STRESS_PSRAM]   = {.name = "psram",   .setup = psram_setup,   .step = psram_step,   .teardown = psram_teardown},
+};
+
+// ========================== Runner ==========================
+
+typedef struct {
+    stress_path_t *path;
+    stress_stat_t *stat;
+    EventBits_t bit;
+} worker_arg_t;
+
+static void worker_task(void *arg)
+{
+    worker_arg_t *w = (worker_arg_t *)arg;
+    bool paced = w->path == &s_paths[STRESS_HID] && s_hid_period_us;
+    int64_t start = esp_timer_get_time();
+    int64_t next = start;
+
+    while (esp_timer_get_time() < s_deadline) {
+        uint32_t bytes = 0;
+        int64_t t0 = esp_timer_get_time();
+        esp_err_t err = w->path->step(&bytes);
+        stat_add(w->stat, (uint32_t)(esp_timer_get_time() - t0), bytes, err == ESP_OK);
+
+        if (paced) {
+            // Report rate cap: sleep to the next slot (tick resolution)
+            next += s_hid_period_us;
+            int64_t wait_us = next - esp_timer_get_time();
+            if (wait_us >= 1000) vTaskDelay(pdMS_TO_TICKS(wait_us / 1000));
+        } else {
+            // Let equal-priority tasks on this core run
+            taskYIELD();
+        }
+    }
+    w->stat->wall_us = (uint64_t)(esp_timer_get_time() - start);
+
+    xEventGroupSetBits(s_done, w->bit);
+    vTaskDelete(NULL);
+}
+
+// Run the selected paths (all == true) or one path (all == false) for seconds
+static bool run_phase(stress_path_t *only, int seconds)
+{
+    static worker_arg_t args[STRESS_PATHS];
+    EventBits_t bits = 0;
+
+    xEventGroupClearBits(s_done, (1u << STRESS_PATHS) - 1);
+    s_deadline = esp_timer_get_time() + (int64_t)seconds * 1000000;
+
+    for (size_t i = 0; i < STRESS_PATHS; i++) {
+        stress_path_t *p = &s_paths[i];
+        if (!p->selected || (only && only != p)) continue;
+        args[i] = (worker_arg_t){p, only ? &p->solo : &p->all, 1u << i};
+        char name[16];
+        snprintf(name, sizeof(name), "st_%s", p->name);
+        if (xTaskCreate(worker_task, name, STRESS_TASK_STACK, &args[i], STRESS_TASK_PRIO, NULL) != pdPASS) {
+            ESP_LOGE(TAG, "Failed to start %s worker", p->name);
+            s_deadline = 0;
+            break;
+        }
+        bits |= args[i].bit;
+    }
+    if (bits) {
+        xEventGroupWaitBits(s_done, bits, pdFALSE, pdTRUE, portMAX_DELAY);
+    }
+    return s_deadline != 0;
+}
+
+static bool path_select(int argc, char **argv, int *seconds)
+{
+    bool named = false;
+    *seconds = STRESS_DEFAULT_S;
+    s_hid_period_us = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "hid=", 4) == 0) {
+            int hz = atoi(argv[i] + 4);
+            s_hid_period_us = hz > 0 ? 1000000 / hz : 0;
+        } else if (argv[i][0] >= '0' && argv[i][0] <= '9') {
+            *seconds = atoi(argv[i]);
+        } else {
+            named = true;
+        }
+    }
+    if (*seconds < 1) *seconds = 1;
+    if (*seconds > STRESS_MAX_S) *seconds = STRESS_MAX_S;
+
+    for (size_t i = 0; i < STRESS_PATHS; i++) {
+        stress_path_t *p = &s_paths[i];
+        p->selected = !named && !p->opt_in;
+        for (int a = 1; a < argc && named; a++) {
+            p->selected |= strcmp(argv[a], p->name) == 0;
+        }
+        memset(&p->solo, 0, sizeof(p->solo));
+        memset(&p->all, 0, sizeof(p->all));
+    }
+    for (int a = 1; a < argc; a++) {
+        bool known = strncmp(argv[a], "hid=", 4) == 0 || (argv[a][0] >= '0' && argv[a][0] <= '9');
+        for (size_t i = 0; i < STRESS_PATHS && !known; i++) {
+            known = strcmp(argv[a], s_paths[i].name) == 0;
+        }
+        if (!known) {
+            app_console_printf("err unknown path '%s'\r\n", argv[a]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static int cmd_stress(int argc, char **argv)
+{
+    int seconds;
+    if (!path_select(argc, argv, &seconds)) {
+        app_console_printf("usage: stress [seconds] [hid=<hz>] [display|hid|cdc|touch|psram ...]\r\n");
+        return 1;
+    }
+
+    app_console_printf("stress profile %s\r\n", app_console_profile());
+#if CONFIG_APP_DISPLAY_RGB_PARALLEL || CONFIG_APP_LGFX_PANEL_RGB
+    const char *bus_key = "pclk_hz";
+    const int bus_hz = CONFIG_APP_LCD_RGB_PCLK_HZ;
+#elif CONFIG_APP_DISPLAY_VIRTUAL
+    const char *bus_key = "bus_hz";         // No bus: copies into RAM
+    const int bus_hz = 0;
+#else
+    const char *bus_key = "spi_hz";
+    const int bus_hz = CONFIG_APP_LCD_SPI_CLOCK_HZ;
+#endif
+#ifdef CONFIG_APP_TOUCH_I2C_CLOCK_HZ
+    const int i2c_hz = CONFIG_APP_TOUCH_I2C_CLOCK_HZ;
+#else
+    const int i2c_hz = 0;                   // No touch, or virtual touch
+#endif
+    app_console_printf("stress envelope %s=%d i2c_hz=%d hid_hz=%u seconds=%d\r\n", bus_key, bus_hz, i2c_hz,
+                       (unsigned)(s_hid_period_us ? 1000000 / s_hid_period_us : 0), seconds);
+
+    // The display path owns the panel: stop LVGL like "display host" does.
+    // So does the touch path when LVGL's own indev (esp_lvgl_port) reads
+    // the controller, since that read does not go through app_touch_read().
+    bool lvgl_paused = false;
+    bool touch_shared = false;
+#if !CONFIG_APP_LVGL_TOUCH_EVENT
+    touch_shared = s_paths[STRESS_TOUCH].selected && s_cfg.touch;
+#endif
+    if ((s_paths[STRESS_DISPLAY].selected || touch_shared) && s_cfg.disp) {
+        lvgl_port_stop();
+        if (app_lvgl_lock(0)) {
+            app_lvgl_unlock();
+        }
+        lvgl_paused = true;
+    }
+
+    int active = 0;
+    for (size_t i = 0; i < STRESS_PATHS; i++) {
+        stress_path_t *p = &s_paths[i];
+        if (!p->selected) continue;
+        if (!p->setup || !p->setup()) {
+            app_console_printf("stress name=%s skipped=unavailable\r\n", p->name);
+            if (p->teardown) p->teardown();
+            p->selected = false;
+            continue;
+        }
+        active++;
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < STRESS_PATHS && ok; i++) {
+        if (!s_paths[i].selected) continue;
+        ok = run_phase(&s_paths[i], seconds);
+        stat_print(s_paths[i].name, "solo", &s_paths[i].solo);
+    }
+    if (ok && active > 1) {
+        ok = run_phase(NULL, seconds);
+        for (size_t i = 0; i < STRESS_PATHS; i++) {
+            stress_path_t *p = &s_paths[i];
+            if (!p->selected) continue;
+            stat_print(p->name, "all", &p->all);
+            app_console_printf("stress name=%s lat_avg=%+.0f%% lat_p99=%+.0f%% rate=%+.0f%%\r\n", p->name,
+                               pct(stat_avg(&p->solo), stat_avg(&p->all)),
+                               pct(stat_p99(&p->solo), stat_p99(&p->all)),
+                               pct(stat_rate(&p->solo), stat_rate(&p->all)));
+        }
+    }
+
+    for (size_t i = 0; i < STRESS_PATHS; i++) {
+        if (s_paths[i].selected && s_paths[i].teardown) s_paths[i].teardown();
+    }
+    if (lvgl_paused) {
+        if (app_lvgl_lock(0)) {
+            lv_obj_invalidate(lv_display_get_screen_active(s_cfg.disp));
+            app_lvgl_unlock();
+        }
+        lvgl_port_resume();
+    }
+
+    app_console_printf(ok ? "stress done\r\n" : "stress err task_create\r\n");
+    return ok ? 0 : 1;
+}
+
+static const app_console_cmd_t s_cmd_stress = {
+    "stress", "stress [seconds] [hid=<hz>] [display|hid|cdc|touch|psram ...]", cmd_stress,
+};
+
+esp_err_t app_stress_init(const app_stress_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(cfg, ESP_ERR_INVALID_ARG, TAG, "bad args");
+    s_cfg = *cfg;
+    s_done = xEventGroupCreate();
+    ESP_RETURN_ON_FALSE(s_done, ESP_ERR_NO_MEM, TAG, "event group");
+    return app_console_register(&s_cmd_stress);
+}
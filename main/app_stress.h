@@ -0,0 +1,48 @@
+/**
+ * @file app_stress.h
+ * @brief Concurrent DMA / bus contention stress test ("stress" command)
+ *
+ * Runs the board's bus masters on their own, then all at once, and
+ * reports how much each one's latency and throughput degrades:
+ *
+ *   display  full-screen frames through app_display_blit() (SPI or RGB DMA)
+ *   hid      HID reports on the USB IN endpoint
+ *   cdc      bulk text on the USB CDC console (only when named)
+ *   touch    I2C touch controller reads
+ *   psram    64 KB PSRAM-to-PSRAM memcpy
+ *
+ * Repeat it with different pixel clock, SPI clock and report rate settings
+ * to find the envelope a board stays responsive in.
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "esp_lcd_touch.h"
+#include "lvgl.h"
+#include "app_hid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Handles the stress paths use (NULL = path unavailable)
+ */
+typedef struct {
+    esp_lcd_touch_handle_t touch;
+    app_hid_t *hid;
+    lv_display_t *disp;             // Paused during the run, repainted after
+} app_stress_cfg_t;
+
+/**
+ * @brief Register the "stress" console command
+ *
+ * @param cfg Handles (copied)
+ * @return ESP_OK on success
+ */
+esp_err_t app_stress_init(const app_stress_cfg_t *cfg);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,324 @@
+/**
+ * @file app_sysmon.c
+ * @brief Per-task / per-core CPU load monitor ("top" command, overlay)
+ */
+
+#include "app_sysmon.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+#include "app_console.h"
+#include "app_lvgl.h"
+
+static const char *TAG = "app_sysmon";
+
+#define SYSMON_MAX_TASKS    40
+#define SYSMON_AVG_WEIGHT   0.2f        // EMA weight of the newest window (~5 windows)
+#define SYSMON_CORES        (portNUM_PROCESSORS < APP_SYSMON_MAX_CORES ? portNUM_PROCESSORS : APP_SYSMON_MAX_CORES)
+
+typedef enum {
+    GROUP_NONE,
+    GROUP_TRACKPAD,
+    GROUP_LVGL,
+    GROUP_USB,
+    GROUP_IDLE,
+} sysmon_group_t;
+
+typedef struct {
+    TaskHandle_t handle;
+    char name[configMAX_TASK_NAME_LEN];
+    uint32_t last;              // Run-time counter at the previous sample
+    float now;                  // % of one core, last window
+    float avg;
+    int core;                   // Pinned core, -1 = any
+    UBaseType_t prio;
+    uint32_t stack_free;        // High-water mark, bytes
+    bool seen;
+} sysmon_task_t;
+
+static TaskStatus_t s_status[SYSMON_MAX_TASKS];
+static sysmon_task_t s_tasks[SYSMON_MAX_TASKS];
+static int s_task_count;
+static SemaphoreHandle_t s_tasks_mutex;    // s_tasks/s_task_count: sampler vs. "top"
+static uint32_t s_last_total;
+static int64_t s_last_sample_us;
+
+static app_sysmon_load_t s_load;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool s_stream;
+
+static lv_display_t *s_disp;
+static lv_obj_t *s_overlay;
+static lv_timer_t *s_overlay_timer;
+
+// ========================== Sampling ==========================
+
+static sysmon_group_t task_group(const char *name)
+{
+    if (strcmp(name, "trackpad_poll") == 0) return GROUP_TRACKPAD;
+    if (strcmp(name, "taskLVGL") == 0) return GROUP_LVGL;
+    if (strcmp(name, "TinyUSB") == 0) return GROUP_USB;
+    if (strncmp(name, "IDLE", 4) == 0) return GROUP_IDLE;
+    return GROUP_NONE;
+}
+
+static sysmon_task_t *task_slot(TaskHandle_t handle)
+{
+    for (int i = 0; i < s_task_count; i++) {
+        if (s_tasks[i].handle == handle) return &s_tasks[i];
+    }
+    if (s_task_count == SYSMON_MAX_TASKS) return NULL;
+    sysmon_task_t *t = &s_tasks[s_task_count++];
+    memset(t, 0, sizeof(*t));
+    t->handle = handle;
+    return t;
+}
+
+// Drop tasks that were not in the last sample (deleted)
+static void task_compact(void)
+{
+    int out = 0;
+    for (int i = 0; i < s_task_count; i++) {
+        if (s_tasks[i].seen) s_tasks[out++] = s_tasks[i];
+    }
+    s_task_count = out;
+}
+
+static void sample(void)
+{
+    configRUN_TIME_COUNTER_TYPE total = 0;
+    UBaseType_t n = uxTaskGetSystemState(s_status, SYSMON_MAX_TASKS, &total);
+    int64_t now_us = esp_timer_get_time();
+    if (n == 0) {
+        ESP_LOGW(TAG, "More than %d tasks; raise SYSMON_MAX_TASKS", SYSMON_MAX_TASKS);
+        return;
+    }
+
+    // The run-time counter is a single clock shared by all cores, so a
+    // task's delta over the window delta is its share of one core
+    uint32_t dt = (uint32_t)total - s_last_total;
+    bool first = s_last_total == 0;
+    s_last_total = (uint32_t)total;
+
+    xSemaphoreTake(s_tasks_mutex, portMAX_DELAY);
+    for (int i = 0; i < s_task_count; i++) s_tasks[i].seen = false;
+
+    app_sysmon_load_t load = {
+        .window_ms = (uint32_t)((now_us - s_last_sample_us) / 1000),
+        .cores = SYSMON_CORES,
+    };
+    s_last_sample_us = now_us;
+
+    for (UBaseType_t i = 0; i < n; i++) {
+        const TaskStatus_t *st = &s_status[i];
+        sysmon_task_t *t = task_slot(st->xHandle);
+        if (!t) continue;
+        bool fresh = t->name[0] == '\0';
+        uint32_t run = (uint32_t)st->ulRunTimeCounter;
+        float pct = (!first && !fresh && dt) ? 100.0f * (float)(run - t->last) / (float)dt : 0.0f;
+
+        strlcpy(t->name, st->pcTaskName, sizeof(t->name));
+        t->last = run;
+        t->now = pct;
+        t->avg = fresh ? pct : t->avg + SYSMON_AVG_WEIGHT * (pct - t->avg);
+        BaseType_t core = xTaskGetCoreID(st->xHandle);
+        t->core = core == tskNO_AFFINITY ? -1 : (int)core;
+        t->prio = st->uxCurrentPriority;
+        t->stack_free = (uint32_t)st->usStackHighWaterMark;
+        t->seen = true;
+
+        switch (task_group(t->name)) {
+        case GROUP_TRACKPAD: load.trackpad += pct; break;
+        case GROUP_LVGL:     load.lvgl += pct; break;
+        case GROUP_USB:      load.usb += pct; break;
+        case GROUP_IDLE:     load.idle += pct; break;
+        default: break;
+        }
+    }
+    task_compact();
+
+    // Core load = 100 - that core's idle task
+    for (int c = 0; c < SYSMON_CORES; c++) {
+        TaskHandle_t idle = xTaskGetIdleTaskHandleForCore(c);
+        for (int i = 0; i < s_task_count; i++) {
+            if (s_tasks[i].handle != idle) continue;
+            load.core[c] = 100.0f - s_tasks[i].now;
+            load.core_avg[c] = 100.0f - s_tasks[i].avg;
+            if (load.core[c] < 0) load.core[c] = 0;
+            if (load.core_avg[c] < 0) load.core_avg[c] = 0;
+        }
+    }
+    xSemaphoreGive(s_tasks_mutex);
+
+    if (first) return;
+    taskENTER_CRITICAL(&s_lock);
+    s_load = load;
+    taskEXIT_CRITICAL(&s_lock);
+}
+
+// One printf, so the line stays whole when other tasks print too
+static void print_summary(const app_sysmon_load_t *l)
+{
+    char cores[64] = "";
+    size_t len = 0;
+    for (int c = 0; c < l->cores && len < sizeof(cores); c++) {
+        len += snprintf(cores + len, sizeof(cores) - len, " cpu%d=%.1f cpu%d_avg=%.1f",
+                        c, l->core[c], c, l->core_avg[c]);
+    }
+    app_console_printf("sysmon window_ms=%u%s trackpad=%.1f lvgl=%.1f usb=%.1f idle=%.1f\r\n",
+                       (unsigned)l->window_ms, cores, l->trackpad, l->lvgl, l->usb, l->idle);
+}
+
+static void sysmon_task(void *arg)
+{
+    TickType_t last_wake = xTaskGetTickCount();
+    while (true) {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(CONFIG_APP_SYSMON_PERIOD_MS));
+        sample();
+        if (s_stream) {
+            app_sysmon_load_t l;
+            app_sysmon_get(&l);
+            print_summary(&l);
+        }
+    }
+}
+
+void app_sysmon_get(app_sysmon_load_t *out)
+{
+    taskENTER_CRITICAL(&s_lock);
+    *out = s_load;
+    taskEXIT_CRITICAL(&s_lock);
+}
+
+// ========================== Overlay ==========================
+
+// LVGL timer: runs in the LVGL task with the lock held
+static void overlay_timer_cb(lv_timer_t *t)
+{
+    app_sysmon_load_t l;
+    app_sysmon_get(&l);
+    if (l.cores > 1) {
+        lv_label_set_text_fmt(s_overlay, "CPU %d%% / %d%%\nTP %d  LV %d  USB %d",
+                              (int)(l.core[0] + 0.5f), (int)(l.core[1] + 0.5f),
+                              (int)(l.trackpad + 0.5f), (int)(l.lvgl + 0.5f), (int)(l.usb + 0.5f));
+    } else {
+        lv_label_set_text_fmt(s_overlay, "CPU %d%%\nTP %d  LV %d  USB %d", (int)(l.core[0] + 0.5f),
+                              (int)(l.trackpad + 0.5f), (int)(l.lvgl + 0.5f), (int)(l.usb + 0.5f));
+    }
+}
+
+esp_err_t app_sysmon_overlay(bool on)
+{
+    ESP_RETURN_ON_FALSE(s_disp, ESP_ERR_INVALID_STATE, TAG, "no display");
+    ESP_RETURN_ON_FALSE(app_lvgl_lock(1000), ESP_ERR_TIMEOUT, TAG, "LVGL lock");
+
+    if (on && !s_overlay) {
+        s_overlay = lv_label_create(lv_display_get_layer_top(s_disp));
+        lv_obj_set_style_bg_color(s_overlay, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(s_overlay, LV_OPA_70, 0);
+        lv_obj_set_style_text_color(s_overlay, lv_color_white(), 0);
+        lv_obj_set_style_pad_all(s_overlay, 4, 0);
+        lv_obj_align(s_overlay, LV_ALIGN_TOP_RIGHT, 0, 0);
+        lv_obj_remove_flag(s_overlay, LV_OBJ_FLAG_CLICKABLE);
+        s_overlay_timer = lv_timer_create(overlay_timer_cb, CONFIG_APP_SYSMON_PERIOD_MS, NULL);
+        overlay_timer_cb(s_overlay_timer);
+    } else if (!on && s_overlay) {
+        lv_timer_delete(s_overlay_timer);
+        lv_obj_delete(s_overlay);
+        s_overlay_timer = NULL;
+        s_overlay = NULL;
+    }
+
+    app_lvgl_unlock();
+    return ESP_OK;
+}
+
+// ========================== Console ==========================
+
+static void print_tasks(void)
+{
+    app_sysmon_load_t l;
+    app_sysmon_get(&l);
+
+    // Copy under the sampler's mutex; it updates the table in place
+    static sysmon_task_t snap[SYSMON_MAX_TASKS];
+    xSemaphoreTake(s_tasks_mutex, portMAX_DELAY);
+    int n = s_task_count;
+    memcpy(snap, s_tasks, n * sizeof(snap[0]));
+    xSemaphoreGive(s_tasks_mutex);
+
+    // Busiest first
+    for (int i = 1; i < n; i++) {
+        sysmon_task_t t = snap[i];
+        int j = i - 1;
+        while (j >= 0 && snap[j].now < t.now) {
+            snap[j + 1] = snap[j];
+            j--;
+        }
+        snap[j + 1] = t;
+    }
+
+    print_summary(&l);
+    for (int i = 0; i < n; i++) {
+        app_console_printf("sysmon task=%s core=%d prio=%u now=%.1f avg=%.1f stack_free=%u\r\n",
+                           snap[i].name, snap[i].core, (unsigned)snap[i].prio, snap[i].now, snap[i].avg,
+                           (unsigned)snap[i].stack_free);
+    }
+}
+
+static int cmd_top(int argc, char **argv)
+{
+    const char *sub = argc > 1 ? argv[1] : "";
+
+    if (argc == 1) {
+        print_tasks();
+        return 0;
+    }
+    if (strcmp(sub, "stream") == 0) {
+        s_stream = argc < 3 || strcmp(argv[2], "off") != 0;
+        app_console_printf("ok stream=%d period_ms=%d\r\n", s_stream, CONFIG_APP_SYSMON_PERIOD_MS);
+        return 0;
+    }
+    if (strcmp(sub, "overlay") == 0) {
+        esp_err_t err = app_sysmon_overlay(argc < 3 || strcmp(argv[2], "off") != 0);
+        if (err != ESP_OK) {
+            app_console_printf("err %s\r\n", esp_err_to_name(err));
+            return 1;
+        }
+        app_console_printf("ok\r\n");
+        return 0;
+    }
+    app_console_printf("usage: top | top stream [on|off] | top overlay [on|off]\r\n");
+    return 1;
+}
+
+static const app_console_cmd_t s_cmd_top = {
+    "top", "top | top stream [on|off] | top overlay [on|off] (CPU load per task/core)", cmd_top,
+};
+
+esp_err_t app_sysmon_init(lv_display_t *disp)
+{
+    s_disp = disp;
+    s_tasks_mutex = xSemaphoreCreateMutex();
+    ESP_RETURN_ON_FALSE(s_tasks_mutex, ESP_ERR_NO_MEM, TAG, "tasks mutex");
+    s_last_sample_us = esp_timer_get_time();
+    sample();       // Baseline for the first window
+
+    // Above the UI and console so a busy LVGL task cannot stall the report
+    BaseType_t ok = xTaskCreate(sysmon_task, "sysmon", 3072, NULL, 6, NULL);
+    ESP_RETURN_ON_FALSE(ok == pdPASS, ESP_ERR_NO_MEM, TAG, "sysmon task");
+
+#if CONFIG_APP_SYSMON_OVERLAY
+    if (disp) app_sysmon_overlay(true);
+#endif
+    return app_console_register(&s_cmd_top);
+}
@@ -0,0 +1,70 @@
+/**
+ * @file app_sysmon.h
+ * @brief Per-task / per-core CPU load monitor ("top" command, overlay)
+ *
+ * A low-rate task samples FreeRTOS run-time stats once per window
+ * (CONFIG_APP_SYSMON_PERIOD_MS) and turns the counter deltas into load
+ * percentages: per core (100 - that core's idle task) and per task, each
+ * as the last window and as a rolling average. The tasks this firmware
+ * cares most about are also summed into groups: trackpad_poll, the LVGL
+ * task, TinyUSB and the idle tasks.
+ *
+ * Task loads are percent of ONE core, so on a dual-core chip the task
+ * column can add up to 200.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define APP_SYSMON_MAX_CORES 2
+
+/**
+ * @brief Load summary of the last window
+ */
+typedef struct {
+    uint32_t window_ms;                     // Length of the last window
+    uint8_t cores;
+    float core[APP_SYSMON_MAX_CORES];       // % busy, last window
+    float core_avg[APP_SYSMON_MAX_CORES];   // % busy, rolling average
+    float trackpad;                         // Group loads, % of one core
+    float lvgl;
+    float usb;
+    float idle;
+} app_sysmon_load_t;
+
+/**
+ * @brief Start the sampling task and register the "top" console command
+ *
+ * @param disp Display for the load overlay (NULL = no overlay)
+ * @return ESP_OK on success
+ */
+esp_err_t app_sysmon_init(lv_display_t *disp);
+
+/**
+ * @brief Copy the latest load summary
+ *
+ * All zero until the first window has completed.
+ */
+void app_sysmon_get(app_sysmon_load_t *out);
+
+/**
+ * @brief Show or hide the load overlay on the display's top layer
+ *
+ * Takes the LVGL lock; call from any task except the LVGL task.
+ *
+ * @return ESP_OK, ESP_ERR_INVALID_STATE without a display, ESP_ERR_TIMEOUT
+ *         if the LVGL lock could not be taken
+ */
+esp_err_t app_sysmon_overlay(bool on);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,30 @@
+/**
+ * @file app_touch_read.c
+ * @brief Touch controller reads shared between tasks
+ */
+
+#include "app_touch_read.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+static StaticSemaphore_t s_lock_buf;
+static SemaphoreHandle_t s_lock = NULL;
+static portMUX_TYPE s_init_lock = portMUX_INITIALIZER_UNLOCKED;
+
+esp_err_t app_touch_read(esp_lcd_touch_handle_t tp)
+{
+    if (!s_lock) {
+        // First caller creates it; static storage, so this cannot fail
+        taskENTER_CRITICAL(&s_init_lock);
+        if (!s_lock) {
+            s_lock = xSemaphoreCreateMutexStatic(&s_lock_buf);
+        }
+        taskEXIT_CRITICAL(&s_init_lock);
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    esp_err_t err = esp_lcd_touch_read_data(tp);
+    xSemaphoreGive(s_lock);
+    return err;
+}
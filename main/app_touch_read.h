@@ -0,0 +1,30 @@
+/**
+ * @file app_touch_read.h
+ * @brief Touch controller reads shared between tasks
+ *
+ * The trackpad poll task, the LVGL touch acquisition task and the "bench"
+ * and "stress" commands all poll the same esp_lcd_touch handle. The driver
+ * does not serialise read_data() (one I2C transaction sequence per call),
+ * so every caller goes through app_touch_read().
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "esp_lcd_touch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief esp_lcd_touch_read_data() under a lock shared by all callers
+ *
+ * @param tp Touch handle
+ * @return Result of esp_lcd_touch_read_data()
+ */
+esp_err_t app_touch_read(esp_lcd_touch_handle_t tp);
+
+#ifdef __cplusplus
+}
+#endif
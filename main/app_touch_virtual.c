@@ -0,0 +1,318 @@
+/**
+ * @file app_touch_virtual.c
+ * @brief Virtual touch controller for QEMU runs (trace replay)
+ */
+
+#include "app_touch_virtual.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#if CONFIG_APP_CONSOLE_ENABLE
+    #include "app_console.h"
+#endif
+
+static const char *TAG = "app_touch";
+
+#define TRACE_LOAD_MAX      (64 * 1024)     // Largest trace "vtouch load" accepts
+#define TRACE_READ_TIMEOUT  2000
+#define TRACE_DEFAULT_STRENGTH 40
+
+// Embedded by main/CMakeLists.txt from CONFIG_APP_TOUCH_VIRTUAL_TRACE
+extern const char s_trace_txt[] asm("_binary_touch_trace_txt_start");
+
+typedef struct {
+    uint32_t t_ms;
+    uint16_t x;
+    uint16_t y;
+    uint16_t strength;      // 0 = no contact
+} trace_event_t;
+
+typedef struct {
+    trace_event_t *ev;
+    uint32_t count;
+    uint32_t duration_ms;   // Time of the last event = loop length
+} trace_t;
+
+// Replay state, shared by read_data() and the console command
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static trace_t s_trace;
+static uint32_t s_cursor;       // Next event to apply
+static int64_t s_t0_us;         // 0 = start the clock on the next read
+static uint32_t s_loops;
+static uint32_t s_reads;
+static trace_event_t s_cur;     // Contact in effect
+
+// ========================== Trace parsing ==========================
+
+// Parses the whole text up front so replay costs no parsing. On error,
+// *err_line holds the offending line number.
+static esp_err_t trace_parse(const char *text, size_t len, trace_t *out, uint32_t *err_line)
+{
+    // Upper bound on events: one per line
+    uint32_t lines = 1;
+    for (size_t i = 0; i < len; i++) {
+        if (text[i] == '\n') lines++;
+    }
+    trace_event_t *ev = heap_caps_malloc(lines * sizeof(trace_event_t), MALLOC_CAP_8BIT);
+    if (!ev) return ESP_ERR_NO_MEM;
+
+    uint32_t n = 0, line_no = 0;
+    const char *p = text, *end = text + len;
+    while (p < end) {
+        const char *eol = memchr(p, '\n', end - p);
+        if (!eol) eol = end;
+        line_no++;
+
+        char line[64];
+        size_t l = eol - p;
+        if (l >= sizeof(line)) l = sizeof(line) - 1;
+        memcpy(line, p, l);
+        line[l] = '\0';
+        p = eol + 1;
+
+        char *hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+
+        char *save = NULL;
+        char *tok[4];
+        int ntok = 0;
+        for (char *t = strtok_r(line, " \t\r,", &save); t && ntok < 4; t = strtok_r(NULL, " \t\r,", &save)) {
+            tok[ntok++] = t;
+        }
+        if (ntok == 0) continue;
+
+        char *e;
+        trace_event_t te = {0};
+        te.t_ms = strtoul(tok[0], &e, 10);
+        bool ok = *e == '\0' && (n == 0 || te.t_ms >= ev[n - 1].t_ms);
+        if (ok && ntok == 2 && strcmp(tok[1], "up") == 0) {
+            // No contact: strength stays 0
+        } else if (ok && ntok >= 3) {
+            long x = strtol(tok[1], &e, 10);
+            ok = *e == '\0' && x >= 0 && x < CONFIG_APP_LCD_HRES;
+            long y = strtol(tok[2], &e, 10);
+            ok = ok && *e == '\0' && y >= 0 && y < CONFIG_APP_LCD_VRES;
+            long s = TRACE_DEFAULT_STRENGTH;
+            if (ntok == 4) {
+                s = strtol(tok[3], &e, 10);
+                ok = ok && *e == '\0' && s > 0 && s <= UINT16_MAX;
+            }
+            te.x = (uint16_t)x;
+            te.y = (uint16_t)y;
+            te.strength = (uint16_t)s;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            free(ev);
+            *err_line = line_no;
+            return ESP_ERR_INVALID_ARG;
+        }
+        ev[n++] = te;
+    }
+
+    if (n == 0) {
+        free(ev);
+        *err_line = 0;
+        return ESP_ERR_INVALID_SIZE;
+    }
+    out->ev = ev;
+    out->count = n;
+    out->duration_ms = ev[n - 1].t_ms;
+    return ESP_OK;
+}
+
+// Back to the start of the trace; the clock restarts on the next read.
+// Caller holds s_lock.
+static void replay_rewind(void)
+{
+    s_cursor = 0;
+    s_t0_us = 0;
+    s_loops = 0;
+    s_cur = (trace_event_t){0};
+}
+
+// Installs a parsed trace and restarts replay; frees the previous one
+static void trace_install(const trace_t *t)
+{
+    portENTER_CRITICAL(&s_lock);
+    trace_t old = s_trace;
+    s_trace = *t;
+    replay_rewind();
+    portEXIT_CRITICAL(&s_lock);
+    free(old.ev);
+}
+
+// ========================== esp_lcd_touch driver ==========================
+
+static esp_err_t vtouch_read_data(esp_lcd_touch_handle_t tp)
+{
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&s_lock);
+    s_reads++;
+    if (s_t0_us == 0) s_t0_us = now;
+    uint32_t elapsed_ms = (uint32_t)((now - s_t0_us) / 1000);
+#if CONFIG_APP_TOUCH_VIRTUAL_LOOP
+    if (s_trace.duration_ms && elapsed_ms >= s_trace.duration_ms) {
+        uint32_t wraps = elapsed_ms / s_trace.duration_ms;
+        s_t0_us += (int64_t)wraps * s_trace.duration_ms * 1000;
+        elapsed_ms -= wraps * s_trace.duration_ms;
+        s_loops += wraps;
+        s_cursor = 0;
+    }
+#endif
+    while (s_cursor < s_trace.count && s_trace.ev[s_cursor].t_ms <= elapsed_ms) {
+        s_cur = s_trace.ev[s_cursor++];
+    }
+    trace_event_t cur = s_cur;
+    portEXIT_CRITICAL(&s_lock);
+
+    portENTER_CRITICAL(&tp->data.lock);
+    tp->data.points = cur.strength ? 1 : 0;
+    tp->data.coords[0].x = cur.x;
+    tp->data.coords[0].y = cur.y;
+    tp->data.coords[0].strength = cur.strength;
+    portEXIT_CRITICAL(&tp->data.lock);
+    return ESP_OK;
+}
+
+static bool vtouch_get_xy(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint16_t *strength,
+                          uint8_t *point_num, uint8_t max_point_num)
+{
+    portENTER_CRITICAL(&tp->data.lock);
+    *point_num = tp->data.points > max_point_num ? max_point_num : tp->data.points;
+    for (int i = 0; i < *point_num; i++) {
+        x[i] = tp->data.coords[i].x;
+        y[i] = tp->data.coords[i].y;
+        if (strength) strength[i] = tp->data.coords[i].strength;
+    }
+    tp->data.points = 0;
+    portEXIT_CRITICAL(&tp->data.lock);
+    return *point_num > 0;
+}
+
+static esp_err_t vtouch_del(esp_lcd_touch_handle_t tp)
+{
+    free(tp);
+    return ESP_OK;
+}
+
+// ========================== Console ==========================
+
+#if CONFIG_APP_CONSOLE_ENABLE
+static int trace_load(uint32_t size)
+{
+    if (size == 0 || size > TRACE_LOAD_MAX) {
+        app_console_printf("vtouch err size %u (max %u)\r\n", (unsigned)size, (unsigned)TRACE_LOAD_MAX);
+        return 1;
+    }
+    char *text = malloc(size);
+    if (!text) {
+        app_console_printf("vtouch err no_mem\r\n");
+        return 1;
+    }
+
+    app_console_printf("vtouch ready\r\n");
+    if (app_console_read(text, size, TRACE_READ_TIMEOUT) != size) {
+        free(text);
+        app_console_printf("vtouch err timeout\r\n");
+        return 1;
+    }
+
+    trace_t t;
+    uint32_t err_line = 0;
+    esp_err_t err = trace_parse(text, size, &t, &err_line);
+    free(text);
+    if (err != ESP_OK) {
+        app_console_printf("vtouch err %s line=%u\r\n",
+                           err == ESP_ERR_NO_MEM ? "no_mem" : "parse", (unsigned)err_line);
+        return 1;
+    }
+    trace_install(&t);
+    app_console_printf("vtouch loaded events=%u duration_ms=%u\r\n",
+                       (unsigned)t.count, (unsigned)t.duration_ms);
+    return 0;
+}
+
+static int cmd_vtouch(int argc, char **argv)
+{
+    if (argc >= 3 && strcmp(argv[1], "load") == 0) {
+        return trace_load((uint32_t)strtoul(argv[2], NULL, 10));
+    }
+    if (argc >= 2 && strcmp(argv[1], "restart") == 0) {
+        portENTER_CRITICAL(&s_lock);
+        replay_rewind();
+        portEXIT_CRITICAL(&s_lock);
+        app_console_printf("vtouch restarted\r\n");
+        return 0;
+    }
+    if (argc >= 2) {
+        app_console_printf("usage: vtouch [restart|load <bytes>]\r\n");
+        return 1;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    uint32_t count = s_trace.count, cursor = s_cursor, loops = s_loops, reads = s_reads;
+    uint32_t duration = s_trace.duration_ms;
+    trace_event_t cur = s_cur;
+    portEXIT_CRITICAL(&s_lock);
+    app_console_printf("vtouch events=%u duration_ms=%u cursor=%u loops=%u reads=%u down=%d x=%u y=%u\r\n",
+                       (unsigned)count, (unsigned)duration, (unsigned)cursor, (unsigned)loops,
+                       (unsigned)reads, cur.strength != 0, cur.x, cur.y);
+    return 0;
+}
+
+static const app_console_cmd_t s_cmd_vtouch = {
+    "vtouch", "vtouch [restart|load <bytes>] - virtual touch trace replay", cmd_vtouch,
+};
+#endif
+
+// ========================== Public API ==========================
+
+esp_err_t app_touch_init(app_touch_t *out)
+{
+    ESP_RETURN_ON_FALSE(out, ESP_ERR_INVALID_ARG, TAG, "null out");
+
+    trace_t t;
+    uint32_t err_line = 0;
+    ESP_RETURN_ON_ERROR(trace_parse(s_trace_txt, strlen(s_trace_txt), &t, &err_line), TAG,
+                        "embedded trace %s: bad line %u", CONFIG_APP_TOUCH_VIRTUAL_TRACE, (unsigned)err_line);
+    trace_install(&t);
+
+    esp_lcd_touch_handle_t tp = calloc(1, sizeof(esp_lcd_touch_t));
+    ESP_RETURN_ON_FALSE(tp, ESP_ERR_NO_MEM, TAG, "no mem for touch");
+    tp->read_data = vtouch_read_data;
+    tp->get_xy = vtouch_get_xy;
+    tp->del = vtouch_del;
+    tp->config = (esp_lcd_touch_config_t){
+        .x_max = CONFIG_APP_LCD_HRES,
+        .y_max = CONFIG_APP_LCD_VRES,
+        .rst_gpio_num = -1,
+        .int_gpio_num = -1,
+    };
+    portMUX_INITIALIZE(&tp->data.lock);
+
+#if CONFIG_APP_CONSOLE_ENABLE
+    app_console_register(&s_cmd_vtouch);
+#endif
+
+    out->tp = tp;
+    out->tp_io = NULL;
+#if CONFIG_APP_TOUCH_VIRTUAL_LOOP
+    const char *mode = "looping";
+#else
+    const char *mode = "once";
+#endif
+    ESP_LOGI(TAG, "Virtual touch init OK (%s: %u events, %u ms, %s)", CONFIG_APP_TOUCH_VIRTUAL_TRACE,
+             (unsigned)t.count, (unsigned)t.duration_ms, mode);
+    return ESP_OK;
+}
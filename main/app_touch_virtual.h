@@ -0,0 +1,40 @@
+/**
+ * @file app_touch_virtual.h
+ * @brief Virtual touch controller for QEMU runs (trace replay)
+ *
+ * An esp_lcd_touch driver with no controller behind it. Each read_data()
+ * looks up the contact at the current time in a touch trace, so the
+ * trackpad poll loop, the gesture engine and LVGL input see the same
+ * input on every run. The trace from CONFIG_APP_TOUCH_VIRTUAL_TRACE is
+ * embedded in the firmware; "vtouch load" replaces it at run time.
+ *
+ * Trace format, one event per line ('#' starts a comment):
+ *
+ *   <t_ms> <x> <y> [strength]   one contact at (x, y) from t_ms on
+ *   <t_ms> up                   no contact from t_ms on
+ *
+ * Times are relative to the first read after the trace was (re)loaded and
+ * must not decrease. Coordinates are as the controller reports them (the
+ * trackpad UI flips them 180 degrees like on the real boards). With
+ * CONFIG_APP_TOUCH_VIRTUAL_LOOP the trace restarts at the last event's time.
+ */
+
+#pragma once
+#include "esp_err.h"
+#include "esp_lcd_panel_io.h"
+#include "esp_lcd_touch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    esp_lcd_touch_handle_t tp;
+    esp_lcd_panel_io_handle_t tp_io;    // Always NULL (no bus)
+} app_touch_t;
+
+esp_err_t app_touch_init(app_touch_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @file app_tracer.c
+ * @brief In-RAM event tracer (begin/end/instant, microsecond timestamps)
+ */
+
+#include "app_tracer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_check.h"
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "app_console.h"
+
+static const char *TAG = "app_tracer";
+
+#define TRACE_MAX_TASKS 32
+
+// 16 bytes per event
+typedef struct {
+    const char *name;
+    uint32_t ts_us;         // Low 32 bits of esp_timer (wraps after ~71 min)
+    TaskHandle_t task;      // NULL when recorded from an ISR
+    uint8_t phase;
+    uint8_t core;
+    uint16_t reserved;
+} trace_event_t;
+
+static trace_event_t *s_events = NULL;
+static uint32_t s_mask = 0;
+static uint32_t s_head = 0;          // Total events recorded (atomic)
+static volatile bool s_running = false;
+
+void app_tracer_record(const char *name, app_trace_phase_t phase)
+{
+    if (!s_running) {
+        return;
+    }
+
+    uint32_t idx = __atomic_fetch_add(&s_head, 1, __ATOMIC_RELAXED);
+    trace_event_t *ev = &s_events[idx & s_mask];
+    ev->ts_us = (uint32_t)esp_timer_get_time();
+    ev->name = name;
+    ev->task = xPortInIsrContext() ? NULL : xTaskGetCurrentTaskHandle();
+    ev->phase = (uint8_t)phase;
+    ev->core = (uint8_t)esp_cpu_get_core_id();
+}
+
+// ========================== Console ==========================
+
+static void trace_reset(void)
+{
+    s_running = false;
+    memset(s_events, 0, (s_mask + 1) * sizeof(trace_event_t));
+    __atomic_store_n(&s_head, 0, __ATOMIC_RELAXED);
+}
+
+static void trace_dump(void)
+{
+    bool was_running = s_running;
+    s_running = false;
+    vTaskDelay(pdMS_TO_TICKS(2));  // Let in-flight records land
+
+    uint32_t head = __atomic_load_n(&s_head, __ATOMIC_RELAXED);
+    uint32_t count = head > s_mask + 1 ? s_mask + 1 : head;
+    uint32_t first = head - count;
+
+    app_console_printf("trace begin events=%u lost=%u\r\n", (unsigned)count, (unsigned)first);
+
+    // Task table. Some tasks (the stress workers, lvbench) delete themselves,
+    // so a handle in the ring may be stale: names come from the live task
+    // list, never from the handle itself. Exited tasks are listed as such.
+    UBaseType_t nlive = uxTaskGetNumberOfTasks() + 4;
+    TaskStatus_t *live = heap_caps_malloc(nlive * sizeof(TaskStatus_t), MALLOC_CAP_8BIT);
+    nlive = live ? uxTaskGetSystemState(live, nlive, NULL) : 0;
+
+    TaskHandle_t tasks[TRACE_MAX_TASKS];
+    size_t ntasks = 0;
+    for (uint32_t i = first; i < head; i++) {
+        TaskHandle_t t = s_events[i & s_mask].task;
+        if (!t) continue;
+        size_t k = 0;
+        while (k < ntasks && tasks[k] != t) k++;
+        if (k == ntasks && ntasks < TRACE_MAX_TASKS) {
+            tasks[ntasks++] = t;
+            const char *name = "(exited)";
+            for (UBaseType_t j = 0; j < nlive; j++) {
+                if (live[j].xHandle == t) {
+                    name = live[j].pcTaskName;
+                    break;
+                }
+            }
+            app_console_printf("T %08x %s\r\n", (unsigned)(uintptr_t)t, name);
+        }
+    }
+    free(live);
+
+    for (uint32_t i = first; i < head; i++) {
+        const trace_event_t *ev = &s_events[i & s_mask];
+        if (!ev->name) continue;
+        app_console_printf("E %u %c %u %08x %s\r\n", (unsigned)ev->ts_us, ev->phase, ev->core,
+                           (unsigned)(uintptr_t)ev->task, ev->name);
+    }
+    app_console_printf("trace end\r\n");
+
+    s_running = was_running;
+}
+
+static int cmd_trace(int argc, char **argv)
+{
+    const char *sub = argc > 1 ? argv[1] : "status";
+
+    if (strcmp(sub, "start") == 0) {
+        trace_reset();
+        s_running = true;
+    } else if (strcmp(sub, "stop") == 0) {
+        s_running = false;
+    } else if (strcmp(sub, "dump") == 0) {
+        trace_dump();
+        return 0;
+    } else if (strcmp(sub, "status") != 0) {
+        app_console_printf("usage: trace start|stop|dump|status\r\n");
+        return 1;
+    }
+
+    uint32_t head = __atomic_load_n(&s_head, __ATOMIC_RELAXED);
+    app_console_printf("trace running=%d recorded=%u capacity=%u\r\n",
+                       s_running, (unsigned)head, (unsigned)(s_mask + 1));
+    return 0;
+}
+
+static const app_console_cmd_t s_cmd_trace = {
+    "trace", "trace start|stop|dump|status (event timeline)", cmd_trace,
+};
+
+esp_err_t app_tracer_init(void)
+{
+    ESP_RETURN_ON_FALSE(s_events == NULL, ESP_ERR_INVALID_STATE, TAG, "already initialized");
+
+    // Round down to a power of two for the index mask
+    uint32_t n = 1;
+    while (n * 2 <= CONFIG_APP_TRACER_EVENTS) n *= 2;
+
+    // Internal RAM keeps recording cheap and off the PSRAM bus
+    s_events = heap_caps_calloc(n, sizeof(trace_event_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(s_events, ESP_ERR_NO_MEM, TAG, "trace buffer (%u events)", (unsigned)n);
+    s_mask = n - 1;
+    s_running = true;
+
+    ESP_LOGI(TAG, "Tracer ready (%u events, %u KB)", (unsigned)n, (unsigned)(n * sizeof(trace_event_t) / 1024));
+    return app_console_register(&s_cmd_trace);
+}
@@ -0,0 +1,61 @@
+/**
+ * @file app_tracer.h
+ * @brief In-RAM event tracer (begin/end/instant, microsecond timestamps)
+ *
+ * Fixed-size ring of 16-byte events recorded with a lock-free index, so it
+ * can be used from any task (and from ISRs). "trace dump" on the console
+ * prints the ring as text; tools/trace2chrome.py converts that into Chrome
+ * trace JSON (chrome://tracing, ui.perfetto.dev) with one row per task.
+ *
+ * The macros compile to nothing unless CONFIG_APP_TRACER_ENABLE is set.
+ * Names must be string literals (only the pointer is stored).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    APP_TRACE_PHASE_BEGIN = 'B',
+    APP_TRACE_PHASE_END = 'E',
+    APP_TRACE_PHASE_INSTANT = 'i',
+} app_trace_phase_t;
+
+#if CONFIG_APP_TRACER_ENABLE
+
+/**
+ * @brief Allocate the ring buffer and register the "trace" console command
+ *
+ * @return ESP_OK on success
+ */
+esp_err_t app_tracer_init(void);
+
+/**
+ * @brief Record one event (no-op until initialized or while stopped)
+ *
+ * @param name Static string
+ * @param phase Event phase
+ */
+void app_tracer_record(const char *name, app_trace_phase_t phase);
+
+#define APP_TRACE_BEGIN(name)   app_tracer_record((name), APP_TRACE_PHASE_BEGIN)
+#define APP_TRACE_END(name)     app_tracer_record((name), APP_TRACE_PHASE_END)
+#define APP_TRACE_INSTANT(name) app_tracer_record((name), APP_TRACE_PHASE_INSTANT)
+
+#else
+
+#define APP_TRACE_BEGIN(name)   do { } while (0)
+#define APP_TRACE_END(name)     do { } while (0)
+#define APP_TRACE_INSTANT(name) do { } while (0)
+
+#endif // CONFIG_APP_TRACER_ENABLE
+
+#ifdef __cplusplus
+}
+#endif
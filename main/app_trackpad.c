@@ -5,6 +5,8 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_lcd_touch.h"
+#include "app_tracer.h"
+#include "app_touch_read.h"
 
 static const char *TAG = "app_trackpad";
 
@@ -20,6 +22,11 @@ static volatile int32_t s_status_y = 0;
 static volatile bool s_status_touched = false;
 static volatile trackpad_zone_t s_status_zone = TRACKPAD_ZONE_MAIN;
 
+// Status change notification (poll task -> UI)
+static app_trackpad_status_cb_t s_status_cb = NULL;
+static void *s_status_cb_ctx = NULL;
+static bool s_status_notify = false;
+
 // Config
 static uint16_t s_hres = 0;
 static uint16_t s_vres = 0;
@@ -31,6 +38,36 @@ static float s_scroll_accum_v = 0.0f;
 static float s_scroll_accum_h = 0.0f;
 static trackpad_zone_t s_touch_start_zone = TRACKPAD_ZONE_MAIN;
 
+// Poll loop timing
+#define POLL_PERIOD_US  10000       // 100 Hz; an iteration must finish within one period
+#define SHED_HOLD_US    200000      // Keep shedding load this long after the last overrun
+
+static volatile bool s_loop_reset = true;
+static uint32_t s_loop_iterations = 0;
+static uint64_t s_loop_work_sum_us = 0;
+static uint32_t s_loop_work_max_us = 0;
+static uint32_t s_loop_period_max_us = 0;
+static int64_t s_loop_last_start = 0;
+static uint32_t s_loop_overruns = 0;
+static uint32_t s_loop_missed = 0;
+static uint32_t s_loop_shed = 0;
+static uint32_t s_loop_coalesced = 0;
+
+// Load shedding: while set, position-only UI updates are held back, moves
+// are merged instead of waiting for the HID endpoint, and overrun and
+// "HID busy" logging waits until the overload is over
+static bool s_shedding = false;
+static int64_t s_shed_until = 0;
+static int64_t s_shed_start = 0;
+static uint32_t s_shed_overruns = 0;
+static uint32_t s_shed_coalesced = 0;
+
+// Movement held back while the HID endpoint was busy (shedding only)
+static int32_t s_pend_dx = 0;
+static int32_t s_pend_dy = 0;
+static uint8_t s_pend_buttons = 0;
+static bool s_pend = false;
+
 // ========================== Helper Functions ==========================
 
 static uint32_t get_timestamp_ms(void)
@@ -38,6 +75,14 @@ static uint32_t get_timestamp_ms(void)
     return (uint32_t)(esp_timer_get_time() / 1000);
 }
 
+// Largest part of *acc that fits a report delta; the rest stays in *acc
+static int16_t take_delta(int32_t *acc)
+{
+    int32_t d = *acc > 127 ? 127 : (*acc < -127 ? -127 : *acc);
+    *acc -= d;
+    return (int16_t)d;
+}
+
 // ========================== Click Queue ==========================
 
 static volatile uint8_t s_pending_clicks = 0;
@@ -76,13 +121,173 @@ static void process_pending_clicks(uint32_t now)
     }
 }
 
+// ========================== Motion Upsampling ==========================
+
+#if CONFIG_APP_HID_TRACKPAD_UPSAMPLE
+// Touch samples come every 10 ms but the endpoint takes a report every 1 ms
+// (bInterval 1). Each sample's motion is spread over the frames until the
+// next poll, one slice per frame, with the sub-pixel remainder carried in
+// 24.8 fixed point. The host sees ten small steps instead of one big one.
+#define UPSAMPLE_SHIFT  8
+#define UPSAMPLE_ONE    (1 << UPSAMPLE_SHIFT)
+#define UPSAMPLE_SLOTS  (POLL_PERIOD_US / 1000)
+
+static int32_t s_up_rem_x = 0;      // Motion not yet sliced (24.8)
+static int32_t s_up_rem_y = 0;
+static int32_t s_up_carry_x = 0;    // Sliced but not yet sent (24.8)
+static int32_t s_up_carry_y = 0;
+static uint8_t s_up_slots = 0;      // Frames left until the next poll
+static uint8_t s_up_buttons = 0;
+
+static bool upsample_busy(void)
+{
+    return s_up_slots > 0 || s_up_carry_x / UPSAMPLE_ONE != 0 || s_up_carry_y / UPSAMPLE_ONE != 0;
+}
+
+// One frame: move the next slice into the carry and send its whole pixels.
+// The last slot takes all that is left, so nothing outlives the period
+// unless the endpoint was busy.
+static void upsample_step(void)
+{
+    if (s_up_slots > 0) {
+        int32_t sx = s_up_rem_x / s_up_slots;
+        int32_t sy = s_up_rem_y / s_up_slots;
+        s_up_rem_x -= sx;
+        s_up_rem_y -= sy;
+        s_up_carry_x += sx;
+        s_up_carry_y += sy;
+        s_up_slots--;
+    }
+
+    int32_t px = s_up_carry_x / UPSAMPLE_ONE;
+    int32_t py = s_up_carry_y / UPSAMPLE_ONE;
+    if ((px == 0 && py == 0) || !app_hid_trackpad_ready(s_hid)) {
+        return;     // Stays in the carry for the next frame
+    }
+    int16_t dx = take_delta(&px);
+    int16_t dy = take_delta(&py);
+    if (app_hid_trackpad_send_report(s_hid, s_up_buttons, dx, dy, 0, 0) == ESP_OK) {
+        s_up_carry_x -= dx * UPSAMPLE_ONE;
+        s_up_carry_y -= dy * UPSAMPLE_ONE;
+    }
+}
+
+// Send all motion still being spread, before a report that must not
+// overtake it. Only whole pixels ever enter, so nothing is left over. What
+// a failed send could not deliver goes back into the carry, and the next
+// frames retry it.
+static void upsample_flush(void)
+{
+    int32_t px = (s_up_rem_x + s_up_carry_x) / UPSAMPLE_ONE;
+    int32_t py = (s_up_rem_y + s_up_carry_y) / UPSAMPLE_ONE;
+    s_up_rem_x = 0;
+    s_up_rem_y = 0;
+    s_up_slots = 0;
+    while (px != 0 || py != 0) {
+        int16_t dx = take_delta(&px);
+        int16_t dy = take_delta(&py);
+        if (app_hid_trackpad_send_report(s_hid, s_up_buttons, dx, dy, 0, 0) != ESP_OK) {
+            px += dx;
+            py += dy;
+            break;
+        }
+    }
+    s_up_carry_x = px * UPSAMPLE_ONE;
+    s_up_carry_y = py * UPSAMPLE_ONE;
+}
+
+// New motion from the gesture engine, together with whatever the previous
+// sample has not sent yet, is spread over the coming frames. Only the first
+// slice (1/UPSAMPLE_SLOTS of it, once it reaches a whole pixel) goes out at
+// once; the rest follows over the next 9 ms, which is the latency cost.
+static void upsample_add(uint8_t buttons, int16_t dx, int16_t dy)
+{
+    if (buttons != s_up_buttons) {
+        upsample_flush();
+        s_up_buttons = buttons;
+    }
+    s_up_rem_x += dx * UPSAMPLE_ONE;
+    s_up_rem_y += dy * UPSAMPLE_ONE;
+    s_up_slots = UPSAMPLE_SLOTS;
+    upsample_step();
+}
+
+// Wait for the next poll. While there is motion to spread, wake every
+// 1 ms frame to send the next slice.
+static void upsample_sleep(TickType_t *last_wake, TickType_t poll_interval)
+{
+    const TickType_t frame = pdMS_TO_TICKS(1);
+    TickType_t slept = 0;
+    while (upsample_busy() && slept + frame < poll_interval) {
+        vTaskDelayUntil(last_wake, frame);
+        slept += frame;
+        upsample_step();
+    }
+    vTaskDelayUntil(last_wake, poll_interval - slept);
+}
+#endif
+
+// ========================== Report Coalescing ==========================
+
+// Send held-back movement; without wait, only if the endpoint is free now
+static void flush_pending(bool wait)
+{
+    while (s_pend) {
+        if (!wait && !app_hid_trackpad_ready(s_hid)) return;
+        int16_t dx = take_delta(&s_pend_dx);
+        int16_t dy = take_delta(&s_pend_dy);
+        if (app_hid_trackpad_send_report(s_hid, s_pend_buttons, dx, dy, 0, 0) != ESP_OK) {
+            s_pend_dx += dx;        // Keep it for the next try
+            s_pend_dy += dy;
+            return;
+        }
+        s_pend = s_pend_dx != 0 || s_pend_dy != 0;
+    }
+}
+
+// Movement report; while shedding it is merged into the pending delta
+// rather than blocking the loop on a busy endpoint
+static void send_motion(uint8_t buttons, int16_t dx, int16_t dy)
+{
+#if CONFIG_APP_HID_TRACKPAD_UPSAMPLE
+    // Shedding: one report per sample, no extra frames to fill
+    if (!s_shedding && !s_pend) {
+        upsample_add(buttons, dx, dy);
+        return;
+    }
+    upsample_flush();
+#endif
+    if (s_pend && buttons != s_pend_buttons) {
+        flush_pending(true);
+    }
+    if (s_shedding && (s_pend || !app_hid_trackpad_ready(s_hid))) {
+        s_pend_dx += dx;
+        s_pend_dy += dy;
+        s_pend_buttons = buttons;
+        s_pend = true;
+        s_loop_coalesced++;
+        s_shed_coalesced++;
+        flush_pending(false);
+        return;
+    }
+    app_hid_trackpad_send_report(s_hid, buttons, dx, dy, 0, 0);
+}
+
 // ========================== Action Executor ==========================
 
 static void execute_action(const trackpad_action_t *action, uint32_t now)
 {
+    // Button and scroll reports must not overtake held-back movement
+    if (action->type != TRACKPAD_ACTION_MOVE && action->type != TRACKPAD_ACTION_DRAG_MOVE) {
+        if (s_pend) flush_pending(true);
+#if CONFIG_APP_HID_TRACKPAD_UPSAMPLE
+        upsample_flush();
+#endif
+    }
+
     switch (action->type) {
         case TRACKPAD_ACTION_MOVE:
-            app_hid_trackpad_send_move(s_hid, action->dx, action->dy);
+            send_motion(0x00, action->dx, action->dy);
             break;
         case TRACKPAD_ACTION_CLICK_DOWN:
             queue_clicks(1, now);
@@ -100,7 +305,7 @@ static void execute_action(const trackpad_action_t *action, uint32_t now)
             app_hid_trackpad_send_click(s_hid, 0x01);
             break;
         case TRACKPAD_ACTION_DRAG_MOVE:
-            app_hid_trackpad_send_report(s_hid, 0x01, action->dx, action->dy, 0, 0);
+            send_motion(0x01, action->dx, action->dy);
             break;
         case TRACKPAD_ACTION_DRAG_END:
             app_hid_trackpad_send_click(s_hid, 0x00);
@@ -116,30 +321,92 @@ static void execute_action(const trackpad_action_t *action, uint32_t now)
     }
 }
 
+// ========================== Deadline Monitor ==========================
+
+// Called at the end of every iteration with its release time (the slot it
+// was scheduled for). Returns true if the deadline was missed.
+static bool deadline_check(int64_t release, int64_t end)
+{
+    if (end <= release + POLL_PERIOD_US) {
+        if (s_shedding && end >= s_shed_until) {
+            s_shedding = false;
+            flush_pending(true);
+            s_status_notify = true;     // Deliver the position updates held back
+            uint32_t busy = app_hid_trackpad_set_quiet(s_hid, false);
+            // Deferred until now so logging cannot add to the overload
+            ESP_LOGW(TAG, "Overload for %lld ms: %lu overruns, %lu moves coalesced, %lu HID sends failed (busy)",
+                     (long long)((end - s_shed_start) / 1000),
+                     (unsigned long)s_shed_overruns, (unsigned long)s_shed_coalesced, (unsigned long)busy);
+        }
+        return false;
+    }
+
+    s_loop_overruns++;
+    s_loop_missed += (uint32_t)((end - release) / POLL_PERIOD_US);
+#if CONFIG_APP_HID_TRACKPAD_LOAD_SHED
+    if (!s_shedding) {
+        s_shedding = true;
+        app_hid_trackpad_set_quiet(s_hid, true);
+        s_shed_start = end;
+        s_shed_overruns = 0;
+        s_shed_coalesced = 0;
+    }
+    s_shed_overruns++;
+    s_shed_until = end + SHED_HOLD_US;
+#endif
+    return true;
+}
+
 // ========================== Polling Task ==========================
 
 static void trackpad_poll_task(void *arg)
 {
     (void)arg;
-    const TickType_t poll_interval = pdMS_TO_TICKS(10); // 100Hz
+    const TickType_t poll_interval = pdMS_TO_TICKS(POLL_PERIOD_US / 1000);
 
     // Wait for system stabilize
     vTaskDelay(pdMS_TO_TICKS(500));
 
+    // Fixed-rate release: a slow iteration shortens the next sleep instead
+    // of stretching the period
+    TickType_t last_wake = xTaskGetTickCount();
+    int64_t release = esp_timer_get_time();
+
     static int32_t last_x = 0;
     static int32_t last_y = 0;
     static bool was_touched = false;
 
     while (1) {
         if (!s_touch || !s_hid) {
-            vTaskDelay(poll_interval);
+            vTaskDelayUntil(&last_wake, poll_interval);
+            release = esp_timer_get_time();
             continue;
         }
 
+        APP_TRACE_BEGIN("poll");
+        int64_t loop_start = esp_timer_get_time();
         uint32_t now = get_timestamp_ms();
 
+        if (s_loop_reset) {
+            s_loop_reset = false;
+            s_loop_iterations = 0;
+            s_loop_work_sum_us = 0;
+            s_loop_work_max_us = 0;
+            s_loop_period_max_us = 0;
+            s_loop_overruns = 0;
+            s_loop_missed = 0;
+            s_loop_shed = 0;
+            s_loop_coalesced = 0;
+        } else if (s_loop_last_start) {
+            uint32_t period = (uint32_t)(loop_start - s_loop_last_start);
+            if (period > s_loop_period_max_us) s_loop_period_max_us = period;
+        }
+        s_loop_last_start = loop_start;
+
         // Hardware poll
-        esp_lcd_touch_read_data(s_touch);
+        APP_TRACE_BEGIN("touch_read");
+        app_touch_read(s_touch);
+        APP_TRACE_END("touch_read");
         
         uint16_t x = 0, y = 0, strength = 0;
         uint8_t point_num = 0;
@@ -150,11 +417,27 @@ static void trackpad_poll_task(void *arg)
         x = s_hres - 1 - x;
         y = s_vres - 1 - y;
 
-        // Update shared state
+        // Held-back movement goes out first, as soon as the endpoint is free
+        if (s_pend) flush_pending(false);
+
+        // Update shared state. While shedding, only touch/zone changes reach
+        // the UI; position-only updates are delivered when shedding ends.
+        trackpad_zone_t zone = trackpad_get_zone(x, y, s_hres, s_vres, s_scroll_w, s_scroll_h);
+        if (touched != s_status_touched || zone != s_status_zone ||
+            (touched && !s_shedding && (x != s_status_x || y != s_status_y))) {
+            s_status_notify = true;
+        }
         s_status_x = x;
         s_status_y = y;
         s_status_touched = touched;
-        s_status_zone = trackpad_get_zone(x, y, s_hres, s_vres, s_scroll_w, s_scroll_h);
+        s_status_zone = zone;
+
+        // Tell the UI only when something changed; an undelivered notice
+        // (UI busy) is retried next iteration
+        app_trackpad_status_cb_t status_cb = s_status_cb;
+        if (s_status_notify && status_cb) {
+            s_status_notify = !status_cb(s_status_cb_ctx);
+        }
 
         // Handle scroll zones vs main trackpad area
         trackpad_action_t action;
@@ -209,6 +492,7 @@ static void trackpad_poll_task(void *arg)
             input.x = x;
             input.y = y;
             input.timestamp_ms = now;
+            input.strength = strength;
             bool process = false;
 
             if (touched && !was_touched) {
@@ -225,7 +509,10 @@ static void trackpad_poll_task(void *arg)
             }
 
             if (process) {
-                if (trackpad_process_input(&s_gesture_state, &input, &action)) {
+                APP_TRACE_BEGIN("gesture");
+                bool has_action = trackpad_process_input(&s_gesture_state, &input, &action);
+                APP_TRACE_END("gesture");
+                if (has_action) {
                     execute_action(&action, now);
                 }
             }
@@ -245,7 +532,26 @@ static void trackpad_poll_task(void *arg)
         }
         was_touched = touched;
 
-        vTaskDelay(poll_interval);
+        int64_t end = esp_timer_get_time();
+        uint32_t work = (uint32_t)(end - loop_start);
+        s_loop_iterations++;
+        s_loop_work_sum_us += work;
+        if (work > s_loop_work_max_us) s_loop_work_max_us = work;
+        if (s_shedding) s_loop_shed++;
+        APP_TRACE_END("poll");
+
+        if (deadline_check(release, end)) {
+            APP_TRACE_INSTANT("poll_overrun");
+            // Drop the slots already missed rather than running them back to back
+            last_wake = xTaskGetTickCount();
+            release = end;
+        }
+        release += POLL_PERIOD_US;
+#if CONFIG_APP_HID_TRACKPAD_UPSAMPLE
+        upsample_sleep(&last_wake, poll_interval);
+#else
+        vTaskDelayUntil(&last_wake, poll_interval);
+#endif
     }
 }
 
@@ -275,7 +581,11 @@ esp_err_t app_trackpad_init(const app_trackpad_cfg_t *cfg)
         return ESP_FAIL;
     }
 
+#if CONFIG_APP_HID_TRACKPAD_UPSAMPLE
+    ESP_LOGI(TAG, "Trackpad service started (100Hz, Prio 10, motion upsampled to 1 kHz)");
+#else
     ESP_LOGI(TAG, "Trackpad service started (100Hz, Prio 10)");
+#endif
     return ESP_OK;
 }
 
@@ -289,6 +599,14 @@ void app_trackpad_get_status(app_trackpad_status_t *status)
     }
 }
 
+void app_trackpad_set_status_cb(app_trackpad_status_cb_t cb, void *ctx)
+{
+    s_status_cb = NULL;
+    s_status_cb_ctx = ctx;
+    s_status_notify = (cb != NULL);  // deliver the current state once
+    s_status_cb = cb;
+}
+
 void app_trackpad_update_config(int32_t scroll_w, int32_t scroll_h)
 {
     s_scroll_w = scroll_w;
@@ -296,3 +614,22 @@ void app_trackpad_update_config(int32_t scroll_w, int32_t scroll_h)
     // Note: trackpad_state_init updates the internal gesture config too
     trackpad_state_init(&s_gesture_state, s_hres, s_vres, s_scroll_w, s_scroll_h);
 }
+
+void app_trackpad_get_loop_stats(app_trackpad_loop_stats_t *out)
+{
+    if (!out) return;
+    uint32_t n = s_loop_iterations;
+    out->iterations = n;
+    out->work_avg_us = n ? (uint32_t)(s_loop_work_sum_us / n) : 0;
+    out->work_max_us = s_loop_work_max_us;
+    out->period_max_us = s_loop_period_max_us;
+    out->overruns = s_loop_overruns;
+    out->missed = s_loop_missed;
+    out->shed = s_loop_shed;
+    out->coalesced = s_loop_coalesced;
+}
+
+void app_trackpad_reset_loop_stats(void)
+{
+    s_loop_reset = true;
+}
@@ -47,6 +47,26 @@ esp_err_t app_trackpad_init(const app_trackpad_cfg_t *cfg);
  */
 void app_trackpad_get_status(app_trackpad_status_t *status);
 
+/**
+ * @brief Status change notification
+ *
+ * Called from the poll task when touched, zone or (while touched) position
+ * changes. Must not block; the usual job is to hand the update to the UI.
+ *
+ * @param ctx Context given to app_trackpad_set_status_cb()
+ * @return false if the notification could not be delivered right now;
+ *         it is then retried on the next poll
+ */
+typedef bool (*app_trackpad_status_cb_t)(void *ctx);
+
+/**
+ * @brief Register the status change notification (NULL to remove)
+ *
+ * @param cb Callback, runs in the poll task
+ * @param ctx Passed to cb
+ */
+void app_trackpad_set_status_cb(app_trackpad_status_cb_t cb, void *ctx);
+
 /**
  * @brief Update configuration (e.g. scroll zones) at runtime
  * 
@@ -55,6 +75,38 @@ void app_trackpad_get_status(app_trackpad_status_t *status);
  */
 void app_trackpad_update_config(int32_t scroll_w, int32_t scroll_h);
 
+/**
+ * @brief Poll loop timing (for latency measurements)
+ *
+ * Each iteration is released on a fixed 10 ms grid and must finish before
+ * the next release. An overrun starts load shedding (when
+ * CONFIG_APP_HID_TRACKPAD_LOAD_SHED is set) until 200 ms pass without one:
+ * position-only UI updates and overrun logging are held back, and
+ * movement is merged while the HID endpoint is busy instead of waiting.
+ */
+typedef struct {
+    uint32_t iterations;
+    uint32_t work_avg_us;    // Time spent per iteration (read + gesture + HID)
+    uint32_t work_max_us;
+    uint32_t period_max_us;  // Longest gap between iteration starts (nominal 10 ms)
+    uint32_t overruns;       // Iterations that finished after their deadline
+    uint32_t missed;         // Poll slots skipped because of overruns
+    uint32_t shed;           // Iterations run with load shedding active
+    uint32_t coalesced;      // Movement reports merged instead of sent
+} app_trackpad_loop_stats_t;
+
+/**
+ * @brief Get poll loop timing since the last reset
+ *
+ * @param out Stats structure to fill
+ */
+void app_trackpad_get_loop_stats(app_trackpad_loop_stats_t *out);
+
+/**
+ * @brief Restart poll loop timing (applied at the next iteration)
+ */
+void app_trackpad_reset_loop_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,7 +1,7 @@
 // Auto-configured LovyanGFX configuration from Kconfig
 //
-// NOTE: For RGB panels, use custom config (lgfx_elecrow_7inch.hpp) instead
-// The auto-config currently only supports SPI panels
+// Both panel types are built from the APP_LCD_* options: SPI (ILI9341) and
+// 16-bit parallel RGB (Panel_RGB + Bus_RGB). No board-specific header needed.
 
 #pragma once
 
@@ -96,9 +96,16 @@ public:
 
 #elif CONFIG_APP_LGFX_PANEL_RGB
 
+// Panel_RGB with its framebuffer rows exposed, so LVGL can render into them
+class Panel_RGB_FB : public lgfx::Panel_RGB
+{
+public:
+    uint8_t **lines(void) const { return _lines_buffer; }
+};
+
 class LGFX : public lgfx::LGFX_Device
 {
-    lgfx::Panel_RGB     _panel_instance;
+    Panel_RGB_FB        _panel_instance;
     lgfx::Bus_RGB       _bus_instance;
     lgfx::Light_PWM     _light_instance;
 
@@ -133,9 +140,9 @@ public:
             cfg.pin_hsync   = CONFIG_APP_LCD_RGB_PIN_HSYNC;  // HSYNC
             cfg.pin_pclk    = CONFIG_APP_LCD_RGB_PIN_PCLK;   // PCLK
 
-            cfg.freq_write = CONFIG_APP_LCD_RGB_PCLK_HZ;  // 15 MHz pixel clock
+            cfg.freq_write = CONFIG_APP_LCD_RGB_PCLK_HZ;
 
-            // Timing parameters for 800x480 display
+            // Timing parameters
             cfg.hsync_polarity    = CONFIG_APP_LCD_RGB_HSYNC_POLARITY;
             cfg.hsync_front_porch = CONFIG_APP_LCD_RGB_HSYNC_FRONT_PORCH;
             cfg.hsync_pulse_width = CONFIG_APP_LCD_RGB_HSYNC_PULSE_WIDTH;
@@ -170,10 +177,10 @@ public:
                 cfg.invert = false;
             #endif
 
-            cfg.memory_width  = 800;
-            cfg.memory_height = 480;
-            cfg.panel_width   = 800;
-            cfg.panel_height  = 480;
+            cfg.memory_width  = CONFIG_APP_LCD_HRES;
+            cfg.memory_height = CONFIG_APP_LCD_VRES;
+            cfg.panel_width   = CONFIG_APP_LCD_HRES;
+            cfg.panel_height  = CONFIG_APP_LCD_VRES;
 
             cfg.offset_x = 0;
             cfg.offset_y = 0;
@@ -188,20 +195,27 @@ public:
             _panel_instance.config(cfg);
         }
 
+        if (CONFIG_APP_LCD_PIN_BL >= 0) {
+        #ifdef CONFIG_APP_LCD_BL_PWM_ENABLE
         {
             auto cfg = _light_instance.config();
 
-            cfg.pin_bl = GPIO_NUM_2;      // Backlight PWM pin
+            cfg.pin_bl = CONFIG_APP_LCD_PIN_BL;      // Backlight PWM pin
             cfg.invert = false;
-            cfg.freq   = 5000;            // 5 kHz PWM
+            cfg.freq   = CONFIG_APP_LCD_BL_PWM_FREQ_HZ;
             cfg.pwm_channel = 0;
 
             _light_instance.config(cfg);
             _panel_instance.setLight(&_light_instance);
         }
+        #endif
+        }
 
         setPanel(&_panel_instance);
     }
+
+    // Framebuffer row pointers (NULL before init())
+    uint8_t **frameLines(void) const { return _panel_instance.lines(); }
 };
 
 #endif
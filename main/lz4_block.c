@@ -0,0 +1,67 @@
+/**
+ * @file lz4_block.c
+ * @brief LZ4 block-format decoder (framework-independent)
+ */
+
+#include "lz4_block.h"
+
+#include <string.h>
+
+// Length continuation bytes: 255 means "add and keep reading"
+static int read_len(const uint8_t **ip, const uint8_t *iend, size_t *len)
+{
+    uint8_t b;
+    do {
+        if (*ip >= iend) return -1;
+        b = *(*ip)++;
+        *len += b;
+    } while (b == 255);
+    return 0;
+}
+
+int lz4_block_decompress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap)
+{
+    if (!src || !dst) return -1;
+
+    const uint8_t *ip = src;
+    const uint8_t *iend = src + src_len;
+    uint8_t *op = dst;
+    uint8_t *oend = dst + dst_cap;
+
+    while (ip < iend) {
+        uint8_t token = *ip++;
+
+        // Literals
+        size_t lit = token >> 4;
+        if (lit == 15 && read_len(&ip, iend, &lit) != 0) return -1;
+        if ((size_t)(iend - ip) < lit || (size_t)(oend - op) < lit) return -1;
+        memcpy(op, ip, lit);
+        op += lit;
+        ip += lit;
+
+        // The last sequence carries literals only
+        if (ip >= iend) break;
+
+        // Match
+        if (iend - ip < 2) return -1;
+        size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - dst)) return -1;
+
+        size_t mlen = token & 0x0F;
+        if (mlen == 15 && read_len(&ip, iend, &mlen) != 0) return -1;
+        mlen += 4;
+        if ((size_t)(oend - op) < mlen) return -1;
+
+        const uint8_t *match = op - offset;
+        if (offset >= mlen) {
+            memcpy(op, match, mlen);
+            op += mlen;
+        } else {
+            // Overlapping copy (run-length style repeats)
+            while (mlen--) *op++ = *match++;
+        }
+    }
+
+    return (int)(op - dst);
+}
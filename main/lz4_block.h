@@ -0,0 +1,40 @@
+/**
+ * @file lz4_block.h
+ * @brief LZ4 block-format decoder (framework-independent)
+ *
+ * Decodes raw LZ4 blocks (no frame header, no checksums) as produced by
+ * lz4.block.compress(data, store_size=False) or tools/ota_push.py.
+ * Every read and write is bounds-checked, so corrupt or hostile input
+ * fails cleanly instead of overrunning the output buffer.
+ *
+ * No ESP-IDF dependencies (host-compilable).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Worst-case compressed size of a block of n bytes
+ */
+#define LZ4_BLOCK_BOUND(n) ((n) + ((n) / 255) + 16)
+
+/**
+ * @brief Decompress one LZ4 block
+ *
+ * @param src Compressed data
+ * @param src_len Compressed length
+ * @param dst Output buffer
+ * @param dst_cap Output buffer capacity
+ * @return Decompressed length, or -1 if the input is malformed or does not fit
+ */
+int lz4_block_decompress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap);
+
+#ifdef __cplusplus
+}
+#endif
@@ -9,6 +9,7 @@
 #include "esp_chip_info.h"
 #include "esp_flash.h"
 #include "esp_system.h"
+#include "esp_heap_caps.h"
 
 #if CONFIG_APP_DISPLAY_ILI9341_SPI
     #include "app_display_ili9341.h"
@@ -16,12 +17,16 @@
     #include "app_display_rgb.h"
 #elif CONFIG_APP_DISPLAY_LGFX
     #include "app_display_lgfx.h"
+#elif CONFIG_APP_DISPLAY_VIRTUAL
+    #include "app_display_virtual.h"
 #endif
 
 #if CONFIG_APP_TOUCH_FT6X36_I2C
     #include "app_touch_ft6x36.h"
 #elif CONFIG_APP_TOUCH_GT911_I2C
     #include "app_touch_gt911.h"
+#elif CONFIG_APP_TOUCH_VIRTUAL
+    #include "app_touch_virtual.h"
 #endif
 
 #if CONFIG_APP_HID_MODE_TRACKPAD
@@ -45,6 +50,34 @@
 #endif
 #include "demos/lv_demos.h" 
 
+#if CONFIG_APP_CONSOLE_ENABLE
+    #include "app_console.h"
+#endif
+#if CONFIG_APP_BENCH_ENABLE
+    #include "app_bench.h"
+#endif
+#if CONFIG_APP_STRESS_ENABLE
+    #include "app_stress.h"
+#endif
+#if CONFIG_APP_SYSMON_ENABLE
+    #include "app_sysmon.h"
+#endif
+#if CONFIG_APP_LVBENCH_CAPTURE
+    #include "app_lvbench.h"
+#endif
+#if CONFIG_APP_TRACER_ENABLE
+    #include "app_tracer.h"
+#endif
+#if CONFIG_APP_OTA_ENABLE
+    #include "app_ota.h"
+#endif
+#if CONFIG_APP_HOST_DISPLAY_ENABLE
+    #include "app_host_display.h"
+#endif
+#if CONFIG_APP_MIRROR_ENABLE
+    #include "app_mirror.h"
+#endif
+
 static const char *TAG = "app_main";
 
 static void ui_simple_start(void)
@@ -93,6 +126,11 @@ void app_main(void)
              CONFIG_IDF_TARGET, chip_info.cores, chip_info.revision,
              flash_size / (uint32_t)(1024 * 1024));
 
+#if CONFIG_APP_TRACER_ENABLE
+    // Start recording before anything else so bring-up shows on the timeline
+    ESP_ERROR_CHECK(app_tracer_init());
+#endif
+
     // Display
     app_display_t disp_hw = {0};
     ESP_ERROR_CHECK(app_display_init(&disp_hw));
@@ -115,7 +153,7 @@ void app_main(void)
     // Touch (optional)
     app_touch_t touch = {0};
     esp_lcd_touch_handle_t tp = NULL;
-#if CONFIG_APP_TOUCH_FT6X36_I2C || CONFIG_APP_TOUCH_GT911_I2C
+#if CONFIG_APP_TOUCH_FT6X36_I2C || CONFIG_APP_TOUCH_GT911_I2C || CONFIG_APP_TOUCH_VIRTUAL
     if (app_touch_init(&touch) == ESP_OK) tp = touch.tp;
     else ESP_LOGW(TAG, "Touch init failed; continuing without touch");
 #endif
@@ -160,6 +198,11 @@ void app_main(void)
             .cycle_orientation = app_display_cycle_orientation,
         #endif
         .ctx = NULL,
+    #elif CONFIG_APP_DISPLAY_VIRTUAL
+        .title = "HW Test Virtual Panel (LVGL)",
+        .set_invert = app_display_set_invert,
+        .cycle_orientation = NULL,
+        .ctx = NULL,
     #else
         // Unknown display type - disable features to be safe
         .title = "HW Test Unknown",
@@ -175,6 +218,13 @@ void app_main(void)
     };
 
     lvgl_port_lock(0);
+
+    // UI heap footprint: internal RAM (CLIB malloc) plus LVGL's own pool (builtin malloc)
+    size_t ui_heap_free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    lv_mem_monitor_t ui_mon;
+    lv_mem_monitor(&ui_mon);
+    size_t ui_lv_used = ui_mon.total_size - ui_mon.free_size;
+
 #if CONFIG_APP_UI_SIMPLE
     ESP_LOGI(TAG, "Running Simple UI (LVGL)");
     ui_simple_start();
@@ -221,7 +271,58 @@ void app_main(void)
     gamepad_cfg_t cfg = {CONFIG_APP_LCD_HRES, CONFIG_APP_LCD_VRES, &hid};
     ui_gamepad_init(&cfg);
 #endif
+    size_t ui_heap_used = ui_heap_free - heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    lv_mem_monitor(&ui_mon);
     lvgl_port_unlock();
+    ESP_LOGI(TAG, "UI heap: %d bytes internal, %d bytes LVGL pool",
+             (int)ui_heap_used, (int)((ui_mon.total_size - ui_mon.free_size) - ui_lv_used));
+
+#if CONFIG_APP_CONSOLE_ENABLE
+    // Diagnostics console (bench, ...)
+    ESP_ERROR_CHECK(app_console_init());
+#if CONFIG_APP_BENCH_ENABLE
+    app_bench_cfg_t bench_cfg = {
+        .panel = disp_hw.panel,
+        .touch = tp,
+    #if !defined(CONFIG_APP_HID_MODE_NONE)
+        .hid = &hid,
+    #endif
+        .disp = lv.disp,
+    };
+    ESP_ERROR_CHECK(app_bench_init(&bench_cfg));
+#endif
+#if CONFIG_APP_STRESS_ENABLE
+    app_stress_cfg_t stress_cfg = {
+        .touch = tp,
+    #if !defined(CONFIG_APP_HID_MODE_NONE)
+        .hid = &hid,
+    #endif
+        .disp = lv.disp,
+    };
+    ESP_ERROR_CHECK(app_stress_init(&stress_cfg));
+#endif
+#if CONFIG_APP_SYSMON_ENABLE
+    ESP_ERROR_CHECK(app_sysmon_init(lv.disp));
+#endif
+#if CONFIG_APP_LVBENCH_CAPTURE
+    // The benchmark logs its results table when it finishes; the console
+    // has to be up by then, not when the demo starts
+    ESP_ERROR_CHECK(app_lvbench_start(lv.disp));
+#endif
+#if CONFIG_APP_OTA_ENABLE
+    ESP_ERROR_CHECK(app_ota_init());
+#endif
+#if CONFIG_APP_HOST_DISPLAY_ENABLE
+    app_host_display_cfg_t host_cfg = {
+        .panel = disp_hw.panel,
+        .disp = lv.disp,
+    };
+    ESP_ERROR_CHECK(app_host_display_init(&host_cfg));
+#endif
+#if CONFIG_APP_MIRROR_ENABLE
+    ESP_ERROR_CHECK(app_mirror_init(lv.disp));
+#endif
+#endif
 
     ESP_LOGI(TAG, "Running.");
     while (true) vTaskDelay(pdMS_TO_TICKS(1000));
@@ -0,0 +1,86 @@
+/**
+ * @file ota_stream.h
+ * @brief Firmware update stream framing (framework-independent)
+ *
+ * The host splits the image into blocks of at most OTA_BLOCK_MAX bytes and
+ * sends each as one frame:
+ *
+ *   offset size  field
+ *   0      2     magic 'O','F'
+ *   2      1     flags (OTA_FLAG_*)
+ *   3      1     reserved (0)
+ *   4      2     payload_len  bytes following the header (LE)
+ *   6      2     raw_len      bytes after decompression (LE)
+ *   8      4     crc32        IEEE CRC-32 of the raw (decompressed) block (LE)
+ *
+ * Payload is an LZ4 block when OTA_FLAG_LZ4 is set, otherwise stored as-is.
+ * A frame with OTA_FLAG_END and no payload terminates the stream.
+ *
+ * No ESP-IDF dependencies (host-compilable); see app_ota.c for the device
+ * side and tools/ota_push.py for the host side.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OTA_FRAME_HDR_LEN 12
+#define OTA_BLOCK_MAX     4096
+
+#define OTA_FLAG_LZ4 0x01
+#define OTA_FLAG_END 0x02
+
+typedef enum {
+    OTA_STREAM_OK = 0,
+    OTA_STREAM_ERR_MAGIC,       // Header magic mismatch (lost sync)
+    OTA_STREAM_ERR_LENGTH,      // Length fields out of range
+    OTA_STREAM_ERR_DECOMPRESS,  // Malformed LZ4 block or wrong raw length
+    OTA_STREAM_ERR_CRC,         // Raw block CRC mismatch
+} ota_stream_err_t;
+
+typedef struct {
+    uint8_t flags;
+    uint16_t payload_len;
+    uint16_t raw_len;
+    uint32_t crc32;
+} ota_frame_hdr_t;
+
+/**
+ * @brief Parse and validate a frame header
+ *
+ * @param buf OTA_FRAME_HDR_LEN bytes
+ * @param out Parsed header
+ * @return OTA_STREAM_OK or error
+ */
+ota_stream_err_t ota_frame_parse_hdr(const uint8_t *buf, ota_frame_hdr_t *out);
+
+/**
+ * @brief Decode a frame payload into raw image bytes and verify its CRC
+ *
+ * @param hdr Parsed header
+ * @param payload hdr->payload_len bytes
+ * @param out Output buffer (at least OTA_BLOCK_MAX bytes)
+ * @return OTA_STREAM_OK or error
+ */
+ota_stream_err_t ota_frame_decode(const ota_frame_hdr_t *hdr, const uint8_t *payload, uint8_t *out);
+
+/**
+ * @brief IEEE 802.3 CRC-32 (same as zlib.crc32)
+ *
+ * @param crc Previous value (0 to start)
+ */
+uint32_t ota_crc32(uint32_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief Human readable error name
+ */
+const char *ota_stream_err_str(ota_stream_err_t err);
+
+#ifdef __cplusplus
+}
+#endif
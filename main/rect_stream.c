@@ -0,0 +1,256 @@
+/**
+ * @file rect_stream.c
+ * @brief RGB565 rectangle stream framing and RLE codec (framework-independent)
+ */
+
+#include "rect_stream.h"
+
+#include <string.h>
+
+static uint16_t rd16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t rd32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+rect_stream_err_t rect_parse_hdr(const uint8_t *buf, rect_hdr_t *out)
+{
+    if (buf[0] != 'D' || buf[1] != 'R') {
+        return RECT_STREAM_ERR_MAGIC;
+    }
+
+    out->codec = buf[2];
+    out->flags = buf[3];
+    out->x = rd16(buf + 4);
+    out->y = rd16(buf + 6);
+    out->w = rd16(buf + 8);
+    out->h = rd16(buf + 10);
+    out->payload_len = rd32(buf + 12);
+
+    uint32_t px = (uint32_t)out->w * out->h;
+    if (px == 0) {
+        return out->payload_len == 0 ? RECT_STREAM_OK : RECT_STREAM_ERR_LENGTH;
+    }
+
+    switch (out->codec) {
+        case RECT_CODEC_RAW565:
+            return out->payload_len == px * 2 ? RECT_STREAM_OK : RECT_STREAM_ERR_LENGTH;
+        case RECT_CODEC_RLE565:
+            // Smallest payload: one control byte plus one pixel
+            if (out->payload_len < 3 || out->payload_len > RECT_RLE_BOUND(px)) {
+                return RECT_STREAM_ERR_LENGTH;
+            }
+            return RECT_STREAM_OK;
+        default:
+            return RECT_STREAM_ERR_CODEC;
+    }
+}
+
+void rect_write_hdr(const rect_hdr_t *hdr, uint8_t *buf)
+{
+    buf[0] = 'D';
+    buf[1] = 'R';
+    buf[2] = hdr->codec;
+    buf[3] = hdr->flags;
+    const uint16_t f[4] = {hdr->x, hdr->y, hdr->w, hdr->h};
+    for (int i = 0; i < 4; i++) {
+        buf[4 + 2 * i] = (uint8_t)f[i];
+        buf[5 + 2 * i] = (uint8_t)(f[i] >> 8);
+    }
+    for (int i = 0; i < 4; i++) {
+        buf[12 + i] = (uint8_t)(hdr->payload_len >> (8 * i));
+    }
+}
+
+// ========================== Decoder ==========================
+
+// Move the output cursor n pixels on; n never crosses the end of a row
+static void advance(rect_decoder_t *dec, uint16_t n)
+{
+    dec->col += n;
+    if (dec->col < dec->w) {
+        dec->out += n;
+        return;
+    }
+    dec->col = 0;
+    dec->row++;
+    dec->out = dec->row < dec->h ? dec->row_fn(dec->ctx, dec->row) : NULL;
+}
+
+static uint16_t row_room(const rect_decoder_t *dec, uint32_t want)
+{
+    uint32_t room = (uint32_t)(dec->w - dec->col);
+    return (uint16_t)(want < room ? want : room);
+}
+
+void rect_decoder_init(rect_decoder_t *dec, const rect_hdr_t *hdr, rect_row_fn row_fn, void *ctx)
+{
+    memset(dec, 0, sizeof(*dec));
+    dec->codec = hdr->codec;
+    dec->w = hdr->w;
+    dec->h = hdr->h;
+    dec->row_fn = row_fn;
+    dec->ctx = ctx;
+    if (dec->codec == RECT_CODEC_RAW565) {
+        // One literal packet covering the whole rectangle
+        dec->left = (uint32_t)hdr->w * hdr->h;
+    }
+    dec->out = row_fn(ctx, 0);
+}
+
+rect_stream_err_t rect_decoder_feed(rect_decoder_t *dec, const uint8_t *data, size_t len)
+{
+    size_t i = 0;
+
+    while (i < len) {
+        if (dec->left == 0) {
+            if (dec->codec == RECT_CODEC_RAW565) {
+                return RECT_STREAM_ERR_OVERFLOW;
+            }
+            uint8_t c = data[i++];
+            dec->run = (c & 0x80) != 0;
+            dec->left = (uint32_t)(c & 0x7F) + 1;
+            continue;
+        }
+        if (!dec->out) {
+            return RECT_STREAM_ERR_OVERFLOW;
+        }
+
+        if (!dec->run && !dec->have_lo && len - i >= 2) {
+            // Literal fast path: whole pixels straight from the input
+            uint32_t avail = (uint32_t)((len - i) / 2);
+            uint16_t n = row_room(dec, dec->left < avail ? dec->left : avail);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            memcpy(dec->out, data + i, (size_t)n * 2);
+#else
+            for (uint16_t k = 0; k < n; k++) {
+                dec->out[k] = rd16(data + i + 2 * k);
+            }
+#endif
+            i += (size_t)n * 2;
+            dec->left -= n;
+            advance(dec, n);
+            continue;
+        }
+
+        // Pixel value split across chunks (or a run's value)
+        uint16_t px;
+        if (dec->have_lo) {
+            px = (uint16_t)(dec->lo | (data[i++] << 8));
+            dec->have_lo = false;
+        } else if (len - i >= 2) {
+            px = rd16(data + i);
+            i += 2;
+        } else {
+            dec->lo = data[i++];
+            dec->have_lo = true;
+            continue;
+        }
+
+        if (dec->run) {
+            // Emit the whole run now; it may end exactly at the end of the chunk
+            while (dec->left && dec->out) {
+                uint16_t n = row_room(dec, dec->left);
+                uint16_t *o = dec->out;
+                for (uint16_t k = 0; k < n; k++) {
+                    o[k] = px;
+                }
+                dec->left -= n;
+                advance(dec, n);
+            }
+            if (dec->left) {
+                return RECT_STREAM_ERR_OVERFLOW;
+            }
+        } else {
+            *dec->out = px;
+            dec->left--;
+            advance(dec, 1);
+        }
+    }
+    return RECT_STREAM_OK;
+}
+
+rect_stream_err_t rect_decoder_finish(const rect_decoder_t *dec)
+{
+    if (dec->out || dec->left || dec->have_lo) {
+        return RECT_STREAM_ERR_SHORT;
+    }
+    return RECT_STREAM_OK;
+}
+
+// ========================== Encoder ==========================
+
+static uint8_t *put_literals(uint8_t *o, const uint16_t *px, uint16_t n)
+{
+    while (n) {
+        uint16_t k = n < 128 ? n : 128;
+        *o++ = (uint8_t)(k - 1);
+        for (uint16_t i = 0; i < k; i++) {
+            *o++ = (uint8_t)px[i];
+            *o++ = (uint8_t)(px[i] >> 8);
+        }
+        px += k;
+        n -= k;
+    }
+    return o;
+}
+
+size_t rect_encode_delta_row(const uint16_t *cur, const uint16_t *prev, uint16_t w, uint8_t *out)
+{
+    uint8_t *o = out;
+    uint16_t lit = 0;   // Start of pending literals
+    uint16_t i = 0;
+
+    while (i < w) {
+        uint16_t j = i;
+        if (prev) {
+            while (j < w && cur[j] == prev[j]) j++;
+        }
+        // A lone unchanged pixel costs as much to skip as to resend
+        if (j - i >= 2) {
+            o = put_literals(o, cur + lit, i - lit);
+            for (uint16_t n = j - i; n; ) {
+                uint16_t k = n < 64 ? n : 64;
+                *o++ = (uint8_t)(0xC0 | (k - 1));
+                n -= k;
+            }
+            i = lit = j;
+            continue;
+        }
+
+        j = i + 1;
+        while (j < w && cur[j] == cur[i]) j++;
+        if (j - i >= 3) {
+            o = put_literals(o, cur + lit, i - lit);
+            for (uint16_t n = j - i; n; ) {
+                uint16_t k = n < 64 ? n : 64;
+                *o++ = (uint8_t)(0x80 | (k - 1));
+                *o++ = (uint8_t)cur[i];
+                *o++ = (uint8_t)(cur[i] >> 8);
+                n -= k;
+            }
+            i = lit = j;
+            continue;
+        }
+        i++;
+    }
+    o = put_literals(o, cur + lit, w - lit);
+    return (size_t)(o - out);
+}
+
+const char *rect_stream_err_str(rect_stream_err_t err)
+{
+    switch (err) {
+        case RECT_STREAM_OK: return "ok";
+        case RECT_STREAM_ERR_MAGIC: return "bad_magic";
+        case RECT_STREAM_ERR_CODEC: return "bad_codec";
+        case RECT_STREAM_ERR_LENGTH: return "bad_length";
+        case RECT_STREAM_ERR_OVERFLOW: return "overflow";
+        case RECT_STREAM_ERR_SHORT: return "short_payload";
+        default: return "unknown";
+    }
+}
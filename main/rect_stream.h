@@ -0,0 +1,163 @@
+/**
+ * @file rect_stream.h
+ * @brief RGB565 rectangle stream framing and RLE codec (framework-independent)
+ *
+ * Each rectangle is sent as a 16-byte header followed by its pixel payload:
+ *
+ *   offset size  field
+ *   0      2     magic 'D','R'
+ *   2      1     codec (RECT_CODEC_*)
+ *   3      1     flags (RECT_FLAG_*)
+ *   4      2     x   (LE)
+ *   6      2     y   (LE)
+ *   8      2     w   (LE)
+ *   10     2     h   (LE)
+ *   12     4     payload_len  bytes following the header (LE)
+ *
+ * Pixels are RGB565 little-endian, row-major within the rectangle.
+ * A header with w == 0 or h == 0 carries no pixels; it is used for
+ * RECT_FLAG_PRESENT (frame boundary / keepalive) and RECT_FLAG_END.
+ *
+ * RLE565 payload is a sequence of packets, each starting with a control byte c:
+ *   c & 0x80   run: (c & 0x7F) + 1 copies of the one pixel that follows
+ *   otherwise  literal: c + 1 pixels follow
+ * Packets may span rows but not rectangles.
+ *
+ * DELTA565 (device to host only, used by screen mirroring) adds "skip":
+ *   c < 0x80          literal: c + 1 pixels follow
+ *   0x80 <= c < 0xC0  run: (c & 0x3F) + 1 copies of the one pixel that follows
+ *   c >= 0xC0         skip: (c & 0x3F) + 1 pixels unchanged from the previous frame
+ * The device encodes it row by row, so its packets never span rows.
+ *
+ * The decoder is incremental: payload bytes can be fed in chunks of any size
+ * (a packet or even a pixel may straddle two chunks) and pixels are written
+ * straight to caller-provided rows, so a rectangle can be decoded into a
+ * framebuffer without an intermediate copy.
+ *
+ * No ESP-IDF dependencies (host-compilable); see app_host_display.c for the
+ * device side and tools/display_push.py for the host side.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RECT_HDR_LEN 16
+
+#define RECT_CODEC_RAW565 0
+#define RECT_CODEC_RLE565 1
+#define RECT_CODEC_DELTA565 2   // Encoder only; rect_parse_hdr() rejects it
+
+#define RECT_FLAG_PRESENT 0x01  // Last rectangle of a frame; device acknowledges
+#define RECT_FLAG_END     0x02  // End of session
+
+/**
+ * @brief Worst-case RLE565 payload for n pixels (all literals)
+ */
+#define RECT_RLE_BOUND(n) ((n) * 2 + ((n) + 127) / 128)
+
+/**
+ * @brief Worst-case DELTA565 payload for a w x h rectangle (all literals)
+ */
+#define RECT_DELTA_BOUND(w, h) ((size_t)(h) * ((((w) + 127) / 128) + (size_t)(w) * 2))
+
+typedef enum {
+    RECT_STREAM_OK = 0,
+    RECT_STREAM_ERR_MAGIC,      // Header magic mismatch (lost sync)
+    RECT_STREAM_ERR_CODEC,      // Unknown codec
+    RECT_STREAM_ERR_LENGTH,     // payload_len inconsistent with w*h
+    RECT_STREAM_ERR_OVERFLOW,   // Payload decodes to more than w*h pixels
+    RECT_STREAM_ERR_SHORT,      // Payload ended before w*h pixels
+} rect_stream_err_t;
+
+typedef struct {
+    uint8_t codec;
+    uint8_t flags;
+    uint16_t x, y, w, h;
+    uint32_t payload_len;
+} rect_hdr_t;
+
+/**
+ * @brief Destination of row @p row (0-based within the rectangle)
+ *
+ * Called once per row, in order, before its first pixel is written.
+ * Must return room for the rectangle's w pixels.
+ */
+typedef uint16_t *(*rect_row_fn)(void *ctx, uint16_t row);
+
+typedef struct {
+    uint8_t codec;
+    uint16_t w, h;
+    uint16_t row, col;      // Next pixel
+    uint16_t *out;          // Next pixel's destination (NULL once all rows are done)
+    rect_row_fn row_fn;
+    void *ctx;
+    uint32_t left;          // Pixels left in the current packet
+    bool run;               // Current packet is a run
+    bool have_lo;           // Low byte of a split pixel pending
+    uint8_t lo;
+} rect_decoder_t;
+
+/**
+ * @brief Parse and validate a rectangle header
+ *
+ * @param buf RECT_HDR_LEN bytes
+ * @param out Parsed header
+ * @return RECT_STREAM_OK or error
+ */
+rect_stream_err_t rect_parse_hdr(const uint8_t *buf, rect_hdr_t *out);
+
+/**
+ * @brief Encode a rectangle header (the mirror sender, app_mirror.c)
+ */
+void rect_write_hdr(const rect_hdr_t *hdr, uint8_t *buf);
+
+/**
+ * @brief Start decoding one rectangle
+ *
+ * @param dec Decoder state
+ * @param hdr Parsed header (w, h > 0)
+ * @param row_fn Row destination callback
+ * @param ctx Passed to row_fn
+ */
+void rect_decoder_init(rect_decoder_t *dec, const rect_hdr_t *hdr, rect_row_fn row_fn, void *ctx);
+
+/**
+ * @brief Decode the next chunk of payload
+ *
+ * @return RECT_STREAM_OK or RECT_STREAM_ERR_OVERFLOW
+ */
+rect_stream_err_t rect_decoder_feed(rect_decoder_t *dec, const uint8_t *data, size_t len);
+
+/**
+ * @brief Check that the payload fed so far decoded to exactly w*h pixels
+ *
+ * @return RECT_STREAM_OK or RECT_STREAM_ERR_SHORT
+ */
+rect_stream_err_t rect_decoder_finish(const rect_decoder_t *dec);
+
+/**
+ * @brief DELTA565-encode one row against the host's copy of it
+ *
+ * @param cur Row as it is now (w pixels)
+ * @param prev Row as the host has it (w pixels), or NULL to send every pixel
+ * @param w Row width
+ * @param out Output, at least RECT_DELTA_BOUND(w, 1) bytes
+ * @return Bytes written
+ */
+size_t rect_encode_delta_row(const uint16_t *cur, const uint16_t *prev, uint16_t w, uint8_t *out);
+
+/**
+ * @brief Human readable error name
+ */
+const char *rect_stream_err_str(rect_stream_err_t err);
+
+#ifdef __cplusplus
+}
+#endif
@@ -58,6 +58,22 @@ static trackpad_action_type_t convert_action_type(ActionType type)
     }
 }
 
+// Convert C input to C++ TouchInput
+static bool convert_input(const trackpad_input_t *input, TouchInput *out)
+{
+    switch (input->type) {
+        case TRACKPAD_EVENT_PRESSED:  out->event = TouchEvent::PRESSED; break;
+        case TRACKPAD_EVENT_PRESSING: out->event = TouchEvent::PRESSING; break;
+        case TRACKPAD_EVENT_RELEASED: out->event = TouchEvent::RELEASED; break;
+        default: return false;
+    }
+    out->x = input->x;
+    out->y = input->y;
+    out->timestamp_ms = input->timestamp_ms;
+    out->strength = input->strength;
+    return true;
+}
+
 bool trackpad_process_input(trackpad_state_t *state,
                             const trackpad_input_t *input,
                             trackpad_action_t *action)
@@ -68,15 +84,9 @@ bool trackpad_process_input(trackpad_state_t *state,
 
     // Convert C input to C++
     TouchInput cpp_input;
-    switch (input->type) {
-        case TRACKPAD_EVENT_PRESSED:  cpp_input.event = TouchEvent::PRESSED; break;
-        case TRACKPAD_EVENT_PRESSING: cpp_input.event = TouchEvent::PRESSING; break;
-        case TRACKPAD_EVENT_RELEASED: cpp_input.event = TouchEvent::RELEASED; break;
-        default: return false;
+    if (!convert_input(input, &cpp_input)) {
+        return false;
     }
-    cpp_input.x = input->x;
-    cpp_input.y = input->y;
-    cpp_input.timestamp_ms = input->timestamp_ms;
 
     // Process
     TrackpadAction result = g_trackpad->processInput(cpp_input);
@@ -106,6 +116,35 @@ bool trackpad_tick(uint32_t timestamp_ms, trackpad_action_t *action)
     return result.hasAction();
 }
 
+uint32_t trackpad_replay(uint16_t hres, uint16_t vres,
+                         const trackpad_input_t *inputs, uint32_t count)
+{
+    if (!inputs) {
+        return 0;
+    }
+
+    // Private instance so replays never disturb the live gesture state
+    Trackpad tp(hres, vres);
+    if (g_trackpad) {
+        tp.config() = g_trackpad->config();
+    }
+
+    uint32_t actions = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        TouchInput cpp_input;
+        if (!convert_input(&inputs[i], &cpp_input)) {
+            continue;
+        }
+        if (tp.processInput(cpp_input).hasAction()) {
+            actions++;
+        }
+        if (tp.tick(inputs[i].timestamp_ms).hasAction()) {
+            actions++;
+        }
+    }
+    return actions;
+}
+
 // ========================== Pure Functions ==========================
 
 int32_t trackpad_clamp_i32(int32_t val, int32_t min, int32_t max)
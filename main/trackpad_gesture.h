@@ -92,6 +92,7 @@ typedef struct {
     int32_t x;
     int32_t y;
     uint32_t timestamp_ms;
+    uint16_t strength;      ///< Contact strength/size as reported by the controller, 0 = not reported
 } trackpad_input_t;
 
 /**
@@ -229,6 +230,22 @@ bool trackpad_process_input(trackpad_state_t *state,
  */
 bool trackpad_tick(uint32_t timestamp_ms, trackpad_action_t *action);
 
+/**
+ * @brief Run an input sequence through a private gesture processor
+ *
+ * Same pipeline as trackpad_process_input() + trackpad_tick(), but on a
+ * fresh instance (using the live configuration if initialized), so the
+ * running trackpad is not disturbed. Used by the benchmark commands.
+ *
+ * @param hres Horizontal resolution
+ * @param vres Vertical resolution
+ * @param inputs Input sequence (tick is run at each input's timestamp)
+ * @param count Number of inputs
+ * @return Number of actions produced
+ */
+uint32_t trackpad_replay(uint16_t hres, uint16_t vres,
+                         const trackpad_input_t *inputs, uint32_t count);
+
 // ========================== Pure Functions (Testable) ==========================
 
 /**
@@ -8,13 +8,18 @@
  * - Multi-tap window chains taps (double/triple/quad click)
  * - Tap-then-hold = drag (click and hold)
  * - Smooth acceleration curve (slow=accurate, fast=accelerate)
+ *   driven by a least-squares velocity fit (trackpad_velocity.hpp)
+ * - Landing filter: touch-down noise clamped only until the contact settles
+ *
+ * No ESP-IDF dependencies: tools/replay_landing.cpp builds it on the host.
  */
 
 #pragma once
 
 #include <cstdint>
 #include <cmath>
-#include "esp_log.h" // Changed from <cstdio> to esp_log.h
+#include <cstdlib>
+#include "trackpad_velocity.hpp"
 
 // ========================== Configuration ==========================
 
@@ -35,8 +40,24 @@ struct TrackpadConfig {
     float accel_velocity_scale = 800.0f;   // Velocity normalization (px/s)
     float accel_exponent = 1.0f;           // 1.0 = Linear (Predictable)
 
+    // Velocity fit over the last samples of the stroke (see trackpad_velocity.hpp)
+    uint8_t velocity_samples = 4;          // Samples per fit (2..8), 4 = 30 ms at 100 Hz
+    uint32_t velocity_window_ms = 50;      // Ignore samples older than this
+    uint8_t velocity_smooth_pct = 60;      // Weight of the newest fit (100 = unsmoothed)
+
     // Anti-wiggle (small dead zone for direction changes)
     int32_t anti_wiggle_px = 0;            // Ignore movements smaller than this
+
+    // Landing filter: while a new contact settles, deltas are clamped and
+    // acceleration is held at accel_min. The contact has settled once it is
+    // landing_min_samples old, its strength has stopped rising quickly and
+    // landing_consistent_samples moves in a row point the same way, or in
+    // any case after landing_max_ms.
+    int32_t landing_clamp_px = 5;          // Max delta per axis while landing
+    uint8_t landing_min_samples = 2;       // Contact age, in PRESSING samples
+    uint8_t landing_consistent_samples = 2;// Same-direction moves in a row
+    uint8_t landing_strength_rise_pct = 25;// Faster rise per sample = still landing
+    uint32_t landing_max_ms = 60;          // Upper bound on the landing phase
 };
 
 // ========================== Types ==========================
@@ -52,6 +73,7 @@ struct TouchInput {
     int32_t x;
     int32_t y;
     uint32_t timestamp_ms;
+    uint16_t strength;      // Contact strength/size from the controller, 0 = not reported
 };
 
 // Action types that can be returned
@@ -149,12 +171,11 @@ public:
         m_touch_start_y = 0;
         m_touch_down_time = 0;
         m_last_release_time = 0;
-        m_last_sample_time = 0;
         m_total_movement = 0;
         m_accum_x = 0;
         m_accum_y = 0;
-        m_velocity_x = 0.0f;
-        m_velocity_y = 0.0f;
+        m_velocity.reset();
+        m_landing = false;
     }
 
     TrackpadConfig& config() { return m_config; }
@@ -188,17 +209,22 @@ private:
     uint32_t m_current_time = 0;
     uint32_t m_touch_down_time = 0;
     uint32_t m_last_release_time = 0;
-    uint32_t m_last_sample_time = 0;
 
     // Movement tracking
     int32_t m_total_movement = 0;
     int32_t m_last_raw_dx = 0;
     int32_t m_last_raw_dy = 0;
-    int32_t m_frames_since_touch_down = 0;
+
+    // Landing filter
+    bool m_landing = false;
+    uint8_t m_landing_samples = 0;
+    uint8_t m_landing_consistent = 0;
+    uint16_t m_landing_strength = 0;
+    int32_t m_landing_dx = 0;               // Last non-zero move, before clamping
+    int32_t m_landing_dy = 0;
 
     // Velocity tracking (pixels per second)
-    float m_velocity_x = 0.0f;
-    float m_velocity_y = 0.0f;
+    VelocityEstimator<> m_velocity;
 
     // Sub-pixel accumulator (8-bit fractional part)
     static const int32_t FIXED_POINT_SHIFT = 8;
@@ -215,15 +241,22 @@ private:
         m_touch_start_x = input.x;
         m_touch_start_y = input.y;
         m_touch_down_time = input.timestamp_ms;
-        m_last_sample_time = input.timestamp_ms;
         m_total_movement = 0;
         m_last_raw_dx = 0;
         m_last_raw_dy = 0;
-        m_frames_since_touch_down = 0;
+        m_landing = true;
+        m_landing_samples = 0;
+        m_landing_consistent = 0;
+        m_landing_strength = input.strength;
+        m_landing_dx = 0;
+        m_landing_dy = 0;
         m_accum_x = 0;
         m_accum_y = 0;
-        m_velocity_x = 0.0f;
-        m_velocity_y = 0.0f;
+        // Config may have changed since the last stroke (config() is writable)
+        m_velocity.configure(m_config.velocity_samples, m_config.velocity_window_ms,
+                             m_config.velocity_smooth_pct);
+        m_velocity.reset();
+        m_velocity.push(input.x, input.y, input.timestamp_ms);
 
         // Check if this is within the multi-tap window
         if (m_state == State::WAITING_FOR_TAP) {
@@ -241,38 +274,37 @@ private:
             return TrackpadAction();
         }
 
-        m_frames_since_touch_down++;
-
-        // Calculate time delta (dt) in seconds
-        uint32_t dt_ms = input.timestamp_ms - m_last_sample_time;
-        if (dt_ms == 0) dt_ms = 1; // Prevent div by zero
-        float dt = dt_ms / 1000.0f;
-        m_last_sample_time = input.timestamp_ms;
-
         // Calculate raw delta
         int32_t raw_dx = input.x - m_last_x;
         int32_t raw_dy = input.y - m_last_y;
 
-        // Startup stability filter: Clamp huge jumps in the first few frames
-        // This prevents "jumping" if the hardware reports erratic coordinates on touch down
-        if (m_frames_since_touch_down <= 100) {
-            const int32_t STARTUP_CLAMP_PX = 5;
-            if (raw_dx > STARTUP_CLAMP_PX) raw_dx = STARTUP_CLAMP_PX;
-            if (raw_dx < -STARTUP_CLAMP_PX) raw_dx = -STARTUP_CLAMP_PX;
-            if (raw_dy > STARTUP_CLAMP_PX) raw_dy = STARTUP_CLAMP_PX;
-            if (raw_dy < -STARTUP_CLAMP_PX) raw_dy = -STARTUP_CLAMP_PX;
+        // Landing filter: the controller reports erratic coordinates while
+        // the finger flattens onto the glass. Clamp until the contact has
+        // settled; what was clamped away is dropped, not caught up later.
+        bool landing = m_landing && !updateLanding(input, raw_dx, raw_dy);
+        if (landing) {
+            const int32_t clamp = m_config.landing_clamp_px;
+            if (raw_dx > clamp) raw_dx = clamp;
+            if (raw_dx < -clamp) raw_dx = -clamp;
+            if (raw_dy > clamp) raw_dy = clamp;
+            if (raw_dy < -clamp) raw_dy = -clamp;
         }
 
-        // Detect direction change and DAMP velocity (soft braking)
-        // Resetting to 0 causes stutter, but keeping full velocity causes "jumps".
-        // Damping by 0.5f provides a natural "turnaround" feel.
+        // Velocity fit. While landing only the newest sample is kept, so the
+        // fit starts from the last landing position and no earlier landing
+        // jumps enter it.
+        if (landing) {
+            m_velocity.reset();
+        }
+        m_velocity.push(input.x, input.y, input.timestamp_ms);
+
+        // Direction change: drop the sub-pixel remainder of the old direction.
+        // The velocity fit needs no braking here, it runs through zero by itself.
         if ((raw_dx > 0 && m_last_raw_dx < 0) || (raw_dx < 0 && m_last_raw_dx > 0)) {
             m_accum_x = 0;
-            m_velocity_x *= 0.5f; 
         }
         if ((raw_dy > 0 && m_last_raw_dy < 0) || (raw_dy < 0 && m_last_raw_dy > 0)) {
             m_accum_y = 0;
-            m_velocity_y *= 0.5f;
         }
         m_last_raw_dx = raw_dx;
         m_last_raw_dy = raw_dy;
@@ -280,9 +312,9 @@ private:
         // Track total movement (for tap detection)
         m_total_movement += std::abs(raw_dx) + std::abs(raw_dy);
 
-        // Update last position using potentially clamped deltas
-        m_last_x += raw_dx;
-        m_last_y += raw_dy;
+        // Follow the finger; while landing, the clamped-off part is noise
+        m_last_x = input.x;
+        m_last_y = input.y;
 
         // No movement? No action
         if (raw_dx == 0 && raw_dy == 0) {
@@ -309,20 +341,16 @@ private:
             m_state = State::MOVING;
         }
 
-        // Calculate instantaneous velocity (pixels per second)
-        float inst_vel_x = std::abs(raw_dx) / dt;
-        float inst_vel_y = std::abs(raw_dy) / dt;
-
-        // Smooth velocity using EWMA (0.3 = strong smoothing for jerky noise)
-        m_velocity_x = (inst_vel_x * 0.3f) + (m_velocity_x * 0.7f);
-        m_velocity_y = (inst_vel_y * 0.3f) + (m_velocity_y * 0.7f);
-        float speed = m_velocity_x + m_velocity_y;
+        // Speed from the fitted velocity (pixels per second). Right after a
+        // reversal the fit still points the old way; an axis moving against
+        // it adds nothing, so the turnaround starts at accel_min.
+        int32_t speed = axisSpeed(m_velocity.vx(), raw_dx) + axisSpeed(m_velocity.vy(), raw_dy);
 
-        int32_t accel = calculateAcceleration((int32_t)speed);
+        int32_t accel = calculateAcceleration(speed);
 
-        // Force minimum acceleration for the first few frames to dampen landing noise
-        if (m_frames_since_touch_down <= 10) {
-             accel = static_cast<int32_t>(m_config.accel_min * (1 << FIXED_POINT_SHIFT));
+        // No acceleration of landing noise
+        if (landing) {
+            accel = static_cast<int32_t>(m_config.accel_min * (1 << FIXED_POINT_SHIFT));
         }
 
         // Accumulate with fixed-point precision
@@ -392,6 +420,53 @@ private:
 
     // ========================== Helpers ==========================
 
+    /**
+     * Advance the landing filter by one PRESSING sample (raw, unclamped
+     * delta). Returns true once the contact has settled; from then on the
+     * stroke is no longer filtered.
+     */
+    bool updateLanding(const TouchInput& input, int32_t raw_dx, int32_t raw_dy)
+    {
+        if (m_landing_samples < UINT8_MAX) m_landing_samples++;
+
+        // Direction consistency: consecutive moves in the same half-plane.
+        // Samples without movement neither count nor break the run.
+        if (raw_dx != 0 || raw_dy != 0) {
+            if (raw_dx * m_landing_dx + raw_dy * m_landing_dy > 0) {
+                if (m_landing_consistent < UINT8_MAX) m_landing_consistent++;
+            } else {
+                m_landing_consistent = 1;
+            }
+            m_landing_dx = raw_dx;
+            m_landing_dy = raw_dy;
+        }
+
+        // Strength still rising fast = finger still flattening. A 0 on either
+        // side means no strength data (not reported, or not yet for this
+        // contact), so the check passes rather than reading 0 -> n as a rise.
+        uint32_t prev = m_landing_strength;
+        m_landing_strength = input.strength;
+        bool strength_settled = prev == 0 ||
+                                input.strength <= prev + prev * m_config.landing_strength_rise_pct / 100;
+
+        bool settled = (m_landing_samples >= m_config.landing_min_samples &&
+                        m_landing_consistent >= m_config.landing_consistent_samples &&
+                        strength_settled) ||
+                       (input.timestamp_ms - m_touch_down_time >= m_config.landing_max_ms);
+        if (settled) {
+            m_landing = false;
+        }
+        return settled;
+    }
+
+    static int32_t axisSpeed(int32_t velocity_pps, int32_t delta)
+    {
+        if ((delta > 0 && velocity_pps < 0) || (delta < 0 && velocity_pps > 0)) {
+            return 0;
+        }
+        return std::abs(velocity_pps);
+    }
+
     int32_t calculateAcceleration(int32_t velocity_pps)
     {
         // Linear acceleration curve (Predictable and stable)
@@ -5,6 +5,7 @@
 
 #include "ui_gamepad.h"
 #include "app_hid_gamepad.h"
+#include "ui_styles.h"
 #include "esp_log.h"
 
 static const char *TAG = "ui_gamepad";
@@ -94,14 +95,14 @@ static void action_button_event_handler(lv_event_t *e)
  * @brief Create a styled button
  */
 static lv_obj_t *create_button(lv_obj_t *parent, const char *label_text,
-                                 int16_t x, int16_t y, uint16_t w, uint16_t h,
-                                 lv_color_t color)
+                               int16_t x, int16_t y, uint16_t w, uint16_t h,
+                               const lv_style_t *style, const lv_style_t *style_pressed)
 {
     lv_obj_t *btn = lv_btn_create(parent);
     lv_obj_set_pos(btn, x, y);
     lv_obj_set_size(btn, w, h);
-    lv_obj_set_style_bg_color(btn, color, LV_STATE_DEFAULT);
-    lv_obj_set_style_bg_color(btn, lv_color_lighten(color, 50), LV_STATE_PRESSED);
+    lv_obj_add_style(btn, style, LV_STATE_DEFAULT);
+    lv_obj_add_style(btn, style_pressed, LV_STATE_PRESSED);
 
     lv_obj_t *label = lv_label_create(btn);
     lv_label_set_text(label, label_text);
@@ -123,18 +124,18 @@ void ui_gamepad_init(const gamepad_cfg_t *cfg)
 
     // Create screen
     lv_obj_t *scr = lv_scr_act();
-    lv_obj_set_style_bg_color(scr, lv_color_hex(0x000000), 0);
+    lv_obj_add_style(scr, &ui_style_screen_dark, 0);
 
     // Title label
     lv_obj_t *title = lv_label_create(scr);
     lv_label_set_text(title, "USB Gamepad");
-    lv_obj_set_style_text_color(title, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_add_style(title, &ui_style_text_light, 0);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
 
     // Status label
     s_status_label = lv_label_create(scr);
     lv_label_set_text(s_status_label, "X:0 Y:0 Btns:0x00");
-    lv_obj_set_style_text_color(s_status_label, lv_color_hex(0x00FF00), 0);
+    lv_obj_add_style(s_status_label, &ui_style_text_status, 0);
     lv_obj_align(s_status_label, LV_ALIGN_TOP_MID, 0, 35);
 
     // Calculate button dimensions
@@ -144,37 +145,39 @@ void ui_gamepad_init(const gamepad_cfg_t *cfg)
     uint16_t dpad_center_y = cfg->vres / 2 + 20;
 
     // D-pad buttons (Up, Down, Left, Right)
-    lv_color_t dpad_color = lv_color_hex(0x444444);
-
     // Up button
     lv_obj_t *btn_up = create_button(scr, "UP",
-                                      dpad_center_x - btn_size / 2,
-                                      dpad_center_y - btn_size - dpad_spacing,
-                                      btn_size, btn_size, dpad_color);
+                                     dpad_center_x - btn_size / 2,
+                                     dpad_center_y - btn_size - dpad_spacing,
+                                     btn_size, btn_size,
+                                     &ui_style_pad_dpad, &ui_style_pad_dpad_pressed);
     lv_obj_add_event_cb(btn_up, dpad_event_handler, LV_EVENT_PRESSED, &s_state.y);
     lv_obj_add_event_cb(btn_up, dpad_event_handler, LV_EVENT_RELEASED, &s_state.y);
 
     // Down button
     lv_obj_t *btn_down = create_button(scr, "DN",
-                                        dpad_center_x - btn_size / 2,
-                                        dpad_center_y + dpad_spacing,
-                                        btn_size, btn_size, dpad_color);
+                                       dpad_center_x - btn_size / 2,
+                                       dpad_center_y + dpad_spacing,
+                                       btn_size, btn_size,
+                                       &ui_style_pad_dpad, &ui_style_pad_dpad_pressed);
     lv_obj_add_event_cb(btn_down, dpad_event_handler, LV_EVENT_PRESSED, &s_state.y);
     lv_obj_add_event_cb(btn_down, dpad_event_handler, LV_EVENT_RELEASED, &s_state.y);
 
     // Left button
     lv_obj_t *btn_left = create_button(scr, "LT",
-                                        dpad_center_x - btn_size - dpad_spacing,
-                                        dpad_center_y - btn_size / 2,
-                                        btn_size, btn_size, dpad_color);
+                                       dpad_center_x - btn_size - dpad_spacing,
+                                       dpad_center_y - btn_size / 2,
+                                       btn_size, btn_size,
+                                       &ui_style_pad_dpad, &ui_style_pad_dpad_pressed);
     lv_obj_add_event_cb(btn_left, dpad_event_handler, LV_EVENT_PRESSED, &s_state.x);
     lv_obj_add_event_cb(btn_left, dpad_event_handler, LV_EVENT_RELEASED, &s_state.x);
 
     // Right button
     lv_obj_t *btn_right = create_button(scr, "RT",
-                                         dpad_center_x + dpad_spacing,
-                                         dpad_center_y - btn_size / 2,
-                                         btn_size, btn_size, dpad_color);
+                                        dpad_center_x + dpad_spacing,
+                                        dpad_center_y - btn_size / 2,
+                                        btn_size, btn_size,
+                                        &ui_style_pad_dpad, &ui_style_pad_dpad_pressed);
     lv_obj_add_event_cb(btn_right, dpad_event_handler, LV_EVENT_PRESSED, &s_state.x);
     lv_obj_add_event_cb(btn_right, dpad_event_handler, LV_EVENT_RELEASED, &s_state.x);
 
@@ -186,10 +189,10 @@ void ui_gamepad_init(const gamepad_cfg_t *cfg)
 
     // Button A (bottom)
     lv_obj_t *btn_a = create_button(scr, "A",
-                                     action_center_x - action_btn_size / 2,
-                                     action_center_y + action_spacing,
-                                     action_btn_size, action_btn_size,
-                                     lv_color_hex(0x00AA00));
+                                    action_center_x - action_btn_size / 2,
+                                    action_center_y + action_spacing,
+                                    action_btn_size, action_btn_size,
+                                    &ui_style_pad_a, &ui_style_pad_a_pressed);
     lv_obj_add_event_cb(btn_a, action_button_event_handler, LV_EVENT_PRESSED,
                         (void *)(uintptr_t)GAMEPAD_BTN_A);
     lv_obj_add_event_cb(btn_a, action_button_event_handler, LV_EVENT_RELEASED,
@@ -197,10 +200,10 @@ void ui_gamepad_init(const gamepad_cfg_t *cfg)
 
     // Button B (right)
     lv_obj_t *btn_b = create_button(scr, "B",
-                                     action_center_x + action_spacing,
-                                     action_center_y - action_btn_size / 2,
-                                     action_btn_size, action_btn_size,
-                                     lv_color_hex(0xAA0000));
+                                    action_center_x + action_spacing,
+                                    action_center_y - action_btn_size / 2,
+                                    action_btn_size, action_btn_size,
+                                    &ui_style_pad_b, &ui_style_pad_b_pressed);
     lv_obj_add_event_cb(btn_b, action_button_event_handler, LV_EVENT_PRESSED,
                         (void *)(uintptr_t)GAMEPAD_BTN_B);
     lv_obj_add_event_cb(btn_b, action_button_event_handler, LV_EVENT_RELEASED,
@@ -208,10 +211,10 @@ void ui_gamepad_init(const gamepad_cfg_t *cfg)
 
     // Button X (left)
     lv_obj_t *btn_x = create_button(scr, "X",
-                                     action_center_x - action_btn_size - action_spacing,
-                                     action_center_y - action_btn_size / 2,
-                                     action_btn_size, action_btn_size,
-                                     lv_color_hex(0x0000AA));
+                                    action_center_x - action_btn_size - action_spacing,
+                                    action_center_y - action_btn_size / 2,
+                                    action_btn_size, action_btn_size,
+                                    &ui_style_pad_x, &ui_style_pad_x_pressed);
     lv_obj_add_event_cb(btn_x, action_button_event_handler, LV_EVENT_PRESSED,
                         (void *)(uintptr_t)GAMEPAD_BTN_X);
     lv_obj_add_event_cb(btn_x, action_button_event_handler, LV_EVENT_RELEASED,
@@ -219,10 +222,10 @@ void ui_gamepad_init(const gamepad_cfg_t *cfg)
 
     // Button Y (top)
     lv_obj_t *btn_y = create_button(scr, "Y",
-                                     action_center_x - action_btn_size / 2,
-                                     action_center_y - action_btn_size - action_spacing,
-                                     action_btn_size, action_btn_size,
-                                     lv_color_hex(0xAAAA00));
+                                    action_center_x - action_btn_size / 2,
+                                    action_center_y - action_btn_size - action_spacing,
+                                    action_btn_size, action_btn_size,
+                                    &ui_style_pad_y, &ui_style_pad_y_pressed);
     lv_obj_add_event_cb(btn_y, action_button_event_handler, LV_EVENT_PRESSED,
                         (void *)(uintptr_t)GAMEPAD_BTN_Y);
     lv_obj_add_event_cb(btn_y, action_button_event_handler, LV_EVENT_RELEASED,
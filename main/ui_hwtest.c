@@ -4,14 +4,17 @@
 #include <inttypes.h>
 
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
 
+#include "ui_layer_cache.h"
+#include "ui_styles.h"
 
 static hwtest_cfg_t s_cfg;
 
 static lv_obj_t *s_touch_dot;
 static lv_obj_t *s_touch_label;
 static lv_obj_t *s_status_label;
-static lv_obj_t *s_grid_info_label;
 static lv_obj_t *s_inv_btn_label;
 static lv_obj_t *s_orient_btn_label;
 static lv_obj_t *s_bl_slider_label;
@@ -34,6 +37,10 @@ static uint32_t s_click_count = 0;
 
 static const char *TAG = "ui_hwtest.c";
 
+#if CONFIG_APP_HWTEST_LATENCY
+static void latency_mark(const lv_point_t *p);
+#endif
+
 /* ---------------- Touch overlay ---------------- */
 static void touch_layer_cb(lv_event_t *e)
 {
@@ -48,6 +55,9 @@ static void touch_layer_cb(lv_event_t *e)
 
     if (s_touch_dot) {
         lv_obj_set_pos(s_touch_dot, (lv_coord_t)(p.x - 6), (lv_coord_t)(p.y - 6));
+#if CONFIG_APP_HWTEST_LATENCY
+        if (code == LV_EVENT_PRESSING) latency_mark(&p);
+#endif
     }
 
     if (s_touch_label) {
@@ -59,6 +69,200 @@ static void touch_layer_cb(lv_event_t *e)
     }
 }
 
+/* ---------------- Touch-to-photon latency ---------------- */
+#if CONFIG_APP_HWTEST_LATENCY
+/* One touch sample at a time is followed from the indev read that produced
+ * it, through the event that moved s_touch_dot, to the end of the first
+ * flush whose area covers the dot's new position:
+ *
+ *   sample -> event      input processing (indev read to handler)
+ *   event  -> refr start LVGL refresh period wait
+ *   refr   -> flush      rendering up to the flush containing the dot
+ *   flush  -> done       transfer
+ *
+ * "done" is the flush callback's return. For backends that complete the
+ * flush from a DMA interrupt (esp_lvgl_port SPI) it is moved to the end of
+ * LVGL's next wait-for-flush if one follows before anything else is sent.
+ * Sampling delay before the controller reports a touch is not visible here;
+ * it is bounded by the indev read period. */
+
+#define LAT_BUCKET_US   4000
+#define LAT_BUCKETS     25      // 0..96 ms in 4 ms steps, last one is overflow
+#define LAT_REPORT_N    200
+#define LAT_STALE_US    500000
+
+typedef enum {
+    LAT_IDLE = 0,
+    LAT_WAIT_REFR,
+    LAT_WAIT_FLUSH,
+    LAT_FLUSHED,
+} lat_state_t;
+
+static struct {
+    lv_indev_read_cb_t orig_read;
+    int64_t last_read_us;       // End of the latest pressed indev read
+
+    lat_state_t state;
+    lv_area_t dot;              // Where the dot is being drawn
+    int64_t t_sample, t_event, t_refr, t_flush, t_done;
+
+    uint32_t hist[LAT_BUCKETS];
+    uint32_t count;
+    uint64_t sum_input_us, sum_period_us, sum_render_us, sum_xfer_us;
+} s_lat;
+
+static lv_obj_t *s_lat_label;
+
+static void latency_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
+{
+    s_lat.orig_read(indev, data);
+    if (data->state == LV_INDEV_STATE_PRESSED) s_lat.last_read_us = esp_timer_get_time();
+}
+
+static uint32_t latency_percentile_ms(uint32_t pct)
+{
+    uint32_t target = (s_lat.count * pct + 99) / 100;
+    uint32_t acc = 0;
+    for (int i = 0; i < LAT_BUCKETS; i++) {
+        acc += s_lat.hist[i];
+        if (acc >= target) return (uint32_t)(i + 1) * LAT_BUCKET_US / 1000;
+    }
+    return LAT_BUCKETS * LAT_BUCKET_US / 1000;
+}
+
+static void latency_report(void)
+{
+    uint32_t n = s_lat.count;
+    ESP_LOGI(TAG, "latency profile=%s n=%lu p50<=%lums p95<=%lums input=%lluus period=%lluus render=%lluus xfer=%lluus",
+             CONFIG_APP_BOARD_PROFILE, (unsigned long)n,
+             (unsigned long)latency_percentile_ms(50), (unsigned long)latency_percentile_ms(95),
+             s_lat.sum_input_us / n, s_lat.sum_period_us / n,
+             s_lat.sum_render_us / n, s_lat.sum_xfer_us / n);
+    for (int i = 0; i < LAT_BUCKETS; i++) {
+        if (!s_lat.hist[i]) continue;
+        if (i == LAT_BUCKETS - 1) {
+            ESP_LOGI(TAG, "latency  >=%2d ms: %lu", i * LAT_BUCKET_US / 1000, (unsigned long)s_lat.hist[i]);
+        } else {
+            ESP_LOGI(TAG, "latency %2d-%2d ms: %lu", i * LAT_BUCKET_US / 1000,
+                     (i + 1) * LAT_BUCKET_US / 1000, (unsigned long)s_lat.hist[i]);
+        }
+    }
+}
+
+static void latency_commit(void)
+{
+    uint32_t total = (uint32_t)(s_lat.t_done - s_lat.t_sample);
+    uint32_t b = total / LAT_BUCKET_US;
+    s_lat.hist[b < LAT_BUCKETS ? b : LAT_BUCKETS - 1]++;
+    s_lat.count++;
+    s_lat.sum_input_us  += (uint64_t)(s_lat.t_event - s_lat.t_sample);
+    s_lat.sum_period_us += (uint64_t)(s_lat.t_refr - s_lat.t_event);
+    s_lat.sum_render_us += (uint64_t)(s_lat.t_flush - s_lat.t_refr);
+    s_lat.sum_xfer_us   += (uint64_t)(s_lat.t_done - s_lat.t_flush);
+    s_lat.state = LAT_IDLE;
+
+    if (s_lat.count % LAT_REPORT_N == 0) latency_report();
+}
+
+// Called from the touch handler right after the dot was moved to p
+static void latency_mark(const lv_point_t *p)
+{
+    int64_t now = esp_timer_get_time();
+    if (s_lat.state != LAT_IDLE) {
+        if (now - s_lat.t_event < LAT_STALE_US) return;  // one sample in flight at a time
+        s_lat.state = LAT_IDLE;
+    }
+    if (!s_lat.orig_read || now - s_lat.last_read_us > LAT_STALE_US) return;
+
+    // Dot is 12x12 at p - 6 with a 2 px border inside its box
+    lv_area_t dot = { p->x - 6, p->y - 6, p->x + 5, p->y + 5 };
+    if (lv_area_is_equal(&dot, &s_lat.dot)) return;      // no move, no redraw
+
+    s_lat.dot = dot;
+    s_lat.t_sample = s_lat.last_read_us;
+    s_lat.t_event = now;
+    s_lat.t_flush = 0;
+    s_lat.state = LAT_WAIT_REFR;
+}
+
+static void latency_disp_cb(lv_event_t *e)
+{
+    if (s_lat.state == LAT_IDLE) return;
+    int64_t now = esp_timer_get_time();
+
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_REFR_START:
+            if (s_lat.state == LAT_FLUSHED) {
+                latency_commit();
+            } else if (s_lat.state == LAT_WAIT_REFR) {
+                s_lat.t_refr = now;
+                s_lat.state = LAT_WAIT_FLUSH;
+            }
+            break;
+        case LV_EVENT_FLUSH_START: {
+            if (s_lat.state == LAT_FLUSHED) {
+                latency_commit();
+                break;
+            }
+            const lv_area_t *area = (const lv_area_t *)lv_event_get_param(e);
+            lv_area_t isect;
+            if (s_lat.state == LAT_WAIT_FLUSH && !s_lat.t_flush &&
+                area && lv_area_intersect(&isect, area, &s_lat.dot)) {
+                s_lat.t_flush = now;
+            }
+            break;
+        }
+        case LV_EVENT_FLUSH_FINISH:
+            if (s_lat.state == LAT_WAIT_FLUSH && s_lat.t_flush) {
+                s_lat.t_done = now;
+                s_lat.state = LAT_FLUSHED;
+            }
+            break;
+        case LV_EVENT_FLUSH_WAIT_FINISH:
+            if (s_lat.state == LAT_FLUSHED) {
+                s_lat.t_done = now;
+                latency_commit();
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void latency_init(lv_obj_t *scr)
+{
+    // Wrap the pointer's read callback to timestamp samples
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev; indev = lv_indev_get_next(indev)) {
+        if (lv_indev_get_type(indev) == LV_INDEV_TYPE_POINTER) {
+            s_lat.orig_read = lv_indev_get_read_cb(indev);
+            lv_indev_set_read_cb(indev, latency_read_cb);
+            break;
+        }
+    }
+    if (!s_lat.orig_read) {
+        ESP_LOGW(TAG, "No pointer input device; latency test disabled");
+        return;
+    }
+
+    lv_display_add_event_cb(lv_obj_get_display(scr), latency_disp_cb, LV_EVENT_ALL, NULL);
+
+    s_lat_label = lv_label_create(scr);
+    lv_label_set_text(s_lat_label, "Latency: drag to measure");
+    lv_obj_align(s_lat_label, LV_ALIGN_BOTTOM_LEFT, 6, -118);
+}
+
+static void latency_update_label(void)
+{
+    if (!s_lat_label || !s_lat.count) return;
+    uint32_t n = s_lat.count;
+    char buf[64];
+    snprintf(buf, sizeof(buf), "Latency p50<=%lu p95<=%lu ms (n=%lu)",
+             (unsigned long)latency_percentile_ms(50), (unsigned long)latency_percentile_ms(95),
+             (unsigned long)n);
+    lv_label_set_text(s_lat_label, buf);
+}
+#endif // CONFIG_APP_HWTEST_LATENCY
+
 /* ---------------- FPS-ish indicator ---------------- */
 static void fps_timer_cb(lv_timer_t *t)
 {
@@ -76,6 +280,10 @@ static void fps_timer_cb(lv_timer_t *t)
                  (unsigned long)fps);
         lv_label_set_text(s_status_label, buf);
     }
+
+#if CONFIG_APP_HWTEST_LATENCY
+    latency_update_label();
+#endif
 }
 
 /* ---------------- Motion stress ---------------- */
@@ -95,81 +303,109 @@ static void anim_timer_cb(lv_timer_t *t)
     s_frames++;
 }
 
-/* ---------------- Grid line helpers (LVGL 9 safe) ---------------- */
-/* Use a single static array for all grid points to avoid fragmentation */
-#define MAX_GRID_POINTS 400  // Supports up to 200 lines (each line = 2 points)
-static lv_point_precise_t s_grid_points[MAX_GRID_POINTS];
-static int s_point_idx = 0;
-
-static lv_obj_t *mk_line(lv_obj_t *parent,
-                         lv_point_precise_t p0, lv_point_precise_t p1,
-                         uint32_t color_hex, lv_opa_t opa)
+/* ---------------- Grid widget ---------------- */
+/* One object draws the whole grid from its draw event: each line is a 1px
+ * wide fill, so a grid costs one object and no point storage however dense
+ * it is. That is only cheap if it is drawn once, into the baked background
+ * layer: the draw event cannot see which part of the screen is being redrawn
+ * (the layer's clip area is private), so it issues every line each time. If
+ * the layer stays live, grid_use_objects() swaps in one plain object per
+ * line, which LVGL skips outside the redraw area by itself. */
+typedef struct {
+    int32_t step_minor;
+    int32_t step_major;
+} grid_spec_t;
+
+static grid_spec_t s_grid;
+
+static void grid_fill_lines(lv_layer_t *layer, const lv_area_t *coords, int32_t step,
+                            int32_t skip_step, uint32_t color_hex, lv_opa_t opa)
 {
-    if (s_point_idx + 2 > MAX_GRID_POINTS) {
-        ESP_LOGW(TAG, "Grid point array full, skipping line");
-        return NULL;
+    lv_draw_fill_dsc_t dsc;
+    lv_draw_fill_dsc_init(&dsc);
+    dsc.color = lv_color_hex(color_hex);
+    dsc.opa = opa;
+
+    lv_area_t line;
+
+    // Vertical lines
+    for (int32_t x = 0; x < lv_area_get_width(coords); x += step) {
+        if (skip_step && x % skip_step == 0) continue;
+        lv_area_set(&line, coords->x1 + x, coords->y1, coords->x1 + x, coords->y2);
+        lv_draw_fill(layer, &dsc, &line);
     }
 
-    lv_obj_t *l = lv_line_create(parent);
-
-    // Store points in static array
-    s_grid_points[s_point_idx] = p0;
-    s_grid_points[s_point_idx + 1] = p1;
-
-    // Line references into the static array
-    lv_line_set_points(l, &s_grid_points[s_point_idx], 2);
-    s_point_idx += 2;
-
-    lv_obj_set_style_line_width(l, 1, 0);
-    lv_obj_set_style_line_color(l, lv_color_hex(color_hex), 0);
-    lv_obj_set_style_line_opa(l, opa, 0);
-    lv_obj_clear_flag(l, LV_OBJ_FLAG_SCROLLABLE);
-    return l;
+    // Horizontal lines
+    for (int32_t y = 0; y < lv_area_get_height(coords); y += step) {
+        if (skip_step && y % skip_step == 0) continue;
+        lv_area_set(&line, coords->x1, coords->y1 + y, coords->x2, coords->y1 + y);
+        lv_draw_fill(layer, &dsc, &line);
+    }
 }
 
-static void grid_build(lv_obj_t *scr, int step_minor, int step_major)
+static void grid_draw_cb(lv_event_t *e)
 {
-    int32_t W = lv_obj_get_width(scr);
-    int32_t H = lv_obj_get_height(scr);
-    int maj_color = 0x000000;
-    int min_color = 0xAAAAAA;
-
-    s_point_idx = 0;  // Reset point index
+    lv_obj_t *obj = lv_event_get_target(e);
+    lv_layer_t *layer = lv_event_get_layer(e);
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+
+    // Minor lines where no major line will be drawn over them, then majors
+    grid_fill_lines(layer, &coords, s_grid.step_minor, s_grid.step_major, 0xAAAAAA, LV_OPA_50);
+    grid_fill_lines(layer, &coords, s_grid.step_major, 0, 0x000000, LV_OPA_COVER);
+}
 
-    // Minor grid lines
-    for (int32_t x = 0; x <= W; x += step_minor) {
-        lv_obj_t *line = mk_line(scr,
-                (lv_point_precise_t){ x, 0 },
-                (lv_point_precise_t){ x, H },
-                min_color, LV_OPA_50);
-        lv_obj_clear_flag(line, LV_OBJ_FLAG_SCROLLABLE);
+static void grid_line_obj(lv_obj_t *grid, const lv_style_t *style, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    lv_obj_t *o = lv_obj_create(grid);
+    lv_obj_remove_style_all(o);
+    lv_obj_add_style(o, style, 0);
+    lv_obj_remove_flag(o, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_pos(o, x, y);
+    lv_obj_set_size(o, w, h);
+}
 
+// Children of the grid, one 1px object per line, minors under majors
+static uint32_t grid_add_line_objs(lv_obj_t *grid, int32_t step, int32_t skip_step, const lv_style_t *style)
+{
+    const int32_t w = lv_obj_get_width(grid);
+    const int32_t h = lv_obj_get_height(grid);
+    uint32_t n = 0;
+
+    for (int32_t x = 0; x < w; x += step) {
+        if (skip_step && x % skip_step == 0) continue;
+        grid_line_obj(grid, style, x, 0, 1, h);
+        n++;
     }
-    for (int32_t y = 0; y <= H; y += step_minor) {
-        lv_obj_t *line = mk_line(scr,
-                (lv_point_precise_t){ 0, y },
-                (lv_point_precise_t){ W, y },
-                min_color, LV_OPA_50);
-        lv_obj_clear_flag(line, LV_OBJ_FLAG_SCROLLABLE);
+    for (int32_t y = 0; y < h; y += step) {
+        if (skip_step && y % skip_step == 0) continue;
+        grid_line_obj(grid, style, 0, y, w, 1);
+        n++;
     }
+    return n;
+}
 
-    // Major grid lines
-    for (int32_t x = 0; x <= W; x += step_major) {
-        lv_obj_t *line = mk_line(scr,
-                (lv_point_precise_t){ x, 0 },
-                (lv_point_precise_t){ x, H },
-                maj_color, LV_OPA_100);
-        lv_obj_clear_flag(line, LV_OBJ_FLAG_SCROLLABLE);
-    }
-    for (int32_t y = 0; y <= H; y += step_major) {
-        lv_obj_t *line = mk_line(scr,
-                (lv_point_precise_t){ 0, y },
-                (lv_point_precise_t){ W, y },
-                maj_color, LV_OPA_100);
-        lv_obj_clear_flag(line, LV_OBJ_FLAG_SCROLLABLE);
-    }
+// Unbaked fallback: replace the draw event by line objects. Returns their count.
+static uint32_t grid_use_objects(lv_obj_t *grid)
+{
+    lv_obj_remove_event_cb(grid, grid_draw_cb);
+    lv_obj_update_layout(grid);
+    uint32_t n = grid_add_line_objs(grid, s_grid.step_minor, s_grid.step_major, &ui_style_hwtest_grid_minor);
+    n += grid_add_line_objs(grid, s_grid.step_major, 0, &ui_style_hwtest_grid_major);
+    return n;
+}
 
-    ESP_LOGI(TAG, "Grid built: %d points used (max %d)", s_point_idx, MAX_GRID_POINTS);
+static lv_obj_t *grid_create(lv_obj_t *parent, int step_minor, int step_major)
+{
+    s_grid.step_minor = step_minor;
+    s_grid.step_major = step_major;
+
+    lv_obj_t *grid = lv_obj_create(parent);
+    lv_obj_remove_style_all(grid);
+    lv_obj_set_size(grid, lv_pct(100), lv_pct(100));
+    lv_obj_remove_flag(grid, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(grid, grid_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+    return grid;
 }
 
 /* ---------------- UI widgets ---------------- */
@@ -177,16 +413,14 @@ static lv_obj_t *mk_box(lv_obj_t *parent, int w, int h, uint32_t hex, const char
 {
     lv_obj_t *o = lv_obj_create(parent);
     lv_obj_set_size(o, (lv_coord_t)w, (lv_coord_t)h);
+    lv_obj_add_style(o, &ui_style_hwtest_box, 0);
     lv_obj_set_style_bg_color(o, lv_color_hex(hex), 0);
-    lv_obj_set_style_border_width(o, 1, 0);
-    lv_obj_set_style_border_color(o, lv_color_hex(0x404040), 0);
-    lv_obj_set_style_radius(o, 0, 0);
     lv_obj_clear_flag(o, LV_OBJ_FLAG_SCROLLABLE);
 
     lv_obj_t *l = lv_label_create(o);
     lv_label_set_text(l, txt);
     lv_obj_center(l);
-    lv_obj_set_style_text_color(l, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_add_style(l, &ui_style_text_light, 0);
     return o;
 }
 
@@ -300,17 +534,6 @@ void ui_hwtest_init(const hwtest_cfg_t *cfg)
     // Calculate minor grid spacing (1/4 of major for good visual density)
     int grid_minor = grid_major / 4;
 
-    // Ensure we don't exceed point array capacity
-    // Max lines = (W/minor + H/minor + W/major + H/major) * 2 points per line
-    int estimated_points = ((W/grid_minor + H/grid_minor + W/grid_major + H/grid_major) * 2);
-    if (estimated_points > MAX_GRID_POINTS) {
-        // Scale up spacing if we'd exceed capacity
-        int scale = (estimated_points / MAX_GRID_POINTS) + 1;
-        grid_minor *= scale;
-        grid_major *= scale;
-        ESP_LOGW(TAG, "Grid scaled up by %dx to fit point array limit", scale);
-    }
-
     // Calculate grid line counts for display
     int minor_lines_v = (W / grid_minor) + 1;  // Vertical lines (including edges)
     int minor_lines_h = (H / grid_minor) + 1;  // Horizontal lines
@@ -320,9 +543,13 @@ void ui_hwtest_init(const hwtest_cfg_t *cfg)
 
     ESP_LOGI(TAG, "Build gridlines: %dx%d screen, minor=%dpx, major=%dpx, total_lines=%d",
              W, H, grid_minor, grid_major, total_lines);
-    grid_build(scr, grid_minor, grid_major);
+    // Everything that never changes goes into one layer that is baked into a
+    // single image below, so the moving bar and touch dot don't redraw the
+    // grid and labels under them on every frame
+    lv_obj_t *bg = ui_layer_cache_create(scr, lv_color_hex(0xEEEEEE));
+    lv_obj_t *grid = grid_create(bg, grid_minor, grid_major);
 
-    lv_obj_t *title = lv_label_create(scr);
+    lv_obj_t *title = lv_label_create(bg);
     lv_label_set_text(title, (s_cfg.title ? s_cfg.title : "HW Bring-up Toolkit (LVGL)"));
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 4);
 
@@ -331,29 +558,28 @@ void ui_hwtest_init(const hwtest_cfg_t *cfg)
     lv_label_set_text(s_status_label, (s_cfg.title ? s_cfg.title : "HW Bring-up Toolkit"));
     lv_obj_align(s_status_label, LV_ALIGN_TOP_MID, 0, 22);
 
-    // Grid info (shows line count - each line is a UI element affecting FPS)
-    s_grid_info_label = lv_label_create(scr);
+    // Grid info (all lines are drawn by the single grid widget if it is baked)
+    lv_obj_t *grid_info_label = lv_label_create(bg);
     char grid_buf[64];
-    snprintf(grid_buf, sizeof(grid_buf), "Grid: %d lines (Major:%dpx Minor:%dpx)",
-             total_lines, grid_minor, grid_major);
-    lv_label_set_text(s_grid_info_label, grid_buf);
-    lv_obj_align(s_grid_info_label, LV_ALIGN_TOP_LEFT, 4, 40);
+    snprintf(grid_buf, sizeof(grid_buf), "Grid: %d lines, 1 obj (Major:%dpx Minor:%dpx)",
+             total_lines, grid_major, grid_minor);
+    lv_label_set_text(grid_info_label, grid_buf);
+    lv_obj_align(grid_info_label, LV_ALIGN_TOP_LEFT, 4, 40);
 
     // Corner markers
     ESP_LOGI(TAG, "Create the corner markers");
     uint32_t box_border = 4;
-    lv_obj_t *box_tl = mk_box(scr, 44, 24, 0x202020, "TL"); lv_obj_align(box_tl, LV_ALIGN_TOP_LEFT, box_border, box_border);
-    lv_obj_t *box_tr = mk_box(scr, 44, 24, 0x202020, "TR"); lv_obj_align(box_tr, LV_ALIGN_TOP_RIGHT, -box_border, box_border);
-    lv_obj_t *box_bl = mk_box(scr, 44, 24, 0x202020, "BL"); lv_obj_align(box_bl, LV_ALIGN_BOTTOM_LEFT, box_border, -box_border);
-    lv_obj_t *box_br = mk_box(scr, 44, 24, 0x202020, "BR"); lv_obj_align(box_br, LV_ALIGN_BOTTOM_RIGHT, -box_border, -box_border);
+    lv_obj_t *box_tl = mk_box(bg, 44, 24, 0x202020, "TL"); lv_obj_align(box_tl, LV_ALIGN_TOP_LEFT, box_border, box_border);
+    lv_obj_t *box_tr = mk_box(bg, 44, 24, 0x202020, "TR"); lv_obj_align(box_tr, LV_ALIGN_TOP_RIGHT, -box_border, box_border);
+    lv_obj_t *box_bl = mk_box(bg, 44, 24, 0x202020, "BL"); lv_obj_align(box_bl, LV_ALIGN_BOTTOM_LEFT, box_border, -box_border);
+    lv_obj_t *box_br = mk_box(bg, 44, 24, 0x202020, "BR"); lv_obj_align(box_br, LV_ALIGN_BOTTOM_RIGHT, -box_border, -box_border);
 
     ESP_LOGI(TAG, "Create the color swatches");
-    lv_obj_t *sw = lv_obj_create(scr);
+    lv_obj_t *sw = lv_obj_create(bg);
     lv_obj_set_size(sw, (lv_coord_t)(W - 8), (48 + 16));
     lv_obj_align(sw, LV_ALIGN_BOTTOM_MID, 0, -32);
-    lv_obj_set_style_bg_color(sw, lv_color_hex(0x000000), 0);
-    lv_obj_set_style_border_width(sw, 1, 0);
-    lv_obj_set_style_border_color(sw, lv_color_hex(0x404040), 0);
+    lv_obj_add_style(sw, &ui_style_hwtest_box, 0);
+    lv_obj_add_style(sw, &ui_style_screen_dark, 0);
     lv_obj_set_style_pad_all(sw, 4, 0);
     lv_obj_set_style_pad_gap(sw, 4, 0);
     lv_obj_set_flex_flow(sw, LV_FLEX_FLOW_ROW_WRAP);
@@ -372,6 +598,13 @@ void ui_hwtest_init(const hwtest_cfg_t *cfg)
     mk_box(sw, boxw, boxh, 0xFFFF00, "Y");
     mk_box(sw, boxw, boxh, 0x000000, "K");
 
+    if (ui_layer_cache_bake(bg) == bg) {
+        uint32_t objs = grid_use_objects(grid);
+        snprintf(grid_buf, sizeof(grid_buf), "Grid: %d lines, %u objs (Major:%dpx Minor:%dpx)",
+                 total_lines, (unsigned)objs, grid_major, grid_minor);
+        lv_label_set_text(grid_info_label, grid_buf);
+    }
+
     // Touch label (just above swatches)
     s_touch_label = lv_label_create(scr);
     lv_label_set_text(s_touch_label, "Touch: x=? y=?");
@@ -380,10 +613,7 @@ void ui_hwtest_init(const hwtest_cfg_t *cfg)
     ESP_LOGI(TAG, "Create the touch dot");
     s_touch_dot = lv_obj_create(scr);
     lv_obj_set_size(s_touch_dot, 12, 12);
-    lv_obj_set_style_radius(s_touch_dot, LV_RADIUS_CIRCLE, 0);
-    lv_obj_set_style_bg_color(s_touch_dot, lv_color_hex(0xFFFFFF), 0);
-    lv_obj_set_style_border_width(s_touch_dot, 2, 0);
-    lv_obj_set_style_border_color(s_touch_dot, lv_color_hex(0xFF0000), 0);
+    lv_obj_add_style(s_touch_dot, &ui_style_hwtest_dot, 0);
     lv_obj_clear_flag(s_touch_dot, LV_OBJ_FLAG_SCROLLABLE);
     lv_obj_set_pos(s_touch_dot, (lv_coord_t)(W / 2), (lv_coord_t)(H / 2));
 
@@ -391,8 +621,7 @@ void ui_hwtest_init(const hwtest_cfg_t *cfg)
     lv_obj_t *touch_layer = lv_obj_create(scr);
     lv_obj_set_size(touch_layer, (lv_coord_t)W, (lv_coord_t)H);
     lv_obj_align(touch_layer, LV_ALIGN_CENTER, 0, 0);
-    lv_obj_set_style_bg_opa(touch_layer, LV_OPA_TRANSP, 0);
-    lv_obj_set_style_border_width(touch_layer, 0, 0);
+    lv_obj_add_style(touch_layer, &ui_style_transparent, 0);
     lv_obj_clear_flag(touch_layer, LV_OBJ_FLAG_SCROLLABLE);
     lv_obj_add_event_cb(touch_layer, touch_layer_cb, LV_EVENT_ALL, NULL);
 
@@ -400,9 +629,7 @@ void ui_hwtest_init(const hwtest_cfg_t *cfg)
     s_anim_bar = lv_obj_create(scr);
     lv_obj_set_size(s_anim_bar, 16, (lv_coord_t)(H - 16));
     lv_obj_align(s_anim_bar, LV_ALIGN_TOP_LEFT, 0, 8);
-    lv_obj_set_style_bg_color(s_anim_bar, lv_color_hex(0x00FFFF), 0);
-    lv_obj_set_style_bg_opa(s_anim_bar, LV_OPA_30, 0);
-    lv_obj_set_style_border_width(s_anim_bar, 0, 0);
+    lv_obj_add_style(s_anim_bar, &ui_style_hwtest_bar, 0);
     lv_obj_clear_flag(s_anim_bar, LV_OBJ_FLAG_SCROLLABLE);
     s_bar_x = 0;
     s_bar_dir = 1;
@@ -465,6 +692,10 @@ void ui_hwtest_init(const hwtest_cfg_t *cfg)
 
 
 
+#if CONFIG_APP_HWTEST_LATENCY
+    latency_init(scr);
+#endif
+
     // Timers
     ESP_LOGI(TAG, "Set Timers for animation");
     s_anim_timer = lv_timer_create(anim_timer_cb, 30, NULL);
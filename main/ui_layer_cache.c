@@ -0,0 +1,86 @@
+/**
+ * @file ui_layer_cache.c
+ * @brief Pre-rendered static background layers
+ */
+
+#include "ui_layer_cache.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+
+static const char *TAG = "ui_layer_cache";
+
+lv_obj_t *ui_layer_cache_create(lv_obj_t *parent, lv_color_t bg)
+{
+    lv_obj_t *layer = lv_obj_create(parent);
+    lv_obj_remove_style_all(layer);
+    lv_obj_set_size(layer, lv_pct(100), lv_pct(100));
+    lv_obj_set_pos(layer, 0, 0);
+    lv_obj_set_style_bg_color(layer, bg, 0);
+    lv_obj_set_style_bg_opa(layer, LV_OPA_COVER, 0);
+    lv_obj_remove_flag(layer, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+    return layer;
+}
+
+#if LV_USE_SNAPSHOT
+
+static void image_delete_cb(lv_event_t *e)
+{
+    lv_draw_buf_t *buf = (lv_draw_buf_t *)lv_event_get_user_data(e);
+    heap_caps_free(buf->data);
+    free(buf);
+}
+
+lv_obj_t *ui_layer_cache_bake(lv_obj_t *layer)
+{
+    lv_obj_update_layout(layer);
+    int32_t w = lv_obj_get_width(layer);
+    int32_t h = lv_obj_get_height(layer);
+    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+    size_t size = (size_t)stride * h;
+
+    lv_draw_buf_t *buf = calloc(1, sizeof(lv_draw_buf_t));
+    void *data = heap_caps_aligned_alloc(LV_DRAW_BUF_ALIGN, size, MALLOC_CAP_SPIRAM);
+    if (!buf || !data) {
+        ESP_LOGW(TAG, "No PSRAM for a %" PRId32 "x%" PRId32 " layer; keeping live objects", w, h);
+        free(buf);
+        heap_caps_free(data);
+        return layer;
+    }
+
+    lv_draw_buf_init(buf, w, h, LV_COLOR_FORMAT_RGB565, stride, data, size);
+    if (lv_snapshot_take_to_draw_buf(layer, LV_COLOR_FORMAT_RGB565, buf) != LV_RESULT_OK) {
+        ESP_LOGW(TAG, "Snapshot failed; keeping live objects");
+        free(buf);
+        heap_caps_free(data);
+        return layer;
+    }
+
+    lv_obj_t *parent = lv_obj_get_parent(layer);
+    lv_obj_t *img = lv_image_create(parent);
+    lv_image_set_src(img, buf);
+    lv_obj_set_pos(img, lv_obj_get_x(layer), lv_obj_get_y(layer));
+    lv_obj_remove_flag(img, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(img, image_delete_cb, LV_EVENT_DELETE, buf);
+    lv_obj_move_to_index(img, lv_obj_get_index(layer));
+
+    uint32_t children = lv_obj_get_child_count(layer);
+    lv_obj_delete(layer);
+
+    ESP_LOGI(TAG, "Baked %" PRId32 "x%" PRId32 " layer (%u KB PSRAM, %u objects freed)",
+             w, h, (unsigned)(size / 1024), (unsigned)children);
+    return img;
+}
+
+#else
+
+lv_obj_t *ui_layer_cache_bake(lv_obj_t *layer)
+{
+    ESP_LOGW(TAG, "LV_USE_SNAPSHOT is off; static layer stays as live objects");
+    return layer;
+}
+
+#endif // LV_USE_SNAPSHOT
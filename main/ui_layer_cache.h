@@ -0,0 +1,48 @@
+/**
+ * @file ui_layer_cache.h
+ * @brief Pre-rendered static background layers
+ *
+ * Build static decoration (grids, frames, labels that never change) inside
+ * a layer, then bake it: the layer is rendered once with lv_snapshot into an
+ * opaque RGB565 buffer in PSRAM and replaced by a single image. Whatever
+ * moves on top then only costs a row copy of the image where it was,
+ * instead of re-rasterizing every object under it.
+ *
+ * Call from the LVGL thread (with the LVGL lock held).
+ */
+
+#pragma once
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Create a layer covering @p parent to build static content in
+ *
+ * The layer is opaque (the image it becomes must be), not clickable and not
+ * scrollable, with no padding so children align as they would on @p parent.
+ *
+ * @param parent Usually the screen
+ * @param bg Background color
+ * @return The layer
+ */
+lv_obj_t *ui_layer_cache_create(lv_obj_t *parent, lv_color_t bg);
+
+/**
+ * @brief Render @p layer once and replace it (and its children) by an image
+ *
+ * The image takes the layer's place in the z-order and frees its buffer when
+ * deleted. If snapshots are disabled (LV_USE_SNAPSHOT) or PSRAM is short,
+ * the layer stays as live objects and is returned unchanged.
+ *
+ * @param layer Layer from ui_layer_cache_create()
+ * @return The image, or @p layer if it could not be baked
+ */
+lv_obj_t *ui_layer_cache_bake(lv_obj_t *layer);
+
+#ifdef __cplusplus
+}
+#endif
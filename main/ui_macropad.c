@@ -5,9 +5,8 @@
 
 #include "ui_macropad.h"
 #include "app_hid_macropad.h"
+#include "ui_styles.h"
 #include "esp_log.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
 
 static const char *TAG = "ui_macropad";
 
@@ -23,54 +22,80 @@ static uint8_t s_button_count = 0;
 static app_hid_t *s_hid = NULL;
 static lv_obj_t *s_status_label = NULL;
 
-/**
- * @brief Button click event handler
- */
-static void button_click_handler(lv_event_t *e)
-{
-    lv_obj_t *btn = lv_event_get_target(e);
-    lv_event_code_t code = lv_event_get_code(e);
+static bool s_button_held[MAX_BUTTONS];
 
-    if (code != LV_EVENT_CLICKED) {
-        return;
+// Key-ups the HID queue refused; retried until they go out, so a key is
+// never left down on the host
+#define KEY_UP_RETRY_MS 10
+static bool s_up_pending[MAX_BUTTONS];
+static lv_timer_t *s_up_retry_timer = NULL;
+
+static bool post_key_up(uint8_t btn_idx)
+{
+    if (app_hid_macropad_key_up(s_hid, s_button_modifiers[btn_idx], s_button_keycodes[btn_idx]) != ESP_OK) {
+        return false;
     }
+    s_button_held[btn_idx] = false;
+    s_up_pending[btn_idx] = false;
+    return true;
+}
 
-    // Find button index
-    uint8_t btn_idx = 0xFF;
+static void up_retry_cb(lv_timer_t *timer)
+{
+    bool left = false;
     for (uint8_t i = 0; i < s_button_count; i++) {
-        if (s_buttons[i] == btn) {
-            btn_idx = i;
-            break;
+        if (s_up_pending[i] && !post_key_up(i)) {
+            left = true;
         }
     }
+    if (!left) {
+        lv_timer_pause(timer);
+    }
+}
 
-    if (btn_idx == 0xFF) {
-        ESP_LOGE(TAG, "Button not found in array");
+/**
+ * @brief Button press/release handler
+ *
+ * Key-down on press and key-up on release (or when the finger slides off),
+ * queued to the HID task so nothing blocks the LVGL task. A refused down
+ * is dropped; a refused up stays pending and is retried by a timer.
+ */
+static void button_event_handler(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    uint8_t btn_idx = (uint8_t)(uintptr_t)lv_event_get_user_data(e);
+    if (btn_idx >= s_button_count) {
         return;
     }
 
     uint8_t modifier = s_button_modifiers[btn_idx];
     uint8_t keycode = s_button_keycodes[btn_idx];
+    bool down = (code == LV_EVENT_PRESSED);
 
-    ESP_LOGI(TAG, "Button %u clicked: mod=0x%02X key=0x%02X", btn_idx, modifier, keycode);
+    if (down == s_button_held[btn_idx] || (!down && s_up_pending[btn_idx])) {
+        return;  // RELEASED after PRESS_LOST, a repeated PRESSED, or up already pending
+    }
 
-    // Send key press
-    esp_err_t ret = app_hid_macropad_send_key(s_hid, modifier, keycode);
-    if (ret != ESP_OK) {
-        ESP_LOGW(TAG, "Failed to send key: %s", esp_err_to_name(ret));
+    if (!down) {
+        if (!post_key_up(btn_idx)) {
+            ESP_LOGW(TAG, "Button %u up not queued, retrying", btn_idx);
+            s_up_pending[btn_idx] = true;
+            lv_timer_resume(s_up_retry_timer);
+        }
         return;
     }
 
-    // Brief delay
-    vTaskDelay(pdMS_TO_TICKS(50));
-
-    // Release all keys
-    app_hid_macropad_release_all(s_hid);
+    esp_err_t ret = app_hid_macropad_key_down(s_hid, modifier, keycode);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Button %u down not queued: %s", btn_idx, esp_err_to_name(ret));
+        return;
+    }
+    s_button_held[btn_idx] = true;
 
     // Update status
     if (s_status_label) {
         char status_text[32];
-        snprintf(status_text, sizeof(status_text), "Sent: Button %u", btn_idx);
+        snprintf(status_text, sizeof(status_text), "Key: Button %u", btn_idx);
         lv_label_set_text(s_status_label, status_text);
     }
 }
@@ -93,20 +118,23 @@ void ui_macropad_init(const macropad_cfg_t *cfg)
     ESP_LOGI(TAG, "Initializing macropad UI (%ux%u, %ux%u buttons)",
              cfg->hres, cfg->vres, cfg->button_rows, cfg->button_cols);
 
+    s_up_retry_timer = lv_timer_create(up_retry_cb, KEY_UP_RETRY_MS, NULL);
+    lv_timer_pause(s_up_retry_timer);
+
     // Create screen
     lv_obj_t *scr = lv_scr_act();
-    lv_obj_set_style_bg_color(scr, lv_color_hex(0x000000), 0);
+    lv_obj_add_style(scr, &ui_style_screen_dark, 0);
 
     // Title label
     lv_obj_t *title = lv_label_create(scr);
     lv_label_set_text(title, "USB Macropad");
-    lv_obj_set_style_text_color(title, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_add_style(title, &ui_style_text_light, 0);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
 
     // Status label
     s_status_label = lv_label_create(scr);
     lv_label_set_text(s_status_label, "Ready");
-    lv_obj_set_style_text_color(s_status_label, lv_color_hex(0x00FF00), 0);
+    lv_obj_add_style(s_status_label, &ui_style_text_status, 0);
     lv_obj_align(s_status_label, LV_ALIGN_TOP_MID, 0, 35);
 
     // Calculate button dimensions and spacing
@@ -145,16 +173,19 @@ void ui_macropad_init(const macropad_cfg_t *cfg)
             lv_obj_set_size(btn, btn_width, btn_height);
 
             // Style button
-            lv_obj_set_style_bg_color(btn, lv_color_hex(0x333333), LV_STATE_DEFAULT);
-            lv_obj_set_style_bg_color(btn, lv_color_hex(0x0088FF), LV_STATE_PRESSED);
+            lv_obj_add_style(btn, &ui_style_key, LV_STATE_DEFAULT);
+            lv_obj_add_style(btn, &ui_style_key_pressed, LV_STATE_PRESSED);
 
             // Add label to button
             lv_obj_t *label = lv_label_create(btn);
             lv_label_set_text(label, s_button_labels[btn_idx]);
             lv_obj_center(label);
 
-            // Add click event handler
-            lv_obj_add_event_cb(btn, button_click_handler, LV_EVENT_CLICKED, NULL);
+            // Key edges: down on press, up on release or slide-off
+            void *idx = (void *)(uintptr_t)btn_idx;
+            lv_obj_add_event_cb(btn, button_event_handler, LV_EVENT_PRESSED, idx);
+            lv_obj_add_event_cb(btn, button_event_handler, LV_EVENT_RELEASED, idx);
+            lv_obj_add_event_cb(btn, button_event_handler, LV_EVENT_PRESS_LOST, idx);
         }
     }
 
@@ -0,0 +1,155 @@
+/**
+ * @file ui_styles.c
+ * @brief Shared constant styles for the UI modules
+ */
+
+#include "ui_styles.h"
+
+#define UI_HEX(c) LV_COLOR_MAKE(((c) >> 16) & 0xFF, ((c) >> 8) & 0xFF, (c) & 0xFF)
+
+// Bg-only style, used for the button colors
+#define UI_BG_STYLE(name, hex)                          \
+    static const lv_style_const_prop_t name##_props[] = { \
+        LV_STYLE_CONST_BG_COLOR(UI_HEX(hex)),           \
+        LV_STYLE_CONST_PROPS_END                        \
+    };                                                  \
+    LV_STYLE_CONST_INIT(name, name##_props)
+
+// ========================== Common ==========================
+
+UI_BG_STYLE(ui_style_screen_dark, 0x000000);
+
+static const lv_style_const_prop_t text_status_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(UI_HEX(0x00FF00)),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_text_status, text_status_props);
+
+static const lv_style_const_prop_t text_light_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(UI_HEX(0xFFFFFF)),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_text_light, text_light_props);
+
+static const lv_style_const_prop_t transparent_props[] = {
+    LV_STYLE_CONST_BG_OPA(LV_OPA_TRANSP),
+    LV_STYLE_CONST_BORDER_WIDTH(0),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_transparent, transparent_props);
+
+// ========================== HW test ==========================
+
+static const lv_style_const_prop_t hwtest_box_props[] = {
+    LV_STYLE_CONST_BORDER_WIDTH(1),
+    LV_STYLE_CONST_BORDER_COLOR(UI_HEX(0x404040)),
+    LV_STYLE_CONST_RADIUS(0),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_hwtest_box, hwtest_box_props);
+
+static const lv_style_const_prop_t hwtest_dot_props[] = {
+    LV_STYLE_CONST_RADIUS(LV_RADIUS_CIRCLE),
+    LV_STYLE_CONST_BG_COLOR(UI_HEX(0xFFFFFF)),
+    LV_STYLE_CONST_BORDER_WIDTH(2),
+    LV_STYLE_CONST_BORDER_COLOR(UI_HEX(0xFF0000)),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_hwtest_dot, hwtest_dot_props);
+
+static const lv_style_const_prop_t hwtest_bar_props[] = {
+    LV_STYLE_CONST_BG_COLOR(UI_HEX(0x00FFFF)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_30),
+    LV_STYLE_CONST_BORDER_WIDTH(0),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_hwtest_bar, hwtest_bar_props);
+
+static const lv_style_const_prop_t hwtest_grid_minor_props[] = {
+    LV_STYLE_CONST_BG_COLOR(UI_HEX(0xAAAAAA)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_50),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_hwtest_grid_minor, hwtest_grid_minor_props);
+
+static const lv_style_const_prop_t hwtest_grid_major_props[] = {
+    LV_STYLE_CONST_BG_COLOR(UI_HEX(0x000000)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_hwtest_grid_major, hwtest_grid_major_props);
+
+// ========================== Trackpad ==========================
+
+static const lv_style_const_prop_t trackpad_zone_props[] = {
+    LV_STYLE_CONST_BG_COLOR(UI_HEX(0x4a90d9)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_10),
+    LV_STYLE_CONST_BORDER_WIDTH(1),
+    LV_STYLE_CONST_BORDER_COLOR(UI_HEX(0x4a90d9)),
+    LV_STYLE_CONST_BORDER_OPA(LV_OPA_30),
+    LV_STYLE_CONST_RADIUS(0),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_trackpad_zone, trackpad_zone_props);
+
+static const lv_style_const_prop_t trackpad_zone_text_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(UI_HEX(0x4a90d9)),
+    LV_STYLE_CONST_TEXT_OPA(LV_OPA_50),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_trackpad_zone_text, trackpad_zone_text_props);
+
+static const lv_style_const_prop_t trackpad_zone_hl_props[] = {
+    LV_STYLE_CONST_BG_COLOR(UI_HEX(0x4a90d9)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_20),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_trackpad_zone_hl, trackpad_zone_hl_props);
+
+static const lv_style_const_prop_t trackpad_status_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(UI_HEX(0x888888)),
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_14),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_trackpad_status, trackpad_status_props);
+
+static const lv_style_const_prop_t trackpad_version_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(UI_HEX(0x555555)),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_trackpad_version, trackpad_version_props);
+
+static const lv_style_const_prop_t trackpad_mode_btn_props[] = {
+    LV_STYLE_CONST_BG_COLOR(UI_HEX(0x333355)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_80),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_trackpad_mode_btn, trackpad_mode_btn_props);
+
+static const lv_style_const_prop_t trackpad_cursor_props[] = {
+    LV_STYLE_CONST_RADIUS(LV_RADIUS_CIRCLE),
+    LV_STYLE_CONST_BG_COLOR(UI_HEX(0xff6b6b)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_70),
+    LV_STYLE_CONST_BORDER_WIDTH(2),
+    LV_STYLE_CONST_BORDER_COLOR(UI_HEX(0xff6b6b)),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_trackpad_cursor, trackpad_cursor_props);
+
+// ========================== Macropad / gamepad keys ==========================
+
+UI_BG_STYLE(ui_style_key, 0x333333);
+UI_BG_STYLE(ui_style_key_pressed, 0x0088FF);
+
+// Pressed colors are the base colors lightened by 50 (lv_color_lighten),
+// precomputed because const styles need constant values
+UI_BG_STYLE(ui_style_pad_dpad, 0x444444);
+UI_BG_STYLE(ui_style_pad_dpad_pressed, 0x686868);
+UI_BG_STYLE(ui_style_pad_a, 0x00AA00);
+UI_BG_STYLE(ui_style_pad_a_pressed, 0x32BA32);
+UI_BG_STYLE(ui_style_pad_b, 0xAA0000);
+UI_BG_STYLE(ui_style_pad_b_pressed, 0xBA3232);
+UI_BG_STYLE(ui_style_pad_x, 0x0000AA);
+UI_BG_STYLE(ui_style_pad_x_pressed, 0x3232BA);
+UI_BG_STYLE(ui_style_pad_y, 0xAAAA00);
+UI_BG_STYLE(ui_style_pad_y_pressed, 0xBABA32);
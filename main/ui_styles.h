@@ -0,0 +1,62 @@
+/**
+ * @file ui_styles.h
+ * @brief Shared constant styles for the UI modules
+ *
+ * Each style is a const lv_style_t in flash (LV_STYLE_CONST_INIT). Objects
+ * reference them with lv_obj_add_style() instead of lv_obj_set_style_*(),
+ * which would allocate a local style per object. Only values that really
+ * differ per object (positions, sizes, swatch colors) stay local.
+ */
+
+#pragma once
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ========================== Common ==========================
+
+extern const lv_style_t ui_style_screen_dark;     ///< Black screen background
+extern const lv_style_t ui_style_text_status;     ///< Green status text
+extern const lv_style_t ui_style_text_light;      ///< White text (titles, labels on dark boxes)
+extern const lv_style_t ui_style_transparent;     ///< No background, no border (touch receivers)
+
+// ========================== HW test ==========================
+
+extern const lv_style_t ui_style_hwtest_box;      ///< Square box with a thin grey border
+extern const lv_style_t ui_style_hwtest_dot;      ///< Touch dot: white circle, red ring
+extern const lv_style_t ui_style_hwtest_bar;      ///< Translucent cyan sweep bar
+extern const lv_style_t ui_style_hwtest_grid_minor; ///< Minor grid line object (grey, 50 %)
+extern const lv_style_t ui_style_hwtest_grid_major; ///< Major grid line object (black)
+
+// ========================== Trackpad ==========================
+
+extern const lv_style_t ui_style_trackpad_zone;       ///< Scroll zone frame
+extern const lv_style_t ui_style_trackpad_zone_text;  ///< Scroll zone arrows
+extern const lv_style_t ui_style_trackpad_zone_hl;    ///< Active scroll zone highlight
+extern const lv_style_t ui_style_trackpad_status;     ///< Grey status text
+extern const lv_style_t ui_style_trackpad_version;    ///< Dim version text
+extern const lv_style_t ui_style_trackpad_mode_btn;   ///< Mode switch button
+extern const lv_style_t ui_style_trackpad_cursor;     ///< Cursor circle
+
+// ========================== Macropad / gamepad keys ==========================
+
+extern const lv_style_t ui_style_key;             ///< Macropad key
+extern const lv_style_t ui_style_key_pressed;     ///< Macropad key, LV_STATE_PRESSED
+
+extern const lv_style_t ui_style_pad_dpad;        ///< Gamepad D-pad button
+extern const lv_style_t ui_style_pad_dpad_pressed;
+extern const lv_style_t ui_style_pad_a;           ///< Gamepad action buttons (green/red/blue/yellow)
+extern const lv_style_t ui_style_pad_a_pressed;
+extern const lv_style_t ui_style_pad_b;
+extern const lv_style_t ui_style_pad_b_pressed;
+extern const lv_style_t ui_style_pad_x;
+extern const lv_style_t ui_style_pad_x_pressed;
+extern const lv_style_t ui_style_pad_y;
+extern const lv_style_t ui_style_pad_y_pressed;
+
+#ifdef __cplusplus
+}
+#endif
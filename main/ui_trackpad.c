@@ -5,10 +5,13 @@
 
 #include "ui_trackpad.h"
 #include "app_trackpad.h" // New service
+#include "ui_layer_cache.h"
+#include "ui_styles.h"
 #include "sdkconfig.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "esp_lvgl_port.h"
+#include "app_lvgl.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
@@ -58,44 +61,99 @@ static void update_status(const char *text)
     }
 }
 
-// ========================== UI Update Timer ========================== 
+/**
+ * @brief Static scroll zone frame (fill, border, arrows), baked with the background
+ */
+static void mk_scroll_zone(lv_obj_t *parent, int32_t x, int32_t y, int32_t w, int32_t h,
+                           const char *arrows)
+{
+    lv_obj_t *zone = lv_obj_create(parent);
+    lv_obj_set_size(zone, w, h);
+    lv_obj_set_pos(zone, x, y);
+    lv_obj_add_style(zone, &ui_style_trackpad_zone, 0);
+    lv_obj_clear_flag(zone, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t *label = lv_label_create(zone);
+    lv_label_set_text(label, arrows);
+    lv_obj_add_style(label, &ui_style_trackpad_zone_text, 0);
+    lv_obj_center(label);
+}
+
+/**
+ * @brief Live highlight drawn over a zone while it is in use (hidden otherwise)
+ */
+static lv_obj_t *mk_zone_highlight(lv_obj_t *parent, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    lv_obj_t *hl = lv_obj_create(parent);
+    lv_obj_remove_style_all(hl);
+    lv_obj_set_size(hl, w, h);
+    lv_obj_set_pos(hl, x, y);
+    lv_obj_add_style(hl, &ui_style_trackpad_zone_hl, 0);
+    lv_obj_clear_flag(hl, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_flag(hl, LV_OBJ_FLAG_HIDDEN);
+    return hl;
+}
+
+static void set_zone_highlight(lv_obj_t *hl, bool on)
+{
+    if (!hl || lv_obj_has_flag(hl, LV_OBJ_FLAG_HIDDEN) == !on) return;
+    if (on) {
+        lv_obj_clear_flag(hl, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(hl, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+// ========================== UI Updates ==========================
+
+// Set by the poll task when an update is queued, cleared by the LVGL task
+// when it runs, so bursts of changes collapse into one lv_async_call
+static volatile bool s_update_pending = false;
 
 /**
- * @brief Timer callback to update UI cursor from shared state
- * Runs in LVGL task context, so no locking needed
+ * @brief Apply the latest trackpad status to the cursor and zone highlights
+ * Runs in LVGL task context (lv_async_call), so no locking needed
  */
-static void ui_update_timer_cb(lv_timer_t *timer)
+static void ui_apply_status(void *arg)
 {
-    (void)timer;
+    (void)arg;
+    s_update_pending = false;
 
     if (!s_cursor) return;
 
-    // Get status from service
+    // Get status from service (latest, not the one that triggered this)
     app_trackpad_status_t status;
     app_trackpad_get_status(&status);
 
     if (status.touched) {
         lv_obj_set_pos(s_cursor, status.x - 8, status.y - 8);
         lv_obj_clear_flag(s_cursor, LV_OBJ_FLAG_HIDDEN);
-        
+
         // Update scroll zone highlights
-        if (s_scroll_zone_v) {
-             lv_obj_set_style_bg_opa(s_scroll_zone_v, (status.zone == TRACKPAD_ZONE_SCROLL_V) ? LV_OPA_30 : LV_OPA_10, 0);
-        }
-        if (s_scroll_zone_h) {
-             lv_obj_set_style_bg_opa(s_scroll_zone_h, (status.zone == TRACKPAD_ZONE_SCROLL_H) ? LV_OPA_30 : LV_OPA_10, 0);
-        }
+        set_zone_highlight(s_scroll_zone_v, status.zone == TRACKPAD_ZONE_SCROLL_V);
+        set_zone_highlight(s_scroll_zone_h, status.zone == TRACKPAD_ZONE_SCROLL_H);
     } else {
         lv_obj_add_flag(s_cursor, LV_OBJ_FLAG_HIDDEN);
-        if (s_scroll_zone_v) lv_obj_set_style_bg_opa(s_scroll_zone_v, LV_OPA_10, 0);
-        if (s_scroll_zone_h) lv_obj_set_style_bg_opa(s_scroll_zone_h, LV_OPA_10, 0);
+        set_zone_highlight(s_scroll_zone_v, false);
+        set_zone_highlight(s_scroll_zone_h, false);
     }
+}
 
-    // Heartbeat for debug
-    static uint32_t frame_count = 0;
-    if (++frame_count % 30 == 0) {
-        // ESP_LOGI(TAG, "Heartbeat... (Touch: %d)", status.touched);
-    }
+/**
+ * @brief Trackpad status changed (poll task context)
+ *
+ * Only tries the LVGL lock: while LVGL is rendering the poll loop must not
+ * stall, so the update is reported undelivered and retried on the next poll.
+ */
+static bool ui_status_changed_cb(void *ctx)
+{
+    (void)ctx;
+    if (s_update_pending) return true;
+    if (!app_lvgl_lock(1)) return false;
+    s_update_pending = (lv_async_call(ui_apply_status, NULL) == LV_RESULT_OK);
+    app_lvgl_unlock();
+    app_lvgl_wake();
+    return s_update_pending;
 }
 
 // ========================== Mode Button Handler ========================== 
@@ -163,68 +221,49 @@ void ui_trackpad_init(const trackpad_cfg_t *cfg)
     lv_obj_set_style_bg_color(scr, lv_color_hex(0x1a1a2e), 0);
     lv_obj_clear_flag(scr, LV_OBJ_FLAG_SCROLLABLE);
 
+    // Static decoration (zone frames, arrows, version) is baked into one
+    // image; only the highlights, status, button and cursor stay live
+    lv_obj_t *bg = ui_layer_cache_create(scr, lv_color_hex(0x1a1a2e));
+
     // Vertical scroll zone (right edge)
     if (s_scroll_w > 0) {
-        s_scroll_zone_v = lv_obj_create(scr);
-        lv_obj_set_size(s_scroll_zone_v, s_scroll_w, s_vres - s_scroll_h);
-        lv_obj_set_pos(s_scroll_zone_v, s_hres - s_scroll_w, 0);
-        lv_obj_set_style_bg_color(s_scroll_zone_v, lv_color_hex(0x4a90d9), 0);
-        lv_obj_set_style_bg_opa(s_scroll_zone_v, LV_OPA_10, 0);
-        lv_obj_set_style_border_width(s_scroll_zone_v, 1, 0);
-        lv_obj_set_style_border_color(s_scroll_zone_v, lv_color_hex(0x4a90d9), 0);
-        lv_obj_set_style_border_opa(s_scroll_zone_v, LV_OPA_30, 0);
-        lv_obj_set_style_radius(s_scroll_zone_v, 0, 0);
-        lv_obj_clear_flag(s_scroll_zone_v, LV_OBJ_FLAG_SCROLLABLE);
-
-        // Vertical scroll indicator arrows
-        lv_obj_t *scroll_v_label = lv_label_create(s_scroll_zone_v);
-        lv_label_set_text(scroll_v_label, LV_SYMBOL_UP "\n\n" LV_SYMBOL_DOWN);
-        lv_obj_set_style_text_color(scroll_v_label, lv_color_hex(0x4a90d9), 0);
-        lv_obj_set_style_text_opa(scroll_v_label, LV_OPA_50, 0);
-        lv_obj_center(scroll_v_label);
+        mk_scroll_zone(bg, s_hres - s_scroll_w, 0, s_scroll_w, s_vres - s_scroll_h,
+                       LV_SYMBOL_UP "\n\n" LV_SYMBOL_DOWN);
     }
 
     // Horizontal scroll zone (top edge)
     if (s_scroll_h > 0) {
-        s_scroll_zone_h = lv_obj_create(scr);
-        lv_obj_set_size(s_scroll_zone_h, s_hres - s_scroll_w, s_scroll_h);
-        lv_obj_set_pos(s_scroll_zone_h, 0, 0);
-        lv_obj_set_style_bg_color(s_scroll_zone_h, lv_color_hex(0x4a90d9), 0);
-        lv_obj_set_style_bg_opa(s_scroll_zone_h, LV_OPA_10, 0);
-        lv_obj_set_style_border_width(s_scroll_zone_h, 1, 0);
-        lv_obj_set_style_border_color(s_scroll_zone_h, lv_color_hex(0x4a90d9), 0);
-        lv_obj_set_style_border_opa(s_scroll_zone_h, LV_OPA_30, 0);
-        lv_obj_set_style_radius(s_scroll_zone_h, 0, 0);
-        lv_obj_clear_flag(s_scroll_zone_h, LV_OBJ_FLAG_SCROLLABLE);
-
-        // Horizontal scroll indicator arrows
-        lv_obj_t *scroll_h_label = lv_label_create(s_scroll_zone_h);
-        lv_label_set_text(scroll_h_label, LV_SYMBOL_LEFT "  " LV_SYMBOL_RIGHT);
-        lv_obj_set_style_text_color(scroll_h_label, lv_color_hex(0x4a90d9), 0);
-        lv_obj_set_style_text_opa(scroll_h_label, LV_OPA_50, 0);
-        lv_obj_center(scroll_h_label);
+        mk_scroll_zone(bg, 0, 0, s_hres - s_scroll_w, s_scroll_h,
+                       LV_SYMBOL_LEFT "  " LV_SYMBOL_RIGHT);
+    }
+
+    // Version label (bottom-right, above scroll zone)
+    lv_obj_t *version_label = lv_label_create(bg);
+    lv_label_set_text(version_label, CONFIG_APP_VERSION);
+    lv_obj_add_style(version_label, &ui_style_trackpad_version, 0);
+    lv_obj_align(version_label, LV_ALIGN_BOTTOM_RIGHT, -(s_scroll_w + 5), -5);
+
+    ui_layer_cache_bake(bg);
+
+    if (s_scroll_w > 0) {
+        s_scroll_zone_v = mk_zone_highlight(scr, s_hres - s_scroll_w, 0, s_scroll_w, s_vres - s_scroll_h);
+    }
+    if (s_scroll_h > 0) {
+        s_scroll_zone_h = mk_zone_highlight(scr, 0, 0, s_hres - s_scroll_w, s_scroll_h);
     }
 
     // Status label (bottom center)
     s_status_label = lv_label_create(scr);
     lv_label_set_text(s_status_label, "Ready");
-    lv_obj_set_style_text_color(s_status_label, lv_color_hex(0x888888), 0);
-    lv_obj_set_style_text_font(s_status_label, &lv_font_montserrat_14, 0);
+    lv_obj_add_style(s_status_label, &ui_style_trackpad_status, 0);
     lv_obj_align(s_status_label, LV_ALIGN_BOTTOM_MID, 0, -5);
 
-    // Version label (bottom-right, above scroll zone)
-    lv_obj_t *version_label = lv_label_create(scr);
-    lv_label_set_text(version_label, CONFIG_APP_VERSION);
-    lv_obj_set_style_text_color(version_label, lv_color_hex(0x555555), 0);
-    lv_obj_align(version_label, LV_ALIGN_BOTTOM_RIGHT, -(s_scroll_w + 5), -5);
-
     // Mode switch button (bottom-left corner)
     if (s_mode_switch_cb) {
         s_mode_btn = lv_btn_create(scr);
         lv_obj_set_size(s_mode_btn, 50, 30);
         lv_obj_align(s_mode_btn, LV_ALIGN_BOTTOM_LEFT, 5, -5);
-        lv_obj_set_style_bg_color(s_mode_btn, lv_color_hex(0x333355), 0);
-        lv_obj_set_style_bg_opa(s_mode_btn, LV_OPA_80, 0);
+        lv_obj_add_style(s_mode_btn, &ui_style_trackpad_mode_btn, 0);
         lv_obj_add_event_cb(s_mode_btn, mode_btn_handler, LV_EVENT_CLICKED, NULL);
 
         lv_obj_t *btn_label = lv_label_create(s_mode_btn);
@@ -235,11 +274,7 @@ void ui_trackpad_init(const trackpad_cfg_t *cfg)
     // Cursor indicator (16x16 circle, initially hidden)
     s_cursor = lv_obj_create(scr);
     lv_obj_set_size(s_cursor, 16, 16);
-    lv_obj_set_style_radius(s_cursor, LV_RADIUS_CIRCLE, 0);
-    lv_obj_set_style_bg_color(s_cursor, lv_color_hex(0xff6b6b), 0);
-    lv_obj_set_style_bg_opa(s_cursor, LV_OPA_70, 0);
-    lv_obj_set_style_border_width(s_cursor, 2, 0);
-    lv_obj_set_style_border_color(s_cursor, lv_color_hex(0xff6b6b), 0);
+    lv_obj_add_style(s_cursor, &ui_style_trackpad_cursor, 0);
     lv_obj_add_flag(s_cursor, LV_OBJ_FLAG_HIDDEN);
     lv_obj_clear_flag(s_cursor, LV_OBJ_FLAG_SCROLLABLE);
 
@@ -249,8 +284,8 @@ void ui_trackpad_init(const trackpad_cfg_t *cfg)
         lv_obj_move_foreground(s_mode_btn);
     }
 
-    // Start UI update timer (30fps is enough for visual feedback)
-    lv_timer_create(ui_update_timer_cb, 33, NULL);
+    // Cursor and highlights follow the poll task's change notifications
+    app_trackpad_set_status_cb(ui_status_changed_cb, NULL);
 
     ESP_LOGI(TAG, "Trackpad UI initialized (%%s)", CONFIG_APP_VERSION);
 }
@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""
+Compare "bench backend" or LVGL benchmark runs from several builds side by side.
+
+Usage:
+    # Console logs captured from each build (same board, different backend)
+    python tools/bench_report.py ili9341.log lgfx_spi.log
+    python tools/bench_report.py rgb.log lgfx_rgb.log --metric MBps
+
+    # lv_demo_benchmark() runs (APP_LVBENCH_CAPTURE), e.g. one per
+    # sdkconfig.defaults.esp32s3_* profile or buffer setting
+    python tools/bench_report.py --lvbench rgb_60.log rgb_120.log --metric fps
+
+Each log must contain the "bench profile ..." line printed before the
+results and the "bench name=backend_<workload> backend=<name> ..." lines.
+The output is a Markdown table: one row per workload, one column per
+profile/backend, rate (frames or rectangles per second) by default.
+
+With --lvbench the logs need the "lvbench profile ..." and "lvbench scene
+..." lines instead. Then there is one row per benchmark scene, and the
+metric is one of fps, cpu, time_ms, render_ms or flush_ms (default fps).
+Anything else in the logs is ignored.
+"""
+
+import argparse
+import sys
+
+WORKLOADS = ["fill", "partial", "scroll", "image", "lvgl"]
+BACKEND_METRICS = ["rate", "MBps", "us_avg", "us_max"]
+LVBENCH_METRICS = ["fps", "cpu", "time_ms", "render_ms", "flush_ms"]
+
+
+def parse_kv(line):
+    out = {}
+    for tok in line.split():
+        if "=" in tok:
+            k, v = tok.split("=", 1)
+            out[k] = v
+    return out
+
+
+def read_log(path):
+    """Return (column label, {workload: {key: value}}) for one log."""
+    profile = None
+    backend = None
+    results = {}
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for raw in f:
+            line = raw.strip()
+            idx = line.find("bench ")
+            if idx < 0:
+                continue
+            line = line[idx:]
+            kv = parse_kv(line)
+            if line.startswith("bench profile"):
+                profile = kv.get("profile")
+            name = kv.get("name", "")
+            if name.startswith("backend_") and "n" in kv:
+                backend = kv.get("backend", backend)
+                results[name[len("backend_"):]] = kv
+    label = f"{profile or path}/{backend or '?'}"
+    return label, results
+
+
+def read_lvbench(path):
+    """Return (column label, {scene: {key: value}}, [scene order]) for one log."""
+    profile = None
+    scenes = {}
+    order = []
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for raw in f:
+            line = raw.strip()
+            idx = line.find("lvbench ")
+            if idx < 0:
+                continue
+            line = line[idx:]
+            kv = parse_kv(line)
+            if line.startswith("lvbench profile"):
+                profile = kv.get("profile")
+            elif line.startswith("lvbench scene") and "name" in kv:
+                if kv["name"] not in scenes:
+                    order.append(kv["name"])
+                scenes[kv["name"]] = kv
+    return profile or path, scenes, order
+
+
+def print_table(first, labels, rows, cells):
+    print(f"| {first} | " + " | ".join(labels) + " |")
+    print("|---" * (len(labels) + 1) + "|")
+    for row in rows:
+        print(f"| {row} | " + " | ".join(cells(row)) + " |")
+
+
+def main_lvbench(args):
+    metric = args.metric or "fps"
+    if metric not in LVBENCH_METRICS:
+        sys.exit(f"--lvbench metrics: {', '.join(LVBENCH_METRICS)}")
+    columns = [read_lvbench(p) for p in args.logs]
+    rows = []
+    for _, _, order in columns:
+        rows += [name for name in order if name not in rows]
+    if not rows:
+        sys.exit("no 'lvbench scene ...' lines found")
+    # Same profile with different buffer settings: tell the columns apart by file
+    labels = [label for label, _, _ in columns]
+    labels = [f"{lb} ({p})" if labels.count(lb) > 1 else lb for lb, p in zip(labels, args.logs)]
+    print_table("scene", labels, rows,
+                lambda row: [scenes.get(row, {}).get(metric, "-") for _, scenes, _ in columns])
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("logs", nargs="+", help="console logs with bench backend or lvbench output")
+    ap.add_argument("--metric", choices=BACKEND_METRICS + LVBENCH_METRICS,
+                    help="value shown in each cell (default: rate, or fps with --lvbench)")
+    ap.add_argument("--lvbench", action="store_true", help="compare lv_demo_benchmark() scene results")
+    args = ap.parse_args()
+
+    if args.lvbench:
+        main_lvbench(args)
+        return
+
+    metric = args.metric or "rate"
+    if metric not in BACKEND_METRICS:
+        sys.exit(f"backend metrics: {', '.join(BACKEND_METRICS)}")
+    columns = [read_log(p) for p in args.logs]
+    if not any(res for _, res in columns):
+        sys.exit("no 'bench name=backend_...' lines found")
+
+    print_table("workload", [label for label, _ in columns], WORKLOADS,
+                lambda w: [res.get(w, {}).get(metric, "-") for _, res in columns])
+
+
+if __name__ == "__main__":
+    main()
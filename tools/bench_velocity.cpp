@@ -0,0 +1,233 @@
+/**
+ * @file bench_velocity.cpp
+ * @brief Host benchmark: trackpad velocity estimators, cost and response
+ *
+ * Build and run (no ESP-IDF needed):
+ *     g++ -O2 -std=c++17 -Imain tools/bench_velocity.cpp -o bench_velocity
+ *     ./bench_velocity
+ *
+ * Feeds synthetic 100 Hz strokes, quantised to whole pixels like the touch
+ * controllers report them, to the previous EWMA estimator (0.3/0.7 with 0.5
+ * braking on reversal) and to VelocityEstimator (trackpad_velocity.hpp) at
+ * several window sizes, raw (lsqN) and with output smoothing (lsqN_sP, P =
+ * smooth_pct). lsq4_s60 is the gesture engine's default. One line per
+ * estimator:
+ *
+ *   ns       host time per sample (push + speed)
+ *   lag_ms   rest -> 1000 px/s step: time until the estimate reaches 90 %
+ *   rms_pps  back-and-forth stroke (60 px, 2.5 Hz): RMS speed error
+ *   noise_pps 300 px/s with +-1 px jitter: standard deviation of the speed
+ *
+ * Estimators are compared on the speed |vx| + |vy|, which is what drives
+ * the acceleration curve.
+ * On the device, "bench gesture" measures the whole engine per sample.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "trackpad_velocity.hpp"
+
+namespace {
+
+constexpr uint32_t PERIOD_MS = 10;      // 100 Hz touch polling
+constexpr int COST_SAMPLES = 1000000;
+
+struct Sample {
+    int32_t x;
+    int32_t y;
+    uint32_t t_ms;
+    float speed;                        // True speed, px/s
+};
+
+// The estimator the gesture engine used before trackpad_velocity.hpp
+class Ewma {
+public:
+    void reset() { m_first = true; m_vx = m_vy = 0.0f; m_ldx = m_ldy = 0; }
+
+    void push(int32_t x, int32_t y, uint32_t t_ms)
+    {
+        if (m_first) {
+            m_first = false;
+        } else {
+            int32_t dx = x - m_x, dy = y - m_y;
+            uint32_t dt_ms = t_ms - m_t;
+            if (dt_ms == 0) dt_ms = 1;
+            float dt = dt_ms / 1000.0f;
+            if ((dx > 0 && m_ldx < 0) || (dx < 0 && m_ldx > 0)) m_vx *= 0.5f;
+            if ((dy > 0 && m_ldy < 0) || (dy < 0 && m_ldy > 0)) m_vy *= 0.5f;
+            m_ldx = dx;
+            m_ldy = dy;
+            m_vx = std::abs(dx) / dt * 0.3f + m_vx * 0.7f;
+            m_vy = std::abs(dy) / dt * 0.3f + m_vy * 0.7f;
+        }
+        m_x = x;
+        m_y = y;
+        m_t = t_ms;
+    }
+
+    int32_t speed() const { return static_cast<int32_t>(m_vx + m_vy); }
+
+private:
+    bool m_first = true;
+    int32_t m_x = 0, m_y = 0, m_ldx = 0, m_ldy = 0;
+    uint32_t m_t = 0;
+    float m_vx = 0.0f, m_vy = 0.0f;
+};
+
+class Lsq {
+public:
+    explicit Lsq(uint8_t samples, uint8_t smooth_pct = 100)
+    {
+        m_est.configure(samples, samples * PERIOD_MS, smooth_pct);
+    }
+    void reset() { m_est.reset(); }
+    void push(int32_t x, int32_t y, uint32_t t_ms) { m_est.push(x, y, t_ms); }
+    int32_t speed() const { return std::abs(m_est.vx()) + std::abs(m_est.vy()); }
+
+private:
+    VelocityEstimator<> m_est;
+};
+
+// Deterministic +-amp jitter, same sequence for every estimator
+int32_t jitter(uint32_t &state, int32_t amp)
+{
+    state = state * 1664525u + 1013904223u;
+    return static_cast<int32_t>((state >> 16) % (2 * amp + 1)) - amp;
+}
+
+std::vector<Sample> stroke_step()
+{
+    std::vector<Sample> s;
+    for (uint32_t i = 0; i <= 30; i++) {
+        uint32_t t = i * PERIOD_MS;
+        float moving_ms = t > 100 ? static_cast<float>(t - 100) : 0.0f;
+        s.push_back({100 + static_cast<int32_t>(std::lround(moving_ms)), 100, 1000 + t,
+                     t > 100 ? 1000.0f : 0.0f});
+    }
+    return s;
+}
+
+std::vector<Sample> stroke_reverse()
+{
+    const float amp = 60.0f, w = 2.0f * static_cast<float>(M_PI) * 2.5f;
+    std::vector<Sample> s;
+    for (uint32_t i = 0; i <= 160; i++) {
+        float ts = i * PERIOD_MS / 1000.0f;
+        s.push_back({120 + static_cast<int32_t>(std::lround(amp * std::sin(w * ts))), 160, 1000 + i * PERIOD_MS,
+                     std::fabs(amp * w * std::cos(w * ts))});
+    }
+    return s;
+}
+
+std::vector<Sample> stroke_noise()
+{
+    uint32_t rng = 12345;
+    std::vector<Sample> s;
+    for (uint32_t i = 0; i <= 100; i++) {
+        float x = 20.0f + 0.3f * i * PERIOD_MS;
+        s.push_back({static_cast<int32_t>(std::lround(x)) + jitter(rng, 1), 100 + jitter(rng, 1),
+                     1000 + i * PERIOD_MS, 300.0f});
+    }
+    return s;
+}
+
+template <typename E>
+uint32_t measure_lag(E &est, const std::vector<Sample> &s)
+{
+    est.reset();
+    for (const Sample &p : s) {
+        est.push(p.x, p.y, p.t_ms);
+        if (p.speed > 0.0f && est.speed() >= 0.9f * p.speed) {
+            return p.t_ms - 1000 - 100;
+        }
+    }
+    return UINT32_MAX;
+}
+
+// skip: samples left out while the estimate warms up
+template <typename E>
+double measure_rms(E &est, const std::vector<Sample> &s, size_t skip)
+{
+    est.reset();
+    double sum = 0.0;
+    size_t n = 0;
+    for (size_t i = 0; i < s.size(); i++) {
+        est.push(s[i].x, s[i].y, s[i].t_ms);
+        if (i >= skip) {
+            double e = est.speed() - s[i].speed;
+            sum += e * e;
+            n++;
+        }
+    }
+    return n ? std::sqrt(sum / n) : 0.0;
+}
+
+template <typename E>
+double measure_stddev(E &est, const std::vector<Sample> &s, size_t skip)
+{
+    est.reset();
+    std::vector<double> v;
+    for (size_t i = 0; i < s.size(); i++) {
+        est.push(s[i].x, s[i].y, s[i].t_ms);
+        if (i >= skip) v.push_back(est.speed());
+    }
+    double mean = 0.0, var = 0.0;
+    for (double x : v) mean += x;
+    mean /= v.size();
+    for (double x : v) var += (x - mean) * (x - mean);
+    return std::sqrt(var / v.size());
+}
+
+template <typename E>
+double measure_cost(E &est, const std::vector<Sample> &s)
+{
+    volatile int32_t sink = 0;
+    est.reset();
+    auto start = std::chrono::steady_clock::now();
+    uint32_t t_off = 0;
+    for (int i = 0; i < COST_SAMPLES; i++) {
+        const Sample &p = s[i % s.size()];
+        if (i % s.size() == 0) t_off = static_cast<uint32_t>(i / s.size()) * 10000;
+        est.push(p.x, p.y, p.t_ms + t_off);
+        sink = sink + est.speed();
+    }
+    auto end = std::chrono::steady_clock::now();
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(end - start).count() / COST_SAMPLES;
+}
+
+template <typename E>
+void run(const char *name, E est)
+{
+    const std::vector<Sample> step = stroke_step(), rev = stroke_reverse(), noise = stroke_noise();
+    uint32_t lag = measure_lag(est, step);
+    double rms = measure_rms(est, rev, 10);
+    double sd = measure_stddev(est, noise, 10);
+    double ns = measure_cost(est, rev);
+    if (lag == UINT32_MAX) {
+        std::printf("velocity name=%s ns=%.1f lag_ms=never rms_pps=%.0f noise_pps=%.0f\n", name, ns, rms, sd);
+    } else {
+        std::printf("velocity name=%s ns=%.1f lag_ms=%u rms_pps=%.0f noise_pps=%.0f\n", name, ns, (unsigned)lag, rms,
+                    sd);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    run("ewma", Ewma());
+    run("lsq2", Lsq(2));
+    run("lsq3", Lsq(3));
+    run("lsq4", Lsq(4));
+    run("lsq4_s60", Lsq(4, 60));
+    run("lsq5", Lsq(5));
+    run("lsq6", Lsq(6));
+    run("lsq8", Lsq(8));
+    return 0;
+}
@@ -0,0 +1,432 @@
+/**
+ * @file check_ota_stream.cpp
+ * @brief Host check: LZ4 block decoder and OTA stream framing
+ *
+ * Build and run (no ESP-IDF needed):
+ *     g++ -O2 -std=c++17 -Imain tools/check_ota_stream.cpp main/ota_stream.c main/lz4_block.c \
+ *         -o check_ota_stream
+ *     ./check_ota_stream
+ *
+ * Builds streams the way tools/ota_push.py does (greedy LZ4 compressor,
+ * 4 KB frames, END frame) and feeds them to lz4_block.c / ota_stream.c. A
+ * copy of the device's receive loop (app_ota.c: receive_image() plus the
+ * SHA-256 compare) runs over the stream, with a read past the end standing
+ * in for the frame timeout. One line per case:
+ *
+ *   result  what the decoder or receiver reported
+ *   expect  what it must report
+ *
+ * Exits non-zero if any case is off.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "lz4_block.h"
+#include "ota_stream.h"
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+// ========================== SHA-256 (FIPS 180-4) ==========================
+
+class Sha256 {
+public:
+    Sha256() { reset(); }
+
+    void reset()
+    {
+        static const uint32_t init[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                         0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+        std::memcpy(m_h, init, sizeof(m_h));
+        m_len = 0;
+        m_fill = 0;
+    }
+
+    void update(const uint8_t *p, size_t n)
+    {
+        m_len += n;
+        while (n--) {
+            m_buf[m_fill++] = *p++;
+            if (m_fill == 64) {
+                block(m_buf);
+                m_fill = 0;
+            }
+        }
+    }
+
+    void finish(uint8_t out[32])
+    {
+        uint64_t bits = m_len * 8;
+        uint8_t pad = 0x80;
+        update(&pad, 1);
+        pad = 0;
+        while (m_fill != 56) update(&pad, 1);
+        uint8_t len_be[8];
+        for (int i = 0; i < 8; i++) len_be[i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+        update(len_be, 8);
+        for (int i = 0; i < 32; i++) out[i] = static_cast<uint8_t>(m_h[i / 4] >> (24 - 8 * (i % 4)));
+    }
+
+private:
+    uint32_t m_h[8];
+    uint8_t m_buf[64];
+    uint64_t m_len;
+    size_t m_fill;
+
+    static uint32_t ror(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+    void block(const uint8_t *p)
+    {
+        static const uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+        uint32_t w[64];
+        for (int i = 0; i < 16; i++) {
+            w[i] = (uint32_t)p[4 * i] << 24 | (uint32_t)p[4 * i + 1] << 16 | (uint32_t)p[4 * i + 2] << 8 | p[4 * i + 3];
+        }
+        for (int i = 16; i < 64; i++) {
+            uint32_t s0 = ror(w[i - 15], 7) ^ ror(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = ror(w[i - 2], 17) ^ ror(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = m_h[0], b = m_h[1], c = m_h[2], d = m_h[3], e = m_h[4], f = m_h[5], g = m_h[6], h = m_h[7];
+        for (int i = 0; i < 64; i++) {
+            uint32_t t1 = h + (ror(e, 6) ^ ror(e, 11) ^ ror(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+            uint32_t t2 = (ror(a, 2) ^ ror(a, 13) ^ ror(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        m_h[0] += a; m_h[1] += b; m_h[2] += c; m_h[3] += d;
+        m_h[4] += e; m_h[5] += f; m_h[6] += g; m_h[7] += h;
+    }
+};
+
+Bytes sha256(const Bytes &data)
+{
+    Sha256 s;
+    s.update(data.data(), data.size());
+    Bytes out(32);
+    s.finish(out.data());
+    return out;
+}
+
+// ========================== Sender (as tools/ota_push.py) ==========================
+
+// Greedy LZ4 block compressor, the scheme of ota_push.py's fallback (with a
+// hashed match table instead of a dict)
+Bytes lz4_compress(const Bytes &src)
+{
+    const size_t n = src.size();
+    Bytes out;
+    std::vector<int64_t> table(1 << 16, -1);
+    size_t anchor = 0, i = 0;
+    const size_t mflimit = n > 12 ? n - 12 : 0;
+    const size_t last_literals = n > 5 ? n - 5 : 0;
+
+    auto put_len = [&](size_t v) {
+        for (; v >= 255; v -= 255) out.push_back(255);
+        out.push_back(static_cast<uint8_t>(v));
+    };
+    auto emit = [&](size_t lit_end, size_t offset, size_t mlen) {
+        size_t lit = lit_end - anchor;
+        size_t ml = offset ? mlen - 4 : 0;
+        out.push_back(static_cast<uint8_t>((lit < 15 ? lit : 15) << 4 | (ml < 15 ? ml : 15)));
+        if (lit >= 15) put_len(lit - 15);
+        out.insert(out.end(), src.begin() + anchor, src.begin() + lit_end);
+        if (offset) {
+            out.push_back(static_cast<uint8_t>(offset));
+            out.push_back(static_cast<uint8_t>(offset >> 8));
+            if (ml >= 15) put_len(ml - 15);
+        }
+    };
+
+    while (i < mflimit) {
+        uint32_t key;
+        std::memcpy(&key, &src[i], 4);
+        uint32_t slot = (key * 2654435761u) >> 16;
+        int64_t cand = table[slot];
+        table[slot] = static_cast<int64_t>(i);
+        if (cand < 0 || i - cand > 0xFFFF || std::memcmp(&src[cand], &src[i], 4) != 0) {
+            i++;
+            continue;
+        }
+        size_t m = 4;
+        while (i + m < last_literals && src[cand + m] == src[i + m]) m++;
+        emit(i, i - cand, m);
+        i += m;
+        anchor = i;
+    }
+    emit(n, 0, 0);
+    return out;
+}
+
+void put_frame(Bytes &out, uint8_t flags, const Bytes &payload, uint16_t raw_len, uint32_t crc)
+{
+    const uint16_t plen = static_cast<uint16_t>(payload.size());
+    const uint8_t hdr[OTA_FRAME_HDR_LEN] = {
+        'O', 'F', flags, 0,
+        static_cast<uint8_t>(plen), static_cast<uint8_t>(plen >> 8),
+        static_cast<uint8_t>(raw_len), static_cast<uint8_t>(raw_len >> 8),
+        static_cast<uint8_t>(crc), static_cast<uint8_t>(crc >> 8),
+        static_cast<uint8_t>(crc >> 16), static_cast<uint8_t>(crc >> 24)};
+    out.insert(out.end(), hdr, hdr + OTA_FRAME_HDR_LEN);
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+Bytes build_stream(const Bytes &image)
+{
+    Bytes out;
+    for (size_t off = 0; off < image.size(); off += OTA_BLOCK_MAX) {
+        size_t len = image.size() - off < OTA_BLOCK_MAX ? image.size() - off : OTA_BLOCK_MAX;
+        Bytes raw(image.begin() + off, image.begin() + off + len);
+        uint32_t crc = ota_crc32(0, raw.data(), raw.size());
+        Bytes comp = lz4_compress(raw);
+        if (comp.size() < raw.size()) {
+            put_frame(out, OTA_FLAG_LZ4, comp, static_cast<uint16_t>(len), crc);
+        } else {
+            put_frame(out, 0, raw, static_cast<uint16_t>(len), crc);
+        }
+    }
+    put_frame(out, OTA_FLAG_END, {}, 0, 0);
+    return out;
+}
+
+// ========================== Receiver (as app_ota.c) ==========================
+
+std::string receive(const Bytes &stream, uint32_t image_size, const Bytes &expected_sha)
+{
+    uint8_t payload[LZ4_BLOCK_BOUND(OTA_BLOCK_MAX)];
+    uint8_t raw[OTA_BLOCK_MAX];
+    size_t pos = 0;
+    uint32_t written = 0;
+    Sha256 sha;
+
+    while (true) {
+        if (stream.size() - pos < OTA_FRAME_HDR_LEN) return "timeout";
+        ota_frame_hdr_t hdr;
+        ota_stream_err_t err = ota_frame_parse_hdr(&stream[pos], &hdr);
+        pos += OTA_FRAME_HDR_LEN;
+        if (err != OTA_STREAM_OK) return ota_stream_err_str(err);
+        if (hdr.flags & OTA_FLAG_END) {
+            if (written != image_size) return "short_image";
+            break;
+        }
+
+        if (stream.size() - pos < hdr.payload_len) return "timeout";
+        std::memcpy(payload, &stream[pos], hdr.payload_len);
+        pos += hdr.payload_len;
+        err = ota_frame_decode(&hdr, payload, raw);
+        if (err != OTA_STREAM_OK) return ota_stream_err_str(err);
+        if (written + hdr.raw_len > image_size) return "image_too_long";
+        sha.update(raw, hdr.raw_len);
+        written += hdr.raw_len;
+    }
+
+    uint8_t digest[32];
+    sha.finish(digest);
+    return std::memcmp(digest, expected_sha.data(), 32) == 0 ? "ok" : "sha256";
+}
+
+// ========================== Cases ==========================
+
+uint32_t s_rng = 12345;
+
+uint8_t rnd()
+{
+    s_rng = s_rng * 1664525u + 1013904223u;
+    return static_cast<uint8_t>(s_rng >> 24);
+}
+
+// Firmware-like mix: runs, repeated snippets and random stretches
+Bytes test_image(size_t n)
+{
+    Bytes img;
+    static const char snippet[] = "esp32_do_it trackpad lvgl esp_lcd_touch ";
+    while (img.size() < n) {
+        switch (rnd() % 3) {
+            case 0: img.insert(img.end(), rnd() % 64 + 1, rnd()); break;
+            case 1: img.insert(img.end(), snippet, snippet + sizeof(snippet) - 1); break;
+            default: for (int i = rnd() % 48; i >= 0; i--) img.push_back(rnd()); break;
+        }
+    }
+    img.resize(n);
+    return img;
+}
+
+bool s_ok = true;
+
+void report(const char *name, const std::string &result, const std::string &expect)
+{
+    bool ok = result == expect;
+    std::printf("ota case=%s result=%s expect=%s %s\n", name, result.c_str(), expect.c_str(), ok ? "ok" : "FAIL");
+    s_ok = s_ok && ok;
+}
+
+std::string lz4_result(const Bytes &block, size_t dst_cap, const Bytes *expect_out)
+{
+    Bytes out(dst_cap ? dst_cap : 1);
+    int n = lz4_block_decompress(block.data(), block.size(), out.data(), dst_cap);
+    if (n < 0) return "malformed";
+    if (expect_out && (static_cast<size_t>(n) != expect_out->size() ||
+                       std::memcmp(out.data(), expect_out->data(), n) != 0)) {
+        return "mismatch";
+    }
+    return "ok";
+}
+
+void check_sha256()
+{
+    // FIPS 180-2 example: SHA-256("abc")
+    static const uint8_t abc[32] = {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40,
+                                    0xde, 0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17,
+                                    0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+    Bytes d = sha256(Bytes{'a', 'b', 'c'});
+    report("sha256_vector", std::memcmp(d.data(), abc, 32) == 0 ? "ok" : "mismatch", "ok");
+}
+
+void check_roundtrip()
+{
+    // Sizes around the format's edge cases (no match possible below 13 bytes)
+    const size_t sizes[] = {0, 1, 5, 12, 13, 14, 100, 255, 270, 1000, OTA_BLOCK_MAX};
+    std::string result = "ok";
+    for (size_t n : sizes) {
+        Bytes raw = test_image(n);
+        Bytes zeros(n, 0);
+        for (const Bytes *src : {&raw, &zeros}) {
+            std::string r = lz4_result(lz4_compress(*src), OTA_BLOCK_MAX, src);
+            if (r != "ok") result = r;
+        }
+    }
+    report("lz4_roundtrip", result, "ok");
+}
+
+void check_malformed()
+{
+    const Bytes good = lz4_compress(Bytes(64, 'A'));
+    report("lz4_reference", lz4_result(good, 64, nullptr), "ok");
+    // Token says 1 literal, none follows
+    report("lz4_literal_past_end", lz4_result(Bytes{0x10}, 64, nullptr), "malformed");
+    // Literal length continuation missing
+    report("lz4_length_past_end", lz4_result(Bytes{0xF0}, 64, nullptr), "malformed");
+    // One literal, then only one byte of match offset
+    report("lz4_offset_past_end", lz4_result(Bytes{0x10, 'x', 0x01}, 64, nullptr), "malformed");
+    // Match offset 0
+    report("lz4_offset_zero", lz4_result(Bytes{0x10, 'x', 0x00, 0x00, 0x00}, 64, nullptr), "malformed");
+    // Match reaching back before the start of the output
+    report("lz4_offset_before_start", lz4_result(Bytes{0x10, 'x', 0x02, 0x00, 0x00}, 64, nullptr), "malformed");
+    // Valid block, output buffer one byte short
+    report("lz4_output_overflow", lz4_result(good, 63, nullptr), "malformed");
+
+    // Every truncation of a real block must fail the frame, not pass a short block
+    Bytes raw = test_image(OTA_BLOCK_MAX);
+    Bytes comp = lz4_compress(raw);
+    ota_frame_hdr_t hdr = {OTA_FLAG_LZ4, 0, static_cast<uint16_t>(raw.size()), ota_crc32(0, raw.data(), raw.size())};
+    static uint8_t out[OTA_BLOCK_MAX];
+    std::string result = "rejected";
+    for (size_t cut = 1; cut < comp.size(); cut++) {
+        hdr.payload_len = static_cast<uint16_t>(cut);
+        if (ota_frame_decode(&hdr, comp.data(), out) == OTA_STREAM_OK) result = "accepted";
+    }
+    report("lz4_truncated_block", result, "rejected");
+}
+
+void check_frames()
+{
+    Bytes raw = test_image(1000);
+    uint32_t crc = ota_crc32(0, raw.data(), raw.size());
+    static uint8_t out[OTA_BLOCK_MAX];
+
+    Bytes f;
+    put_frame(f, 0, raw, static_cast<uint16_t>(raw.size()), crc);
+    ota_frame_hdr_t hdr;
+    ota_frame_parse_hdr(f.data(), &hdr);
+    report("frame_stored", ota_stream_err_str(ota_frame_decode(&hdr, f.data() + OTA_FRAME_HDR_LEN, out)), "ok");
+
+    Bytes bad = f;
+    bad[0] = 'X';
+    report("frame_bad_magic", ota_stream_err_str(ota_frame_parse_hdr(bad.data(), &hdr)), "bad_magic");
+    bad = f;
+    bad[4]++;                                   // Stored payload_len must equal raw_len
+    report("frame_bad_length", ota_stream_err_str(ota_frame_parse_hdr(bad.data(), &hdr)), "bad_length");
+
+    // One flipped payload bit, stored and compressed
+    bad = f;
+    bad[OTA_FRAME_HDR_LEN + 500] ^= 0x04;
+    ota_frame_parse_hdr(bad.data(), &hdr);
+    report("frame_crc_stored", ota_stream_err_str(ota_frame_decode(&hdr, bad.data() + OTA_FRAME_HDR_LEN, out)), "crc");
+
+    Bytes zeros(1000, 0);
+    Bytes lz;
+    put_frame(lz, OTA_FLAG_LZ4, lz4_compress(zeros), 1000, ota_crc32(0, zeros.data(), zeros.size()));
+    lz[OTA_FRAME_HDR_LEN + 1] ^= 0x01;         // The literal the run repeats
+    ota_frame_parse_hdr(lz.data(), &hdr);
+    report("frame_crc_lz4", ota_stream_err_str(ota_frame_decode(&hdr, lz.data() + OTA_FRAME_HDR_LEN, out)), "crc");
+
+    // Header CRC field damaged, payload intact
+    bad = f;
+    bad[8] ^= 0x80;
+    ota_frame_parse_hdr(bad.data(), &hdr);
+    report("frame_crc_field", ota_stream_err_str(ota_frame_decode(&hdr, bad.data() + OTA_FRAME_HDR_LEN, out)), "crc");
+}
+
+void check_stream()
+{
+    // Not a multiple of the block size, so the last frame is short
+    Bytes image = test_image(5 * OTA_BLOCK_MAX + 123);
+    Bytes sha = sha256(image);
+    Bytes stream = build_stream(image);
+    const uint32_t size = static_cast<uint32_t>(image.size());
+
+    report("stream_ok", receive(stream, size, sha), "ok");
+
+    // Cut inside a header, inside a payload, and just before END
+    std::string result = "timeout";
+    for (size_t cut : {size_t(5), size_t(OTA_FRAME_HDR_LEN + 7), stream.size() / 2,
+                       stream.size() - OTA_FRAME_HDR_LEN}) {
+        std::string r = receive(Bytes(stream.begin(), stream.begin() + cut), size, sha);
+        if (r != "timeout") result = r;
+    }
+    report("stream_truncated", result, "timeout");
+
+    // END after the first frame only
+    ota_frame_hdr_t hdr;
+    ota_frame_parse_hdr(stream.data(), &hdr);
+    Bytes first(stream.begin(), stream.begin() + OTA_FRAME_HDR_LEN + hdr.payload_len);
+    put_frame(first, OTA_FLAG_END, {}, 0, 0);
+    report("stream_short_image", receive(first, size, sha), "short_image");
+
+    report("stream_too_long", receive(stream, size - 1, sha), "image_too_long");
+
+    Bytes wrong = sha;
+    wrong[31] ^= 0x01;
+    report("stream_sha256", receive(stream, size, wrong), "sha256");
+}
+
+} // namespace
+
+int main()
+{
+    check_sha256();
+    check_roundtrip();
+    check_malformed();
+    check_frames();
+    check_stream();
+    return s_ok ? 0 : 1;
+}
@@ -0,0 +1,333 @@
+/**
+ * @file check_rect_stream.cpp
+ * @brief Host check: RLE565 / DELTA565 rectangle codecs round-trip
+ *
+ * Build and run (no ESP-IDF needed):
+ *     g++ -O2 -std=c++17 -Imain tools/check_rect_stream.cpp main/rect_stream.c -o check_rect_stream
+ *     ./check_rect_stream
+ *
+ * RLE565 (host to device): rectangles are encoded the way
+ * tools/display_push.py does (rle565(), RAW565 when RLE does not pay) and
+ * decoded by rect_stream.c, with the payload fed in chunks of 1, 3, 7 bytes
+ * and whole, so packets and pixels straddle chunk boundaries.
+ *
+ * DELTA565 (device to host): rows are encoded by rect_encode_delta_row()
+ * against the previous frame and decoded the way tools/mirror_view.py does
+ * (Frame.apply()).
+ *
+ * One line per case:
+ *
+ *   bytes   payload size
+ *   result  what the decoder reported (or "match"/"mismatch" for pixels)
+ *   expect  what it must report
+ *
+ * Exits non-zero if any case is off.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "rect_stream.h"
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+using Pixels = std::vector<uint16_t>;
+
+// ========================== Host-side codecs ==========================
+
+void put16(Bytes &out, uint16_t v)
+{
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+// display_push.py rle565(): runs of 3 or more, literals in packets of 128
+Bytes rle565(const Pixels &px)
+{
+    Bytes out;
+    size_t n = px.size();
+    size_t lit = 0;
+    size_t i = 0;
+
+    auto flush_literals = [&](size_t end) {
+        for (size_t s = lit; s < end;) {
+            size_t k = end - s < 128 ? end - s : 128;
+            out.push_back(static_cast<uint8_t>(k - 1));
+            for (size_t m = 0; m < k; m++) put16(out, px[s + m]);
+            s += k;
+        }
+    };
+
+    while (i < n) {
+        size_t j = i + 1;
+        while (j < n && j - i < 128 && px[j] == px[i]) j++;
+        if (j - i >= 3) {
+            flush_literals(i);
+            out.push_back(static_cast<uint8_t>(0x80 | (j - i - 1)));
+            put16(out, px[i]);
+            lit = j;
+        }
+        i = j;
+    }
+    flush_literals(n);
+    return out;
+}
+
+// display_push.py encode_band(): RLE unless it is no smaller than raw
+Bytes rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const Pixels &px, uint8_t codec)
+{
+    Bytes payload;
+    if (codec == RECT_CODEC_RLE565) {
+        payload = rle565(px);
+        if (payload.size() >= px.size() * 2) codec = RECT_CODEC_RAW565;
+    }
+    if (codec == RECT_CODEC_RAW565) {
+        payload.clear();
+        for (uint16_t v : px) put16(payload, v);
+    }
+
+    rect_hdr_t hdr = {codec, RECT_FLAG_PRESENT, x, y, w, h, static_cast<uint32_t>(payload.size())};
+    Bytes out(RECT_HDR_LEN);
+    rect_write_hdr(&hdr, out.data());
+    out.insert(out.end(), payload.begin(), payload.end());
+    return out;
+}
+
+// mirror_view.py Frame.apply(): DELTA565 into a w-wide frame
+void delta_apply(Pixels &frame, uint16_t frame_w, uint16_t x, uint16_t y, uint16_t w, const Bytes &payload)
+{
+    size_t pos = 0;
+    size_t i = 0;
+    auto put = [&](size_t k, const uint8_t *data, bool run) {
+        for (size_t m = 0; m < k; m++, pos++) {
+            const uint8_t *p = run ? data : data + 2 * m;
+            frame[(y + pos / w) * frame_w + x + pos % w] = static_cast<uint16_t>(p[0] | (p[1] << 8));
+        }
+    };
+    while (i < payload.size()) {
+        uint8_t c = payload[i++];
+        if (c < 0x80) {
+            size_t k = c + 1u;
+            put(k, &payload[i], false);
+            i += 2 * k;
+        } else if (c < 0xC0) {
+            put((c & 0x3Fu) + 1, &payload[i], true);
+            i += 2;
+        } else {
+            pos += (c & 0x3Fu) + 1;
+        }
+    }
+}
+
+// ========================== Device-side decode ==========================
+
+struct Target {
+    Pixels px;
+    uint16_t w;
+};
+
+uint16_t *row_of(void *ctx, uint16_t row)
+{
+    Target *t = static_cast<Target *>(ctx);
+    return &t->px[static_cast<size_t>(row) * t->w];
+}
+
+// Parse and decode one encoded rectangle, feeding the payload in chunks
+std::string decode(const Bytes &stream, size_t chunk, Pixels *out)
+{
+    rect_hdr_t hdr;
+    rect_stream_err_t err = rect_parse_hdr(stream.data(), &hdr);
+    if (err != RECT_STREAM_OK) return rect_stream_err_str(err);
+
+    Target t{Pixels(static_cast<size_t>(hdr.w) * hdr.h, 0), hdr.w};
+    rect_decoder_t dec;
+    rect_decoder_init(&dec, &hdr, row_of, &t);
+    const uint8_t *p = stream.data() + RECT_HDR_LEN;
+    size_t left = stream.size() - RECT_HDR_LEN;
+    while (left && err == RECT_STREAM_OK) {
+        size_t n = chunk && chunk < left ? chunk : left;
+        err = rect_decoder_feed(&dec, p, n);
+        p += n;
+        left -= n;
+    }
+    if (err == RECT_STREAM_OK) err = rect_decoder_finish(&dec);
+    if (err != RECT_STREAM_OK) return rect_stream_err_str(err);
+    if (out) *out = t.px;
+    return "ok";
+}
+
+// ========================== Cases ==========================
+
+bool report(const char *codec, const char *name, size_t bytes, const std::string &result, const char *expect)
+{
+    bool ok = result == expect;
+    std::printf("rect codec=%s case=%s bytes=%u result=%s expect=%s %s\n", codec, name, (unsigned)bytes,
+                result.c_str(), expect, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+// Round-trip through every chunk size; all must give back the pixels
+bool rle_case(const char *name, uint16_t w, uint16_t h, const Pixels &px, uint8_t codec = RECT_CODEC_RLE565)
+{
+    Bytes s = rect(0, 0, w, h, px, codec);
+    std::string result = "match";
+    for (size_t chunk : {size_t(1), size_t(3), size_t(7), size_t(0)}) {
+        Pixels got;
+        std::string r = decode(s, chunk, &got);
+        if (r != "ok") {
+            result = r;
+            break;
+        }
+        if (got != px) {
+            result = "mismatch";
+            break;
+        }
+    }
+    const char *label = s[2] == RECT_CODEC_RAW565 ? "raw" : "rle";
+    return report(label, name, s.size() - RECT_HDR_LEN, result, "match");
+}
+
+// Rewrite the header's payload_len after editing the payload
+void fix_len(Bytes &s)
+{
+    rect_hdr_t hdr;
+    rect_parse_hdr(s.data(), &hdr);
+    hdr.payload_len = static_cast<uint32_t>(s.size() - RECT_HDR_LEN);
+    rect_write_hdr(&hdr, s.data());
+}
+
+bool rle_error_case(const char *name, Bytes s, const char *expect)
+{
+    const char *label = s[2] == RECT_CODEC_RAW565 ? "raw" : "rle";
+    return report(label, name, s.size() - RECT_HDR_LEN, decode(s, 3, nullptr), expect);
+}
+
+// Encode cur against prev row by row (as app_mirror.c does) and apply on the host copy
+bool delta_case(const char *name, uint16_t w, uint16_t h, const Pixels &prev, const Pixels &cur, bool first)
+{
+    Pixels host = prev;
+    size_t bytes = 0;
+    bool bounded = true;
+    Bytes row(RECT_DELTA_BOUND(w, 1));
+    for (uint16_t y = 0; y < h; y++) {
+        const uint16_t *p = first ? nullptr : &prev[static_cast<size_t>(y) * w];
+        size_t n = rect_encode_delta_row(&cur[static_cast<size_t>(y) * w], p, w, row.data());
+        bounded = bounded && n <= RECT_DELTA_BOUND(w, 1);
+        delta_apply(host, w, 0, y, w, Bytes(row.begin(), row.begin() + n));
+        bytes += n;
+    }
+    std::string result = !bounded ? "over_bound" : host == cur ? "match" : "mismatch";
+    return report("delta", name, bytes, result, "match");
+}
+
+Pixels gradient(size_t n)
+{
+    Pixels px(n);
+    for (size_t i = 0; i < n; i++) px[i] = static_cast<uint16_t>(i * 37 + 11);
+    return px;
+}
+
+// display_push.py pattern_frames(): flat background and a partial bar
+Pixels dashboard(uint16_t w, uint16_t h, uint16_t bar_y, uint16_t bar_w)
+{
+    Pixels px(static_cast<size_t>(w) * h, 0x10C6);
+    for (uint16_t r = bar_y; r < bar_y + 8 && r < h; r++) {
+        for (uint16_t c = 0; c < bar_w; c++) px[static_cast<size_t>(r) * w + c] = 0xD945;
+    }
+    return px;
+}
+
+} // namespace
+
+int main()
+{
+    bool ok = true;
+
+    // ---- RLE565 round-trips ----
+    ok = rle_case("solid", 320, 16, Pixels(320 * 16, 0xF800)) && ok;
+    ok = rle_case("gradient", 300, 4, gradient(300 * 4)) && ok;        // No runs: falls back to raw
+    ok = rle_case("raw", 17, 3, gradient(17 * 3), RECT_CODEC_RAW565) && ok;
+    ok = rle_case("dashboard", 320, 24, dashboard(320, 24, 10, 130)) && ok;
+    {
+        // Runs of 2 (stay literal), 3, 128, 129 and a lone pixel, across rows
+        Pixels px;
+        for (uint16_t v : {1, 1, 2, 3, 3, 3, 4}) px.push_back(v);
+        px.insert(px.end(), 128, 5);
+        px.insert(px.end(), 129, 6);
+        Pixels tail = gradient(400 - px.size());
+        px.insert(px.end(), tail.begin(), tail.end());
+        ok = rle_case("mixed_runs", 40, 10, px) && ok;
+    }
+    ok = rle_case("one_pixel", 1, 1, Pixels{0x1234}) && ok;
+
+    // ---- RLE565 malformed ----
+    {
+        Bytes s = rect(0, 0, 8, 2, Pixels(16, 7), RECT_CODEC_RLE565);
+        s[RECT_HDR_LEN] = 0x80 | 20;                                    // Run of 21 into 16 pixels
+        ok = rle_error_case("run_overflow", s, "overflow") && ok;
+    }
+    {
+        Bytes s = rect(0, 0, 8, 2, Pixels(16, 7), RECT_CODEC_RLE565);
+        s.push_back(0x00);                                              // Extra literal packet
+        s.push_back(0x34);
+        s.push_back(0x12);
+        fix_len(s);
+        ok = rle_error_case("extra_packet", s, "overflow") && ok;
+    }
+    {
+        Pixels px(64, 3);
+        Bytes s = rect(0, 0, 16, 4, px, RECT_CODEC_RLE565);
+        s[RECT_HDR_LEN] = 0x80 | 40;                                    // Run of 41 of 64
+        ok = rle_error_case("short_run", s, "short_payload") && ok;
+    }
+    {
+        Pixels px(16, 7);
+        Pixels tail = gradient(17 * 3 - px.size());
+        px.insert(px.end(), tail.begin(), tail.end());
+        Bytes s = rect(0, 0, 17, 3, px, RECT_CODEC_RLE565);
+        s.pop_back();                                                   // Half a pixel missing
+        fix_len(s);
+        ok = rle_error_case("split_pixel", s, "short_payload") && ok;
+    }
+    {
+        Bytes s = rect(0, 0, 17, 3, gradient(17 * 3), RECT_CODEC_RAW565);
+        s.resize(s.size() - 2);                                         // RAW must be exactly w*h*2
+        fix_len(s);
+        ok = rle_error_case("raw_length", s, "bad_length") && ok;
+    }
+    {
+        Bytes s = rect(0, 0, 8, 2, Pixels(16, 7), RECT_CODEC_RLE565);
+        s[0] = 'X';
+        ok = rle_error_case("bad_magic", s, "bad_magic") && ok;
+        s[0] = 'D';
+        s[2] = RECT_CODEC_DELTA565;                                     // Device never accepts DELTA
+        ok = rle_error_case("delta_to_device", s, "bad_codec") && ok;
+    }
+
+    // ---- DELTA565 round-trips ----
+    {
+        const uint16_t w = 320, h = 24;
+        Pixels black(static_cast<size_t>(w) * h, 0);
+        Pixels a = dashboard(w, h, 4, 200);
+        Pixels b = dashboard(w, h, 8, 210);
+        ok = delta_case("first_frame", w, h, black, a, true) && ok;
+        ok = delta_case("unchanged", w, h, a, a, false) && ok;
+        ok = delta_case("bar_moved", w, h, a, b, false) && ok;
+
+        Pixels g = gradient(static_cast<size_t>(w) * h);
+        ok = delta_case("all_literal", w, h, black, g, false) && ok;
+        Pixels sparse = g;
+        for (size_t i = 0; i < sparse.size(); i += 2) sparse[i] ^= 0xFFFF;    // Lone unchanged pixels
+        ok = delta_case("alternating", w, h, g, sparse, false) && ok;
+        Pixels runs = g;
+        for (size_t i = 5; i < 300; i++) runs[i] = 0x07E0;                    // Run longer than 64
+        ok = delta_case("long_run", w, h, g, runs, false) && ok;
+    }
+    ok = delta_case("narrow", 1, 5, Pixels{1, 2, 3, 4, 5}, Pixels{1, 9, 3, 9, 9}, false) && ok;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,16 @@
+"""
+Console helpers shared by the serial host tools (ota_push.py, display_push.py,
+mirror_view.py).
+"""
+
+import time
+
+
+def wait_for(ser, prefixes, timeout):
+    """Return the first console line starting with one of prefixes (logs are skipped)."""
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        line = ser.readline().decode("utf-8", errors="replace").strip()
+        if any(line.startswith(p) for p in prefixes):
+            return line
+    raise TimeoutError(f"timed out waiting for {prefixes}")
@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+"""
+Drive the panel from a PC: stream images to the device as a secondary display.
+
+Usage:
+    python tools/display_push.py --port /dev/ttyACM0 status.png
+    python tools/display_push.py --port /dev/ttyACM0 --pattern --frames 300
+    python tools/display_push.py --port /dev/ttyACM0 --hold dashboard.png
+
+The device pauses LVGL ("display host" console command) and decodes each
+rectangle straight into the RGB framebuffer (RGB panels) or through a small
+DMA strip buffer (SPI/LovyanGFX). Only the band of rows that changed since the
+previous frame is sent, RLE-compressed (see main/rect_stream.h), so mostly
+static status screens update at a fraction of the full-frame cost.
+
+Image files need Pillow (pip install pillow); --pattern needs nothing.
+Requires pyserial.
+"""
+
+import argparse
+import array
+import struct
+import sys
+import time
+
+from console_serial import wait_for
+
+CODEC_RAW565 = 0
+CODEC_RLE565 = 1
+FLAG_PRESENT = 0x01
+FLAG_END = 0x02
+
+
+# ========================== Codec ==========================
+
+def rle565(px):
+    """RLE565 encode a sequence of 16-bit pixels (format in main/rect_stream.h)."""
+    out = bytearray()
+    n = len(px)
+    lit = 0          # start of pending literals
+    i = 0
+
+    def flush_literals(end):
+        s = lit
+        while s < end:
+            k = min(128, end - s)
+            out.append(k - 1)
+            out.extend(px[s:s + k].tobytes())
+            s += k
+
+    while i < n:
+        v = px[i]
+        j = i + 1
+        while j < n and j - i < 128 and px[j] == v:
+            j += 1
+        if j - i >= 3:
+            flush_literals(i)
+            out.append(0x80 | (j - i - 1))
+            out.extend(struct.pack("<H", v))
+            lit = j
+        i = j
+    flush_literals(n)
+    return bytes(out)
+
+
+def rect(codec, flags, x, y, w, h, payload=b""):
+    return struct.pack("<2sBBHHHHI", b"DR", codec, flags, x, y, w, h, len(payload)) + payload
+
+
+def encode_band(frame, prev, w, h, codec):
+    """Header+payload for the rows that changed, or None if nothing did."""
+    rows = [r for r in range(h) if prev is None or frame[r * w:(r + 1) * w] != prev[r * w:(r + 1) * w]]
+    if not rows:
+        return None
+    y0, y1 = rows[0], rows[-1] + 1
+    band = frame[y0 * w:y1 * w]
+    if codec == CODEC_RLE565:
+        payload = rle565(band)
+        if len(payload) >= len(band) * 2:
+            codec, payload = CODEC_RAW565, band.tobytes()
+    else:
+        payload = band.tobytes()
+    return rect(codec, FLAG_PRESENT, 0, y0, w, y1 - y0, payload)
+
+
+# ========================== Sources ==========================
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def load_image(path, w, h):
+    from PIL import Image  # pillow
+
+    img = Image.open(path).convert("RGB")
+    img.thumbnail((w, h))
+    canvas = Image.new("RGB", (w, h))
+    canvas.paste(img, ((w - img.width) // 2, (h - img.height) // 2))
+    px = array.array("H", (rgb565(r, g, b) for r, g, b in canvas.getdata()))
+    if sys.byteorder != "little":
+        px.byteswap()
+    return px
+
+
+def pattern_frames(w, h, count):
+    """Static background with a moving bar: mostly-unchanged frames like a dashboard."""
+    bg = array.array("H", [rgb565(16, 24, 48)] * (w * h))
+    bar_h = max(8, h // 12)
+    colors = [rgb565(220, 40, 40), rgb565(40, 200, 60), rgb565(40, 90, 230)]
+    for n in range(count):
+        frame = array.array("H", bg)
+        y = (n * 4) % (h - bar_h)
+        c = colors[(n // 30) % len(colors)]
+        x1 = w * ((n % 60) + 1) // 60
+        for r in range(y, y + bar_h):
+            frame[r * w:r * w + x1] = array.array("H", [c] * x1)
+        yield frame
+
+
+# ========================== Transport ==========================
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("images", nargs="*", help="image files (shown in order)")
+    ap.add_argument("--port", required=True)
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--pattern", action="store_true", help="built-in animation instead of images")
+    ap.add_argument("--frames", type=int, default=120, help="frames for --pattern")
+    ap.add_argument("--fps", type=float, default=0, help="frame rate cap (0 = as fast as possible)")
+    ap.add_argument("--raw", action="store_true", help="send uncompressed pixels (for comparison)")
+    ap.add_argument("--hold", action="store_true", help="keep the last image up until Ctrl-C")
+    args = ap.parse_args()
+    if not args.images and not args.pattern:
+        ap.error("give image files or --pattern")
+
+    import serial  # pyserial
+
+    codec = CODEC_RAW565 if args.raw else CODEC_RLE565
+    with serial.Serial(args.port, args.baud, timeout=0.5) as ser:
+        ser.reset_input_buffer()
+        ser.write(b"display host\n")  # LF only: binary follows
+        line = wait_for(ser, ("display ready", "display err", "err"), 5)
+        if not line.startswith("display ready"):
+            sys.exit(line)
+        w, h = (int(v) for v in line.split()[2:4])
+        print(f"device display {w}x{h}")
+
+        if args.pattern:
+            frames = pattern_frames(w, h, args.frames)
+        else:
+            frames = (load_image(p, w, h) for p in args.images)
+
+        prev = None
+        sent = wire = 0
+        t0 = time.time()
+        try:
+            for frame in frames:
+                t_frame = time.time()
+                data = encode_band(frame, prev, w, h, codec)
+                prev = frame
+                if data is None:
+                    continue
+                ser.write(data)
+                wait_for(ser, ("display ack",), 10)
+                sent += 1
+                wire += len(data)
+                if args.fps > 0:
+                    time.sleep(max(0.0, 1.0 / args.fps - (time.time() - t_frame)))
+            dt = time.time() - t0
+            if sent:
+                print(f"{sent} frames in {dt:.1f}s ({sent / dt:.1f} fps), "
+                      f"{wire / sent / 1024:.1f} KB/frame on the wire, {wire / dt / 1024:.0f} KB/s")
+
+            while args.hold:
+                time.sleep(5)
+                ser.write(rect(CODEC_RAW565, FLAG_PRESENT, 0, 0, 0, 0))  # keepalive
+                wait_for(ser, ("display ack",), 10)
+        except KeyboardInterrupt:
+            pass
+        finally:
+            ser.write(rect(CODEC_RAW565, FLAG_END, 0, 0, 0, 0))
+            print(wait_for(ser, ("display done", "display err"), 5))
+
+
+if __name__ == "__main__":
+    main()
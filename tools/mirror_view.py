@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+"""
+View or record the device screen over the console port (screen mirroring).
+
+Usage:
+    python tools/mirror_view.py --port /dev/ttyACM0 --view
+    python tools/mirror_view.py --port /dev/ttyACM0 --out frames/ --seconds 30
+    python tools/mirror_view.py --port /dev/ttyACM0 --snapshot screen.ppm
+
+The device ("mirror start" console command) streams only the rectangles LVGL
+redraws, delta-encoded against what this tool already has (DELTA565, see
+main/rect_stream.h). This tool keeps the reconstructed frame and shows it
+(--view, tkinter), writes one PPM per frame (--out) or grabs a single
+settled frame (--snapshot) for automated UI tests.
+
+Requires pyserial; --view also needs tkinter.
+"""
+
+import argparse
+import array
+import os
+import struct
+import sys
+import time
+
+from console_serial import wait_for
+
+HDR = struct.Struct("<2sBBHHHHI")
+CODEC_DELTA565 = 2
+FLAG_PRESENT = 0x01
+
+
+# ========================== Frame reconstruction ==========================
+
+class Frame:
+    def __init__(self, w, h):
+        self.w, self.h = w, h
+        self.px = bytearray(w * h * 2)   # RGB565 little-endian; starts black like the device's copy
+
+    def apply(self, x, y, w, h, payload):
+        """Decode one DELTA565 rectangle into the frame."""
+        pos = 0          # pixel index within the rectangle
+        i = 0
+        n = len(payload)
+        while i < n:
+            c = payload[i]
+            i += 1
+            if c < 0x80:
+                k = c + 1
+                self._put(x, y, w, pos, k, payload[i:i + 2 * k])
+                i += 2 * k
+            elif c < 0xC0:
+                k = (c & 0x3F) + 1
+                self._put(x, y, w, pos, k, payload[i:i + 2] * k)
+                i += 2
+            else:
+                k = (c & 0x3F) + 1
+            pos += k
+
+    def _put(self, x, y, w, pos, k, data):
+        src = 0
+        while k:
+            r, col = divmod(pos, w)
+            m = min(k, w - col)
+            off = ((y + r) * self.w + x + col) * 2
+            self.px[off:off + 2 * m] = data[src:src + 2 * m]
+            pos += m
+            src += 2 * m
+            k -= m
+
+    def to_ppm(self):
+        rgb = bytearray(self.w * self.h * 3)
+        px = array.array("H")
+        px.frombytes(bytes(self.px))
+        if sys.byteorder != "little":
+            px.byteswap()
+        o = 0
+        for v in px:
+            r, g, b = v >> 11, (v >> 5) & 0x3F, v & 0x1F
+            rgb[o] = (r << 3) | (r >> 2)
+            rgb[o + 1] = (g << 2) | (g >> 4)
+            rgb[o + 2] = (b << 3) | (b >> 2)
+            o += 3
+        return b"P6\n%d %d\n255\n" % (self.w, self.h) + bytes(rgb)
+
+
+# ========================== Stream parsing ==========================
+
+class Stream:
+    """Splits the port's byte stream into rectangles, skipping anything else (text)."""
+
+    def __init__(self, ser, w, h):
+        self.ser, self.w, self.h = ser, w, h
+        self.buf = bytearray()
+        self.text = bytearray()
+
+    def _fill(self, n):
+        while len(self.buf) < n:
+            chunk = self.ser.read(max(n - len(self.buf), self.ser.in_waiting or 1))
+            if not chunk:
+                return False
+            self.buf += chunk
+        return True
+
+    def _valid(self, hdr):
+        magic, codec, flags, x, y, w, h, plen = hdr
+        if magic != b"DR" or codec != CODEC_DELTA565 or flags & ~FLAG_PRESENT:
+            return False
+        if w == 0 or h == 0:
+            return plen == 0
+        bound = h * ((w + 127) // 128 + 2 * w)
+        return x + w <= self.w and y + h <= self.h and plen <= bound
+
+    def next(self):
+        """Return (flags, x, y, w, h, payload), or None on read timeout."""
+        while True:
+            if not self._fill(HDR.size):
+                return None
+            if self.buf[:2] == b"DR":
+                hdr = HDR.unpack_from(self.buf)
+                if self._valid(hdr):
+                    if not self._fill(HDR.size + hdr[7]):
+                        return None
+                    payload = bytes(self.buf[HDR.size:HDR.size + hdr[7]])
+                    del self.buf[:HDR.size + hdr[7]]
+                    return hdr[2], hdr[3], hdr[4], hdr[5], hdr[6], payload
+            # Not a rectangle: collect as text (console replies, stray logs)
+            b = self.buf.pop(0)
+            if b == 0x0A:
+                line = self.text.decode("utf-8", errors="replace").strip()
+                if line:
+                    print(f"[device] {line}", file=sys.stderr)
+                self.text.clear()
+            elif 0x20 <= b < 0x7F or b == 0x0D:
+                self.text.append(b)
+
+
+# ========================== Main ==========================
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--port", required=True)
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--fps", type=int, default=0, help="device frame rate cap (0 = Kconfig default)")
+    ap.add_argument("--kbps", type=int, default=0, help="device byte budget in KB/s (0 = Kconfig default)")
+    ap.add_argument("--view", action="store_true", help="live window (tkinter)")
+    ap.add_argument("--out", help="directory for one PPM per frame")
+    ap.add_argument("--snapshot", help="write one PPM once the screen has settled, then exit")
+    ap.add_argument("--settle", type=float, default=1.0, help="seconds without updates before --snapshot")
+    ap.add_argument("--seconds", type=float, default=0, help="stop after this long (0 = until Ctrl-C)")
+    args = ap.parse_args()
+
+    import serial  # pyserial
+
+    with serial.Serial(args.port, args.baud, timeout=0.2) as ser:
+        ser.reset_input_buffer()
+        cmd = "mirror start"
+        if args.fps or args.kbps:
+            cmd += f" {args.fps or 10} {args.kbps or 600}"
+        ser.write((cmd + "\r\n").encode())
+        line = wait_for(ser, ("mirror started", "mirror err", "err"), 5)
+        if not line.startswith("mirror started"):
+            sys.exit(line)
+        w, h = (int(v) for v in line.split()[2:4])
+        print(f"mirroring {w}x{h}", file=sys.stderr)
+
+        frame = Frame(w, h)
+        stream = Stream(ser, w, h)
+        if args.out:
+            os.makedirs(args.out, exist_ok=True)
+
+        tk_root = tk_label = None
+        if args.view:
+            import tkinter
+            tk_root = tkinter.Tk()
+            tk_root.title(f"{args.port} {w}x{h}")
+            tk_label = tkinter.Label(tk_root)
+            tk_label.pack()
+
+        frames = 0
+        wire = 0
+        t0 = last_update = time.time()
+        try:
+            while not args.seconds or time.time() - t0 < args.seconds:
+                if tk_root:
+                    tk_root.update()
+                msg = stream.next()
+                now = time.time()
+                if msg is None:
+                    if args.snapshot and frames and now - last_update >= args.settle:
+                        with open(args.snapshot, "wb") as f:
+                            f.write(frame.to_ppm())
+                        print(f"snapshot {args.snapshot}", file=sys.stderr)
+                        break
+                    continue
+                flags, x, y, rw, rh, payload = msg
+                wire += HDR.size + len(payload)
+                if rw and rh:
+                    frame.apply(x, y, rw, rh, payload)
+                    last_update = now
+                if not flags & FLAG_PRESENT:
+                    continue
+                frames += 1
+                if args.out:
+                    with open(os.path.join(args.out, f"frame_{frames:05d}.ppm"), "wb") as f:
+                        f.write(frame.to_ppm())
+                if tk_label:
+                    import tkinter
+                    img = tkinter.PhotoImage(data=frame.to_ppm())
+                    tk_label.configure(image=img)
+                    tk_label.image = img
+        except KeyboardInterrupt:
+            pass
+        finally:
+            ser.write(b"mirror stop\r\n")
+            dt = time.time() - t0
+            print(f"{frames} frames in {dt:.1f}s, {wire / max(dt, 1e-3) / 1024:.0f} KB/s", file=sys.stderr)
+            try:
+                print(wait_for(ser, ("mirror stopped", "mirror idle"), 5), file=sys.stderr)
+            except TimeoutError as e:
+                print(e, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
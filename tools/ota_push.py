@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+Push a firmware image to the device over the console (USB CDC or UART).
+
+Usage:
+    python tools/ota_push.py --port /dev/ttyACM0 build/esp32_do_it.bin
+
+The image is split into 4 KB blocks, each LZ4-compressed (block format)
+and sent as one frame (see main/ota_stream.h). The device decompresses
+straight into the inactive OTA slot, checks each block's CRC-32 and the
+whole image's SHA-256, then switches the boot slot and restarts.
+
+Uses the 'lz4' package when installed (pip install lz4), otherwise a
+built-in compressor that is slower but produces the same format.
+Requires pyserial.
+"""
+
+import argparse
+import hashlib
+import struct
+import sys
+import time
+import zlib
+
+from console_serial import wait_for
+
+BLOCK_MAX = 4096
+FLAG_LZ4 = 0x01
+FLAG_END = 0x02
+
+
+# ========================== LZ4 block compressor ==========================
+
+def _lz4_compress_py(src):
+    """Greedy LZ4 block compressor (format-compatible, not size-optimal)."""
+    n = len(src)
+    out = bytearray()
+    table = {}
+    anchor = 0
+    i = 0
+    mflimit = n - 12          # a match may not start in the last 12 bytes
+    last_literals = n - 5     # and must end before the last 5 bytes
+
+    def put_len(v):
+        while v >= 255:
+            out.append(255)
+            v -= 255
+        out.append(v)
+
+    def emit(lit_end, offset=0, mlen=0):
+        lit = lit_end - anchor
+        ml = mlen - 4 if offset else 0
+        out.append((min(lit, 15) << 4) | (min(ml, 15) if offset else 0))
+        if lit >= 15:
+            put_len(lit - 15)
+        out.extend(src[anchor:lit_end])
+        if offset:
+            out.extend(struct.pack("<H", offset))
+            if ml >= 15:
+                put_len(ml - 15)
+
+    while i < mflimit:
+        key = src[i:i + 4]
+        cand = table.get(key)
+        table[key] = i
+        if cand is None or i - cand > 0xFFFF:
+            i += 1
+            continue
+        m = 4
+        while i + m < last_literals and src[cand + m] == src[i + m]:
+            m += 1
+        emit(i, i - cand, m)
+        i += m
+        anchor = i
+
+    emit(n)
+    return bytes(out)
+
+
+try:
+    import lz4.block as _lz4
+
+    def lz4_compress(data):
+        return _lz4.compress(data, store_size=False)
+except ImportError:
+    lz4_compress = _lz4_compress_py
+
+
+# ========================== Framing ==========================
+
+def frame(flags, payload, raw_len, crc):
+    return struct.pack("<2sBBHHI", b"OF", flags, 0, len(payload), raw_len, crc) + payload
+
+
+def build_frames(image, compress=True):
+    for off in range(0, len(image), BLOCK_MAX):
+        raw = image[off:off + BLOCK_MAX]
+        crc = zlib.crc32(raw) & 0xFFFFFFFF
+        comp = lz4_compress(raw) if compress else None
+        if comp is not None and len(comp) < len(raw):
+            yield frame(FLAG_LZ4, comp, len(raw), crc), len(raw)
+        else:
+            yield frame(0, raw, len(raw), crc), len(raw)
+    yield frame(FLAG_END, b"", 0, 0), 0
+
+
+# ========================== Transport ==========================
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("image", help="application .bin (not the merged flash image)")
+    ap.add_argument("--port", required=True)
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--no-compress", action="store_true", help="send stored blocks (for comparison)")
+    args = ap.parse_args()
+
+    import serial  # pyserial
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+    digest = hashlib.sha256(image).hexdigest()
+
+    t0 = time.time()
+    frames = list(build_frames(image, not args.no_compress))
+    wire = sum(len(fr) for fr, _ in frames)
+    print(f"{len(image)} bytes -> {wire} on the wire ({100.0 * wire / len(image):.1f}%), "
+          f"compressed in {time.time() - t0:.1f}s")
+
+    with serial.Serial(args.port, args.baud, timeout=0.5) as ser:
+        ser.reset_input_buffer()
+        ser.write(f"ota {len(image)} {digest}\n".encode())  # LF only: binary follows
+        line = wait_for(ser, ("ota ready", "ota err", "err"), 60)  # slot erase can take a while
+        if not line.startswith("ota ready"):
+            sys.exit(line)
+
+        t0 = time.time()
+        sent = 0
+        for fr, raw_len in frames:
+            ser.write(fr)
+            line = wait_for(ser, ("ota ack", "ota done", "ota err"), 10)
+            if line.startswith("ota err"):
+                sys.exit(line)
+            sent += raw_len
+            print(f"\r{sent}/{len(image)} bytes", end="", flush=True)
+        print()
+
+        if not line.startswith("ota done"):
+            line = wait_for(ser, ("ota done", "ota err"), 30)
+        dt = time.time() - t0
+        print(f"{line} ({dt:.1f}s, {len(image) / dt / 1024:.0f} KB/s effective)")
+        if line.startswith("ota err"):
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
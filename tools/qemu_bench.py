@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""
+Boot the esp32s3_qemu profile in QEMU, run console commands, save the log.
+
+Usage:
+    # Build first:
+    #   idf.py -D SDKCONFIG_DEFAULTS="sdkconfig.defaults;sdkconfig.defaults.esp32s3_qemu" build
+    python tools/qemu_bench.py --out qemu.log
+    python tools/qemu_bench.py --out drag.log --trace my_drag.trace "bench loop" hidsink
+    python tools/bench_report.py base.log qemu.log
+
+Starts QEMU through "idf.py qemu" with instruction counting enabled
+(-icount shift=2,sleep=off: every guest instruction takes 4 ns of virtual
+time, idle time is skipped), so esp_timer based numbers scale with the
+instructions executed instead of with the host's load. The console runs
+on QEMU's stdio UART.
+
+After the firmware prints "Running." the tool optionally loads a touch
+trace ("vtouch load"), then sends each command and waits until the
+console has been quiet for --idle seconds. Everything the firmware prints
+goes to --out and to stdout. Default commands: info, bench all, vpanel,
+vtouch, hidsink.
+
+See docs/QEMU.md.
+"""
+
+import argparse
+import os
+import queue
+import shlex
+import signal
+import subprocess
+import sys
+import threading
+import time
+
+DEFAULT_CMD = ["idf.py", "qemu", "--qemu-extra-args=-icount shift=2,sleep=off"]
+DEFAULT_COMMANDS = ["info", "bench all", "vpanel", "vtouch", "hidsink"]
+READY_MARK = "Running."
+
+
+class Console:
+    """Line reader/writer on a child process's stdio."""
+
+    def __init__(self, cmd, log):
+        self.proc = subprocess.Popen(cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                                     stderr=subprocess.STDOUT, start_new_session=True)
+        self.log = log
+        self.lines = queue.Queue()
+        threading.Thread(target=self._reader, daemon=True).start()
+
+    def _reader(self):
+        for raw in iter(self.proc.stdout.readline, b""):
+            line = raw.decode("utf-8", "replace").rstrip("\r\n")
+            self.log.write(line + "\n")
+            self.log.flush()
+            print(line)
+            self.lines.put(line)
+        self.lines.put(None)
+
+    def write(self, data):
+        self.proc.stdin.write(data)
+        self.proc.stdin.flush()
+
+    def send(self, line):
+        # "\n" only: a trailing "\r" would be read as payload by "vtouch load"
+        self.write(line.encode() + b"\n")
+
+    def wait_for(self, marks, timeout):
+        """Return the first line containing one of marks, or None on timeout/exit."""
+        end = time.monotonic() + timeout
+        while True:
+            left = end - time.monotonic()
+            if left <= 0:
+                return None
+            try:
+                line = self.lines.get(timeout=left)
+            except queue.Empty:
+                return None
+            if line is None:
+                return None
+            if any(m in line for m in marks):
+                return line
+
+    def wait_idle(self, idle, timeout):
+        """Consume output until nothing arrives for idle seconds."""
+        end = time.monotonic() + timeout
+        while time.monotonic() < end:
+            try:
+                if self.lines.get(timeout=idle) is None:
+                    return
+            except queue.Empty:
+                return
+
+    def close(self):
+        if self.proc.poll() is None:
+            # idf.py runs QEMU as a child: stop the whole session
+            os.killpg(self.proc.pid, signal.SIGTERM)
+            try:
+                self.proc.wait(timeout=5)
+            except subprocess.TimeoutExpired:
+                os.killpg(self.proc.pid, signal.SIGKILL)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("commands", nargs="*", help="console commands to run (default: %s)" % ", ".join(DEFAULT_COMMANDS))
+    ap.add_argument("--out", default="qemu.log", help="log file (default qemu.log)")
+    ap.add_argument("--trace", help="touch trace to load with 'vtouch load' before the commands")
+    ap.add_argument("--cmd", help="command that starts QEMU with the console on stdio "
+                                  "(default: %s)" % " ".join(DEFAULT_CMD))
+    ap.add_argument("--boot-timeout", type=float, default=180, help="seconds to wait for boot (default 180)")
+    ap.add_argument("--idle", type=float, default=5, help="quiet seconds that end a command (default 5)")
+    ap.add_argument("--timeout", type=float, default=600, help="max seconds per command (default 600)")
+    args = ap.parse_args()
+
+    cmd = shlex.split(args.cmd) if args.cmd else DEFAULT_CMD
+    commands = args.commands or DEFAULT_COMMANDS
+
+    with open(args.out, "w") as log:
+        con = Console(cmd, log)
+        try:
+            if not con.wait_for([READY_MARK], args.boot_timeout):
+                sys.exit("qemu_bench: firmware did not boot (no '%s')" % READY_MARK)
+            con.wait_idle(args.idle, args.timeout)
+
+            if args.trace:
+                with open(args.trace, "rb") as f:
+                    trace = f.read()
+                con.send("vtouch load %d" % len(trace))
+                reply = con.wait_for(["vtouch ready", "vtouch err", "err vtouch", "err unknown"], 10)
+                if not reply or "err" in reply:
+                    sys.exit("qemu_bench: vtouch load refused: %s" % reply)
+                con.write(trace)
+                reply = con.wait_for(["vtouch loaded", "vtouch err"], 10)
+                if not reply or "err" in reply:
+                    sys.exit("qemu_bench: trace load failed: %s" % reply)
+
+            for c in commands:
+                con.send(c)
+                con.wait_idle(args.idle, args.timeout)
+        finally:
+            con.close()
+
+
+if __name__ == "__main__":
+    main()
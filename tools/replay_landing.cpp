@@ -0,0 +1,99 @@
+/**
+ * @file replay_landing.cpp
+ * @brief Host check: trackpad landing filter, replayed touch-down sequences
+ *
+ * Build and run (no ESP-IDF needed):
+ *     g++ -O2 -std=c++17 -Imain tools/replay_landing.cpp -o replay_landing
+ *     ./replay_landing
+ *
+ * Replays 100 Hz strokes through the gesture engine (trackpad_gesture.hpp)
+ * with the default TrackpadConfig. Strokes move 8 px per sample (to the
+ * right, or back and forth), so a MOVE wider than landing_clamp_px means the
+ * landing filter has let go. One line per case:
+ *
+ *   settle_ms  time from touch-down to the first unclamped move
+ *   expect_ms  when the contact should count as settled
+ *   leaked     moves wider than the clamp while still landing (must be 0)
+ *
+ * Exits non-zero if any case is off.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "trackpad_gesture.hpp"
+
+namespace {
+
+constexpr uint32_t PERIOD_MS = 10;      // 100 Hz touch polling
+constexpr int32_t STEP_PX = 8;          // Per sample, 800 px/s
+
+struct Case {
+    const char *name;
+    std::vector<uint16_t> strength;     // Per sample from touch-down; the last value repeats
+    bool jitter;                        // Alternate the direction of every move
+    uint32_t expect_ms;
+};
+
+bool replay(const Case &c)
+{
+    Trackpad tp(240, 320);
+    const int32_t clamp = tp.config().landing_clamp_px;
+    const uint32_t t0 = 1000;
+
+    int32_t x = 100;
+    uint32_t settle_ms = UINT32_MAX;
+    unsigned wide_while_landing = 0;
+    for (size_t i = 0; i <= 10; i++) {
+        TouchInput in;
+        in.event = i == 0 ? TouchEvent::PRESSED : TouchEvent::PRESSING;
+        if (i > 0) x += (c.jitter && (i % 2 == 0)) ? -STEP_PX : STEP_PX;
+        in.x = x;
+        in.y = 160;
+        in.timestamp_ms = t0 + static_cast<uint32_t>(i) * PERIOD_MS;
+        in.strength = c.strength[i < c.strength.size() ? i : c.strength.size() - 1];
+
+        TrackpadAction a = tp.processInput(in);
+        if (a.type != ActionType::MOVE) continue;
+        bool wide = std::abs(a.dx) > clamp || std::abs(a.dy) > clamp;
+        uint32_t t = in.timestamp_ms - t0;
+        if (wide && settle_ms == UINT32_MAX) {
+            settle_ms = t;
+        }
+        if (wide && t < c.expect_ms) wide_while_landing++;
+    }
+
+    bool ok = settle_ms == c.expect_ms && wide_while_landing == 0;
+    if (settle_ms == UINT32_MAX) {
+        std::printf("landing case=%s settle_ms=never expect_ms=%u leaked=%u %s\n", c.name,
+                    (unsigned)c.expect_ms, wide_while_landing, ok ? "ok" : "FAIL");
+    } else {
+        std::printf("landing case=%s settle_ms=%u expect_ms=%u leaked=%u %s\n", c.name, (unsigned)settle_ms,
+                    (unsigned)c.expect_ms, wide_while_landing, ok ? "ok" : "FAIL");
+    }
+    return ok;
+}
+
+} // namespace
+
+int main()
+{
+    const Case cases[] = {
+        // Controller without strength: direction and age decide (2 samples)
+        {"no_strength", {0}, false, 20},
+        // Strength starts after touch-down: 0 -> n is missing data, not a rise
+        {"late_strength", {0, 0, 40, 42}, false, 20},
+        // Strength rising > 25 % per sample until 40 ms: still flattening
+        {"rising", {10, 20, 40, 80, 100, 110}, false, 40},
+        // Direction flips every sample: only landing_max_ms ends it
+        {"jitter", {0}, true, 60},
+    };
+
+    bool ok = true;
+    for (const Case &c : cases) {
+        ok = replay(c) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""
+Convert a "trace dump" from the device console into Chrome trace JSON.
+
+Usage:
+    # From a captured serial log
+    python tools/trace2chrome.py capture.log -o trace.json
+
+    # Or let the script ask the device directly (needs pyserial)
+    python tools/trace2chrome.py --port /dev/ttyACM0 -o trace.json
+
+Open the result in chrome://tracing or https://ui.perfetto.dev.
+Each FreeRTOS task gets its own row; the CPU core is attached to every
+event as an argument. Lines that are not part of the dump (logs) are ignored.
+"""
+
+import argparse
+import json
+import sys
+import time
+
+
+def read_from_port(port, baud, timeout_s):
+    import serial  # pyserial
+
+    with serial.Serial(port, baud, timeout=0.2) as ser:
+        ser.reset_input_buffer()
+        ser.write(b"trace dump\r\n")
+        lines = []
+        deadline = time.time() + timeout_s
+        while time.time() < deadline:
+            raw = ser.readline()
+            if not raw:
+                continue
+            line = raw.decode("utf-8", errors="replace").strip()
+            lines.append(line)
+            if line.startswith("trace end"):
+                break
+        return lines
+
+
+def parse(lines):
+    tasks = {}
+    events = []
+    in_dump = False
+
+    for line in lines:
+        line = line.strip()
+        if line.startswith("trace begin"):
+            # Keep only the last dump in the file
+            tasks.clear()
+            events.clear()
+            in_dump = True
+            continue
+        if line.startswith("trace end"):
+            in_dump = False
+            continue
+        if not in_dump:
+            continue
+
+        parts = line.split(" ", 5)
+        if parts[0] == "T" and len(parts) >= 3:
+            tasks[parts[1]] = " ".join(parts[2:])
+        elif parts[0] == "E" and len(parts) == 6:
+            _, ts, phase, core, task, name = parts
+            events.append((int(ts), phase, int(core), task, name))
+
+    return tasks, events
+
+
+def to_chrome(tasks, events):
+    out = []
+    tids = {}
+
+    def tid_for(handle):
+        if handle not in tids:
+            tids[handle] = len(tids) + 1
+            name = tasks.get(handle, "isr" if handle == "00000000" else handle)
+            out.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": tids[handle],
+                        "args": {"name": name}})
+        return tids[handle]
+
+    # Timestamps are the low 32 bits of esp_timer; unwrap
+    offset = 0
+    last = None
+    for ts, phase, core, task, name in events:
+        if last is not None and ts < last and last - ts > 0x80000000:
+            offset += 1 << 32
+        last = ts
+        ev = {"name": name, "ph": phase, "ts": ts + offset, "pid": 1,
+              "tid": tid_for(task), "args": {"core": core}}
+        if phase == "i":
+            ev["s"] = "t"
+        out.append(ev)
+
+    return {"traceEvents": out, "displayTimeUnit": "ms"}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("log", nargs="?", help="captured console log ('-' for stdin)")
+    ap.add_argument("--port", help="serial port to request the dump from")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--timeout", type=float, default=30.0, help="seconds to wait for the dump")
+    ap.add_argument("-o", "--output", default="trace.json")
+    args = ap.parse_args()
+
+    if args.port:
+        lines = read_from_port(args.port, args.baud, args.timeout)
+    elif args.log == "-":
+        lines = sys.stdin.read().splitlines()
+    elif args.log:
+        with open(args.log, encoding="utf-8", errors="replace") as f:
+            lines = f.read().splitlines()
+    else:
+        ap.error("give a log file or --port")
+
+    tasks, events = parse(lines)
+    if not events:
+        sys.exit("no trace events found (did the log contain 'trace begin' ... 'trace end'?)")
+
+    with open(args.output, "w") as f:
+        json.dump(to_chrome(tasks, events), f)
+    print(f"{len(events)} events, {len(tasks)} tasks -> {args.output}")
+
+
+if __name__ == "__main__":
+    main()